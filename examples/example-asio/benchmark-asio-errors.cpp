@@ -0,0 +1,188 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+// Measures the throughput of the error path of asio operations.
+// Every operation fails immediately with `connection_reset`, which is
+// handled by:
+// - callback:   a plain asio completion handler
+// - exception:  cti::use_continuable and a fail handler, which allocates
+//               an exception_ptr holding a system_error per error
+// - error_code: cti::use_continuable_ec, which passes the error code
+//               as first value to the next handler
+//
+// Usage:
+//   benchmark-asio-errors [--operations=1000000] [--threads=1,4]
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <asio.hpp>
+
+#include <continuable/continuable.hpp>
+#include <continuable/external/asio.hpp>
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+struct options {
+  std::uint64_t operations = 1000000;
+  std::vector<std::size_t> threads{1, 4};
+};
+
+std::vector<std::size_t> parse_list(char const* list) {
+  std::vector<std::size_t> values;
+  while (*list) {
+    char* end = nullptr;
+    values.push_back(static_cast<std::size_t>(std::strtoul(list, &end, 10)));
+    list = (*end == ',') ? end + 1 : end;
+  }
+  return values;
+}
+
+options parse_options(int argc, char** argv) {
+  options config;
+  for (int i = 1; i < argc; ++i) {
+    std::string const argument = argv[i];
+    std::string const operations = "--operations=";
+    std::string const threads = "--threads=";
+
+    if (argument.compare(0, operations.size(), operations) == 0) {
+      config.operations =
+          std::strtoull(argument.c_str() + operations.size(), nullptr, 10);
+    } else if (argument.compare(0, threads.size(), threads) == 0) {
+      config.threads = parse_list(argument.c_str() + threads.size());
+    } else {
+      std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+      std::exit(1);
+    }
+  }
+  return config;
+}
+
+/// An asynchronous operation which fails immediately
+template <typename Token>
+auto async_failing_read(Token&& token) {
+  return asio::async_initiate<Token, void(cti::asio_error_code_t,
+                                          std::size_t)>(
+      [](auto&& handler) {
+        std::forward<decltype(handler)>(handler)(
+            cti::asio_error_code_t(asio::error::connection_reset), 0U);
+      },
+      token);
+}
+
+struct callback_mode {
+  static constexpr char const* name = "callback";
+
+  static void run(std::atomic<std::uint64_t>& failures) {
+    async_failing_read([&](cti::asio_error_code_t ec, std::size_t) {
+      if (ec) {
+        failures.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+};
+
+struct exception_mode {
+  static constexpr char const* name = "exception";
+
+  static void run(std::atomic<std::uint64_t>& failures) {
+    async_failing_read(cti::use_continuable)
+        .then([](std::size_t) {})
+        .fail([&](cti::exception_t) {
+          failures.fetch_add(1, std::memory_order_relaxed);
+        });
+  }
+};
+
+struct error_code_mode {
+  static constexpr char const* name = "error_code";
+
+  static void run(std::atomic<std::uint64_t>& failures) {
+    async_failing_read(cti::use_continuable_ec)
+        .then([&](cti::asio_error_code_t ec, std::size_t) {
+          if (ec) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+  }
+};
+
+template <typename Mode>
+void measure(options const& config, std::size_t threads) {
+  std::atomic<std::uint64_t> failures{0};
+  std::uint64_t const per_thread = config.operations / threads;
+
+  auto const begin = clock_type::now();
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&] {
+      for (std::uint64_t op = 0; op < per_thread; ++op) {
+        Mode::run(failures);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::chrono::duration<double> const elapsed = clock_type::now() - begin;
+
+  if (failures.load() != per_thread * threads) {
+    std::fprintf(stderr, "%s: lost failures\n", Mode::name);
+    std::exit(1);
+  }
+
+  std::printf("%-12s %8zu %14.0f %10.1f\n", Mode::name, threads,
+              static_cast<double>(failures.load()) / elapsed.count(),
+              elapsed.count() * 1e9 / static_cast<double>(failures.load()));
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  options const config = parse_options(argc, argv);
+
+  std::printf("%-12s %8s %14s %10s\n", "mode", "threads", "failures/s",
+              "ns/op");
+
+  for (std::size_t threads : config.threads) {
+    measure<callback_mode>(config, threads);
+    measure<exception_mode>(config, threads);
+    measure<error_code_mode>(config, threads);
+  }
+  return 0;
+}
@@ -0,0 +1,441 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+// Measures the overhead of continuable on a real I/O path:
+// an echo/RPC server and a closed loop load generator talk over 127.0.0.1.
+//
+// Every request writes a fixed size message and reads the echoed reply.
+// The write and the read are started together and joined through when_all,
+// all handlers of a connection are serialized through its own strand.
+// The same protocol is implemented with plain asio callbacks as baseline.
+//
+// Usage:
+//   benchmark-asio-rpc [--duration-ms=1000] [--connections=1,8,64]
+//                      [--threads=1,4]
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <asio.hpp>
+
+#include <continuable/continuable.hpp>
+#include <continuable/continuable-statistics.hpp>
+#include <continuable/external/asio.hpp>
+
+namespace {
+using asio::ip::tcp;
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t message_size = 64;
+using message_t = std::array<char, message_size>;
+
+struct options {
+  std::chrono::milliseconds duration{1000};
+  std::vector<std::size_t> connections{1, 8, 64};
+  std::vector<std::size_t> threads{1, 4};
+};
+
+struct measurement {
+  std::uint64_t requests = 0;
+  double seconds = 0.;
+  cti::latency_histogram latency;
+};
+
+/// The state which is shared between all connections of a run
+struct run_state {
+  std::atomic<bool> stopped{false};
+  std::mutex lock;
+  measurement result;
+
+  void merge(cti::latency_histogram const& latency) {
+    std::lock_guard<std::mutex> guard(lock);
+    result.latency.merge(latency);
+  }
+};
+
+/// Runs the given io_context on the given count of threads
+class io_threads {
+public:
+  io_threads(asio::io_context& context, std::size_t count)
+      : guard_(asio::make_work_guard(context)) {
+    for (std::size_t i = 0; i < count; ++i) {
+      threads_.emplace_back([&context] { context.run(); });
+    }
+  }
+
+  void join() {
+    guard_.reset();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+    threads_.clear();
+  }
+
+private:
+  asio::executor_work_guard<asio::io_context::executor_type> guard_;
+  std::vector<std::thread> threads_;
+};
+
+// The server implemented with continuables
+class continuable_session
+    : public std::enable_shared_from_this<continuable_session> {
+public:
+  explicit continuable_session(tcp::socket socket)
+      : socket_(std::move(socket)) {
+  }
+
+  void serve() {
+    auto self = shared_from_this();
+    asio::async_read(socket_, asio::buffer(buffer_), cti::use_continuable)
+        .then([self](std::size_t) {
+          return asio::async_write(self->socket_, asio::buffer(self->buffer_),
+                                   cti::use_continuable);
+        })
+        .then([self](std::size_t) { self->serve(); })
+        .fail([](cti::exception_t) {
+          // The client closed the connection
+        });
+  }
+
+private:
+  tcp::socket socket_;
+  message_t buffer_{};
+};
+
+void accept_continuable(tcp::acceptor& acceptor, asio::io_context& context) {
+  auto socket = std::make_shared<tcp::socket>(asio::make_strand(context));
+  acceptor.async_accept(*socket, cti::use_continuable)
+      .then([socket, &acceptor, &context] {
+        socket->set_option(tcp::no_delay(true));
+        std::make_shared<continuable_session>(std::move(*socket))->serve();
+        accept_continuable(acceptor, context);
+      })
+      .fail([](cti::exception_t) {
+        // The acceptor was closed
+      });
+}
+
+// The client implemented with continuables
+class continuable_client
+    : public std::enable_shared_from_this<continuable_client> {
+public:
+  continuable_client(tcp::socket socket, run_state& state)
+      : socket_(std::move(socket)), state_(state) {
+  }
+
+  void issue() {
+    auto self = shared_from_this();
+    auto const sent = clock_type::now();
+
+    cti::when_all(asio::async_write(socket_, asio::buffer(request_),
+                                    cti::use_continuable),
+                  asio::async_read(socket_, asio::buffer(response_),
+                                   cti::use_continuable))
+        .then([self, sent](std::size_t, std::size_t) {
+          self->latency_.record(clock_type::now() - sent);
+          if (!self->state_.stopped.load(std::memory_order_relaxed)) {
+            self->issue();
+          }
+        })
+        .fail([](cti::exception_t) {
+          std::fputs("The continuable client failed unexpectedly\n", stderr);
+          std::abort();
+        });
+  }
+
+  ~continuable_client() {
+    state_.merge(latency_);
+  }
+
+private:
+  tcp::socket socket_;
+  run_state& state_;
+  message_t request_{};
+  message_t response_{};
+  cti::latency_histogram latency_;
+};
+
+struct continuable_protocol {
+  static constexpr char const* name = "continuable";
+
+  static void accept(tcp::acceptor& acceptor, asio::io_context& context) {
+    accept_continuable(acceptor, context);
+  }
+
+  static void start(tcp::socket socket, run_state& state) {
+    std::make_shared<continuable_client>(std::move(socket), state)->issue();
+  }
+};
+
+// The server implemented with plain asio callbacks
+class callback_session : public std::enable_shared_from_this<callback_session> {
+public:
+  explicit callback_session(tcp::socket socket) : socket_(std::move(socket)) {
+  }
+
+  void serve() {
+    auto self = shared_from_this();
+    asio::async_read(
+        socket_, asio::buffer(buffer_),
+        [self](asio::error_code const& error, std::size_t) {
+          if (error) {
+            return;
+          }
+          asio::async_write(self->socket_, asio::buffer(self->buffer_),
+                            [self](asio::error_code const& write_error,
+                                   std::size_t) {
+                              if (!write_error) {
+                                self->serve();
+                              }
+                            });
+        });
+  }
+
+private:
+  tcp::socket socket_;
+  message_t buffer_{};
+};
+
+void accept_callback(tcp::acceptor& acceptor, asio::io_context& context) {
+  auto socket = std::make_shared<tcp::socket>(asio::make_strand(context));
+  acceptor.async_accept(
+      *socket, [socket, &acceptor, &context](asio::error_code const& error) {
+        if (error) {
+          return;
+        }
+        socket->set_option(tcp::no_delay(true));
+        std::make_shared<callback_session>(std::move(*socket))->serve();
+        accept_callback(acceptor, context);
+      });
+}
+
+// The client implemented with plain asio callbacks
+class callback_client : public std::enable_shared_from_this<callback_client> {
+public:
+  callback_client(tcp::socket socket, run_state& state)
+      : socket_(std::move(socket)), state_(state) {
+  }
+
+  void issue() {
+    auto self = shared_from_this();
+    sent_ = clock_type::now();
+    pending_ = 2;
+
+    auto const joined = [self](asio::error_code const& error, std::size_t) {
+      if (error) {
+        std::fputs("The callback client failed unexpectedly\n", stderr);
+        std::abort();
+      }
+      if (--self->pending_ == 0) {
+        self->latency_.record(clock_type::now() - self->sent_);
+        if (!self->state_.stopped.load(std::memory_order_relaxed)) {
+          self->issue();
+        }
+      }
+    };
+
+    asio::async_write(socket_, asio::buffer(request_), joined);
+    asio::async_read(socket_, asio::buffer(response_), joined);
+  }
+
+  ~callback_client() {
+    state_.merge(latency_);
+  }
+
+private:
+  tcp::socket socket_;
+  run_state& state_;
+  message_t request_{};
+  message_t response_{};
+  clock_type::time_point sent_;
+  int pending_ = 0;
+  cti::latency_histogram latency_;
+};
+
+struct callback_protocol {
+  static constexpr char const* name = "callback";
+
+  static void accept(tcp::acceptor& acceptor, asio::io_context& context) {
+    accept_callback(acceptor, context);
+  }
+
+  static void start(tcp::socket socket, run_state& state) {
+    std::make_shared<callback_client>(std::move(socket), state)->issue();
+  }
+};
+
+void check(asio::error_code const& error, char const* what) {
+  if (error) {
+    std::fprintf(stderr, "%s failed: %s\n", what, error.message().c_str());
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+template <typename Protocol>
+measurement run(options const& config, std::size_t connections,
+                 std::size_t threads) {
+  asio::io_context server_context(static_cast<int>(threads));
+  asio::io_context client_context(static_cast<int>(threads));
+  asio::error_code error;
+
+  tcp::acceptor acceptor(server_context);
+  tcp::endpoint const any(asio::ip::address_v4::loopback(), 0);
+  acceptor.open(any.protocol(), error);
+  check(error, "open");
+  acceptor.bind(any, error);
+  check(error, "bind");
+  acceptor.listen(asio::socket_base::max_listen_connections, error);
+  check(error, "listen");
+  tcp::endpoint const endpoint = acceptor.local_endpoint();
+
+  Protocol::accept(acceptor, server_context);
+  io_threads server(server_context, threads);
+
+  std::vector<tcp::socket> sockets;
+  for (std::size_t i = 0; i < connections; ++i) {
+    sockets.emplace_back(asio::make_strand(client_context));
+    sockets.back().connect(endpoint, error);
+    check(error, "connect");
+    sockets.back().set_option(tcp::no_delay(true));
+  }
+
+  run_state state;
+  auto const begin = clock_type::now();
+  for (auto& socket : sockets) {
+    Protocol::start(std::move(socket), state);
+  }
+
+  io_threads clients(client_context, threads);
+  std::this_thread::sleep_for(config.duration);
+  state.stopped.store(true);
+
+  // The clients finish their outstanding request and close their sockets
+  clients.join();
+  auto const end = clock_type::now();
+
+  asio::post(acceptor.get_executor(), [&acceptor] {
+    asio::error_code ignored;
+    acceptor.close(ignored);
+  });
+  server.join();
+
+  state.result.requests = state.result.latency.count();
+  state.result.seconds = std::chrono::duration<double>(end - begin).count();
+  return std::move(state.result);
+}
+
+double micros(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+void report(char const* name, std::size_t connections, std::size_t threads,
+            measurement const& result) {
+  std::printf("%-12s %6zu %8zu %12.0f %10.1f %10.1f %10.1f\n", name,
+              connections, threads,
+              static_cast<double>(result.requests) / result.seconds,
+              micros(result.latency.percentile(50.)),
+              micros(result.latency.percentile(99.)),
+              micros(result.latency.percentile(99.9)));
+}
+
+std::vector<std::size_t> parse_list(char const* list) {
+  std::vector<std::size_t> values;
+  char const* current = list;
+  while (*current != '\0') {
+    char* next = nullptr;
+    unsigned long const value = std::strtoul(current, &next, 10);
+    if (next == current) {
+      break;
+    }
+    values.push_back(static_cast<std::size_t>(value));
+    current = (*next == ',') ? next + 1 : next;
+  }
+  return values;
+}
+
+options parse_options(int argc, char** argv) {
+  options config;
+  for (int i = 1; i < argc; ++i) {
+    std::string const argument = argv[i];
+    auto const value_of = [&](char const* prefix) -> char const* {
+      std::size_t const length = std::strlen(prefix);
+      return argument.compare(0, length, prefix) == 0 ? argv[i] + length
+                                                      : nullptr;
+    };
+
+    if (char const* value = value_of("--duration-ms=")) {
+      config.duration = std::chrono::milliseconds(std::atol(value));
+    } else if (char const* value = value_of("--connections=")) {
+      config.connections = parse_list(value);
+    } else if (char const* value = value_of("--threads=")) {
+      config.threads = parse_list(value);
+    } else {
+      std::fprintf(stderr,
+                   "Usage: %s [--duration-ms=N] [--connections=N,...] "
+                   "[--threads=N,...]\n",
+                   argv[0]);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  return config;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  options const config = parse_options(argc, argv);
+
+  std::printf("%-12s %6s %8s %12s %10s %10s %10s\n", "mode", "conns",
+              "threads", "requests/s", "p50 us", "p99 us", "p999 us");
+
+  for (std::size_t threads : config.threads) {
+    for (std::size_t connections : config.connections) {
+      measurement const baseline =
+          run<callback_protocol>(config, connections, threads);
+      report(callback_protocol::name, connections, threads, baseline);
+
+      measurement const measured =
+          run<continuable_protocol>(config, connections, threads);
+      report(continuable_protocol::name, connections, threads, measured);
+    }
+  }
+  return 0;
+}
@@ -137,7 +137,11 @@ public:
             std::enable_if_t<std::is_convertible<
                 detail::traits::unrefcv_t<OData>, Data>::value>* = nullptr>
   /* implicit */ continuable_base(continuable_base<OData, Annotation>&& other)
-    : data_(std::move(other).consume()) {}
+    : data_(std::move(other).consume()) {
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+    ownership_.chain(other.ownership_.chain());
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+  }
 
   /// Constructor taking the data of other continuable_base objects
   /// while erasing the hint.
@@ -580,6 +584,10 @@ public:
   /// \returns Returns a continuable_base with a result type matching
   ///          the result of the left continuable_base combined with the
   ///          right continuable_base.
+  ///          The returned continuable_base will be in an intermediate lazy
+  ///          state, further calls to its continuable_base::operator >>
+  ///          will add other continuable_base objects to the same sequence,
+  ///          which writes every result directly into its final place.
   /// ```cpp
   /// (http_request("github.com") >> http_request("atom.io"))
   ///   .then([](std::string github, std::string atom) {
@@ -596,8 +604,9 @@ public:
   /// \since 1.0.0
   template <typename OData, typename OAnnotation>
   auto operator>>(continuable_base<OData, OAnnotation>&& right) && {
-    return detail::connection::seq::sequential_connect(std::move(*this),
-                                                       std::move(right));
+    return detail::connection::connect(
+        detail::connection::connection_strategy_seq_tag{}, std::move(*this),
+        std::move(right));
   }
 
   /// Invokes the continuation chain manually even before the
@@ -611,7 +620,7 @@ public:
   ///
   /// \since 1.0.0
   void done() && {
-    detail::base::finalize_continuation(std::move(*this).finish());
+    annotation_trait::done(std::move(*this));
   }
 
   /// Materializes the continuation expression template and finishes
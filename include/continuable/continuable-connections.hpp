@@ -33,6 +33,7 @@
 
 #include <initializer_list>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <continuable/detail/connection/connection-all.hpp>
@@ -81,6 +82,40 @@ auto when_all(Args&&... args) {
       std::forward<Args>(args)...);
 }
 
+/// Connects the continuables of the given homogeneous container
+/// with an all logic.
+///
+/// The results are written in place into a single `std::vector`
+/// which is allocated once when the connection is invoked.
+/// Every continuable is freed directly after it was dispatched,
+/// which avoids the intermediate storage of the generic when_all.
+///
+/// ```cpp
+/// std::vector<cti::continuable<int>> v;
+/// v.push_back(cti::make_ready_continuable(0));
+/// v.push_back(cti::make_ready_continuable(1));
+///
+/// cti::when_all(std::move(v))
+///   .then([](std::vector<int> r01) {
+///     // ...
+///   });
+/// ```
+///
+/// \note This overload is selected for continuables resolving with a
+///       single default constructible value, all other containers are
+///       connected through the generic when_all.
+///
+/// \see  when_all for details.
+///
+/// \since 4.3.0
+template <typename Data, typename T,
+          std::enable_if_t<std::is_default_constructible<T>::value>* = nullptr>
+auto when_all(
+    std::vector<continuable_base<Data, detail::identity<T>>>&& continuables) {
+  return detail::connection::all::connect_contiguous(
+      std::move(continuables), detail::connection::all::owning_target<T>{});
+}
+
 /// Connects the given arguments with an all logic.
 /// The content of the iterator is moved out and converted
 /// to a temporary `std::vector` which is then passed to when_all.
@@ -116,6 +151,44 @@ auto when_all(Iterator begin, Iterator end) {
   return when_all(detail::range::persist_range(begin, end));
 }
 
+/// Connects the continuables of the given homogeneous container
+/// with an all logic and writes their results into the given storage.
+///
+/// The storage is any contiguous range providing `data()` and `size()`,
+/// such as `std::span<T>`, `std::vector<T>` or `std::array<T, N>`.
+/// The result at index `i` is assigned to `out.data()[i]`, therefore
+/// the storage has to outlive the returned continuable.
+/// The returned continuable resolves with an exception when the storage
+/// holds less elements than there are continuables.
+/// Since the storage is written by every continuable, an exception is
+/// forwarded only after all continuables were resolved.
+///
+/// ```cpp
+/// std::vector<cti::continuable<int>> v = /* ... */;
+/// std::vector<int> results(v.size());
+///
+/// cti::when_all_into(std::move(v), results)
+///   .then([&] {
+///     // The results are available in `results` now
+///   });
+/// ```
+///
+/// \returns A continuable_base with an empty signature which resolves
+///          after all results were written.
+///
+/// \since 4.3.0
+template <typename Data, typename T, typename Span>
+auto when_all_into(
+    std::vector<continuable_base<Data, detail::identity<T>>>&& continuables,
+    Span&& out) {
+  static_assert(std::is_same<std::decay_t<decltype(*out.data())>, T>::value,
+                "The storage must hold the type of the results!");
+
+  return detail::connection::all::connect_contiguous(
+      std::move(continuables),
+      detail::connection::all::span_target<T>(out.data(), out.size()));
+}
+
 /// Connects the given arguments with a sequential logic.
 /// All continuables contained inside the given nested pack are
 /// invoked one after one. On completion the final handler is called
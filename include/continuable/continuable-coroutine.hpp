@@ -67,6 +67,13 @@ namespace cti {
 /// });
 /// ```
 ///
+/// When `CONTINUABLE_WITH_DIRECT_AWAIT_CANCELLATION` is defined, a coroutine
+/// returning a continuable_base isn't resumed on a cancellation at all.
+/// Its frame is destroyed and the cancellation is forwarded to its promise
+/// directly, which avoids throwing and catching the exception.
+/// Without exception support this is always the case for
+/// cancellations and errors.
+///
 /// \since 4.1.0
 using await_canceled_exception = detail::awaiting::await_canceled_exception;
 #  endif // CONTINUABLE_HAS_EXCEPTIONS
@@ -33,9 +33,22 @@
 
 /// \defgroup Operations Operations
 /// provides functions to work with asynchronous control flows.
-
+///
+/// The executors which own threads or system resources aren't included
+/// by this header and need to be included on their own:
+/// - `<continuable/operations/blocking.hpp>` for cti::blocking_pool
+/// - `<continuable/operations/run-loop.hpp>` for cti::run_loop
+/// - `<continuable/operations/scheduler.hpp>` for cti::deadline_scheduler
+/// - `<continuable/operations/shard.hpp>` for cti::shard::runtime
+
+#include <continuable/operations/async-cache.hpp>
 #include <continuable/operations/async.hpp>
+#include <continuable/operations/hedge.hpp>
 #include <continuable/operations/loop.hpp>
+#include <continuable/operations/parallel.hpp>
+#include <continuable/operations/retry.hpp>
+#include <continuable/operations/single-flight.hpp>
 #include <continuable/operations/split.hpp>
+#include <continuable/operations/timer-queue.hpp>
 
 #endif // CONTINUABLE_OPERATIONS_HPP_INCLUDED
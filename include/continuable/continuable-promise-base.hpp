@@ -40,6 +40,10 @@
 #include <continuable/detail/utility/traits.hpp>
 #include <continuable/detail/utility/util.hpp>
 
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+#include <continuable/detail/other/statistics.hpp>
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
+
 namespace cti {
 /// \defgroup Base Base
 /// provides classes and functions to create continuable_base objects.
@@ -120,6 +124,7 @@ public:
   /// \since  2.0.0
   void operator()(Args... args) && noexcept {
     assert(data_);
+    resolving();
     std::move(data_)(std::move(args)...);
     data_ = nullptr;
   }
@@ -138,6 +143,7 @@ public:
   /// \since  2.0.0
   void operator()(exception_arg_t tag, exception_t exception) && noexcept {
     assert(data_);
+    resolving();
     std::move(data_)(tag, std::move(exception));
     data_ = nullptr;
   }
@@ -157,6 +163,7 @@ public:
   /// \since  2.0.0
   void set_value(Args... args) noexcept {
     // assert(data_);
+    resolving();
     std::move(data_)(std::move(args)...);
     data_ = nullptr;
   }
@@ -176,6 +183,7 @@ public:
   /// \since  2.0.0
   void set_exception(exception_t exception) noexcept {
     assert(data_);
+    resolving();
     std::move(data_)(exception_arg_t{}, std::move(exception));
     data_ = nullptr;
   }
@@ -196,6 +204,7 @@ public:
   /// \since  4.0.0
   void set_canceled() noexcept {
     assert(data_);
+    resolving();
     std::move(data_)(exception_arg_t{}, exception_t{});
     data_ = nullptr;
   }
@@ -208,6 +217,15 @@ public:
   explicit operator bool() const noexcept {
     return bool(data_);
   }
+
+private:
+  /// The promise may be resolved after code outside of the library ran,
+  /// therefore the next stage can't reuse the end of the previous one.
+  static void resolving() noexcept {
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+    detail::statistics::forget_boundary();
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
+  }
 };
 /// \}
 } // namespace cti
@@ -31,6 +31,7 @@
 #ifndef CONTINUABLE_PROMISIFY_HPP_INCLUDED
 #define CONTINUABLE_PROMISIFY_HPP_INCLUDED
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 #include <continuable/detail/other/promisify.hpp>
@@ -46,6 +47,8 @@ namespace cti {
 /// - `from`: Converts callback taking callable types into continuables
 ///           which pass an error code as first parameter and the rest of
 ///           the result afterwards.
+/// - `from_error_value`: Converts callback taking callable types into
+///           continuables which pass the error code as first value.
 ///
 /// \tparam Result The result of the converted continuable, this should align
 ///                with the arguments that are passed to the callback.
@@ -83,6 +86,37 @@ public:
                                  std::forward<Args>(args)...);
   }
 
+  /// Converts callback taking callable types into a continuable
+  /// which passes the error code as its first value instead of
+  /// converting it to the error type used by the library.
+  ///
+  /// This avoids the allocation of an exception for errors which
+  /// happen routinely, the first type of Result is the type of the error:
+  /// ```cpp
+  /// auto async_read(std::size_t size) {
+  ///   return cti::promisify<std::error_code, std::string>::from_error_value(
+  ///       [&](auto&&... args) {
+  ///         reader_.async_read(std::forward<decltype(args)>(args)...);
+  ///       },
+  ///       size);
+  /// }
+  ///
+  /// async_read(64).then([](std::error_code ec, std::string data) {
+  ///   // ...
+  /// });
+  /// ```
+  ///
+  /// \since 4.3.0
+  template <typename Callable, typename... Args>
+  static auto from_error_value(Callable&& callable, Args&&... args) {
+    static_assert(sizeof...(Result) > 0,
+                  "The first type of the result needs to be the error type!");
+
+    return helper::template from(detail::convert::error_value_resolver(),
+                                 std::forward<Callable>(callable),
+                                 std::forward<Args>(args)...);
+  }
+
   /// \copybrief from
   ///
   /// This modification of \ref from additionally takes a resolver callable
@@ -114,6 +148,125 @@ public:
                                  std::forward<Args>(args)...);
   }
 };
+
+/// Helper class for converting C-style callback APIs into continuables,
+/// the C API is expected to call back a function pointer of the form
+/// `void(*)(void* user_data, CArgs...)` with the user data it was given.
+///
+/// The promise of every call is placed into a slot of a pool owned
+/// by the promisify_c object, the address of the slot is passed as
+/// user data to the C API. Slots are allocated in batches and recycled,
+/// thus no allocation happens per call once the pool is large enough.
+/// Promises which don't fit into the inline storage of a slot are moved
+/// to the heap.
+///
+/// ```cpp
+/// // void compress_async(char const* data, std::size_t size,
+/// //                     void (*callback)(void*, int, std::size_t),
+/// //                     void* user_data);
+///
+/// cti::promisify_c<int, std::size_t> compressor(64);
+///
+/// compressor.from(
+///     [&](auto callback, void* user_data) {
+///       compress_async(data, size, callback, user_data);
+///     })
+///   .then([](int error, std::size_t compressed) {
+///     // ...
+///   });
+/// ```
+///
+/// \tparam CArgs The arguments which are passed to the C callback
+///               after the user data.
+///
+/// \note         The promisify_c object must outlive all calls
+///               which are outstanding on it.
+///
+/// \note         When the C API throws an exception the promise is rejected
+///               with it, unless the callback was invoked before already.
+///               The C API must not invoke the callback after it threw.
+///
+/// \since        4.3.0
+template <typename... CArgs>
+class promisify_c {
+  using helper = detail::convert::promisify_c_helper<CArgs...>;
+
+  typename helper::pool_t pool_;
+
+public:
+  /// The function pointer type which is passed to the C API
+  using callback_type = void (*)(void*, CArgs...);
+
+  /// Creates the object and allocates the given count of slots
+  explicit promisify_c(std::size_t reserve = 0U) {
+    pool_.reserve(reserve);
+  }
+
+  /// Allocates the given count of slots additionally through
+  /// a single allocation.
+  void reserve(std::size_t count) {
+    pool_.reserve(count);
+  }
+
+  /// Returns the count of slots which can be used by calls
+  /// without an allocation.
+  std::size_t available() const {
+    return pool_.available();
+  }
+
+  /// Converts a C-style callback taking callable into a continuable
+  /// which resolves with all arguments that are passed to the callback
+  /// after the user data.
+  ///
+  /// The callable is invoked with the given arguments, the \ref callback_type
+  /// and the `void*` user data that shall be passed to the C API.
+  ///
+  /// \since 4.3.0
+  template <typename Callable, typename... Args>
+  auto from(Callable&& callable, Args&&... args) {
+    return helper::template from<CArgs...>(
+        pool_,
+        [](auto&& promise) {
+          return std::forward<decltype(promise)>(promise);
+        },
+        std::forward<Callable>(callable), std::forward<Args>(args)...);
+  }
+
+  /// \copybrief from
+  ///
+  /// This modification of \ref from additionally takes a resolver callable
+  /// object which is invoked with the promise and the arguments passed to
+  /// the C callback, which makes it possible to convert error codes:
+  /// ```cpp
+  /// compressor.with<std::size_t>(
+  ///     [](auto&& promise, int error, std::size_t compressed) {
+  ///       if (error) {
+  ///         promise.set_exception(to_exception(error));
+  ///       } else {
+  ///         promise.set_value(compressed);
+  ///       }
+  ///     },
+  ///     [&](auto callback, void* user_data) {
+  ///       compress_async(data, size, callback, user_data);
+  ///     });
+  /// ```
+  ///
+  /// \tparam Result The result of the converted continuable.
+  ///
+  /// \since         4.3.0
+  template <typename... Result, typename Resolver, typename Callable,
+            typename... Args>
+  auto with(Resolver&& resolver, Callable&& callable, Args&&... args) {
+    return helper::template from<Result...>(
+        pool_,
+        [resolver = std::forward<Resolver>(resolver)](auto&& promise) mutable {
+          return detail::convert::c_resolver<
+              std::decay_t<Resolver>, std::decay_t<decltype(promise)>>{
+              std::move(resolver), std::forward<decltype(promise)>(promise)};
+        },
+        std::forward<Callable>(callable), std::forward<Args>(args)...);
+  }
+};
 /// \}
 } // namespace cti
 
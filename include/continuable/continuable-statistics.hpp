@@ -0,0 +1,228 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_STATISTICS_HPP_INCLUDED
+#define CONTINUABLE_STATISTICS_HPP_INCLUDED
+
+#include <utility>
+#include <vector>
+#include <continuable/continuable-base.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+#include <continuable/detail/other/spill.hpp>
+#include <continuable/detail/other/statistics.hpp>
+
+namespace cti {
+/// \defgroup Statistics Statistics
+/// provides optional latency histograms of labeled continuation stages,
+/// counters of the executors provided by the library
+/// and accounting of the objects stored in type erasures.
+///
+/// The statistics are disabled by default and cost nothing in this case.
+/// They are enabled by defining `CONTINUABLE_WITH_STAGE_STATISTICS` before
+/// the library is included. Afterwards every stage which was labeled
+/// through cti::label records the time it waited on its executor and the
+/// time its callback was running:
+/// ```cpp
+/// #define CONTINUABLE_WITH_STAGE_STATISTICS
+/// #include <continuable/continuable.hpp>
+///
+/// http_request("example.com")
+///   .then(parse, my_executor)
+///   .apply(cti::label("parse"))
+///   .then(store)
+///   .apply(cti::label("store"));
+///
+/// for (cti::stage_statistics const& stage : cti::statistics_snapshot()) {
+///   std::cout << stage.label << ": "
+///             << stage.run.percentile(99.).count() << "ns\n";
+/// }
+/// ```
+///
+/// Each thread records into its own histograms without locking,
+/// which are merged when a snapshot is requested.
+///
+/// This header is only included by `<continuable/continuable.hpp>`
+/// when one of the statistics is enabled, otherwise it needs to be included
+/// on its own, e.g. for using cti::latency_histogram directly.
+///
+/// \attention The definition needs to be the same in all translation units
+///            which include the library.
+/// \{
+
+/// A log-linear latency histogram with a relative precision of about 3%
+/// in the range of 0ns to about 18 minutes.
+///
+/// \since 4.3.0
+using latency_histogram = detail::statistics::latency_histogram;
+
+/// The merged histograms of all stages which carry the same label.
+///
+/// \since 4.3.0
+using stage_statistics = detail::statistics::stage_statistics;
+
+/// Returns a transform that labels the stage it is applied to,
+/// which is the last callback which was chained to the continuable_base
+/// through continuable_base::then, continuable_base::fail
+/// or continuable_base::next:
+/// ```cpp
+/// cti::make_ready_continuable(0)
+///   .then([](int value) { return value + 1; })
+///   .apply(cti::label("increment"));
+/// ```
+///
+/// \param name The label of the stage, the statistics of stages are merged
+///             by their label. The pointed string needs to outlive all
+///             stages which are labeled with it and all snapshots,
+///             string literals are the intended use case.
+///
+/// \note Continuables which weren't created from a chained callback
+///       (for instance type erased ones) are left unchanged. Nothing is
+///       recorded if `CONTINUABLE_WITH_STAGE_STATISTICS` isn't defined.
+///
+/// \since 4.3.0
+inline auto label(char const* name) {
+  return [name](auto&& continuable) {
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+    detail::base::attorney::label(continuable, name);
+#else  // CONTINUABLE_WITH_STAGE_STATISTICS
+    (void)name;
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
+    return std::forward<decltype(continuable)>(continuable);
+  };
+}
+
+/// Returns the statistics of all labeled stages, merged from the histograms
+/// of all threads which ever recorded a stage. The result is ordered by label.
+///
+/// \note Stages which are running concurrently to the snapshot may be
+///       partially included.
+///
+/// \since 4.3.0
+inline std::vector<stage_statistics> statistics_snapshot() {
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+  return detail::statistics::registry::instance().snapshot();
+#else  // CONTINUABLE_WITH_STAGE_STATISTICS
+  return {};
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
+}
+
+/// The counters of a queue of an executor provided by the library,
+/// see executor_metrics for details.
+///
+/// \since 4.3.0
+using queue_metrics = detail::metrics::queue_metrics;
+
+/// The counters of a thread of an executor provided by the library,
+/// see executor_metrics for details.
+///
+/// \since 4.3.0
+using worker_metrics = detail::metrics::worker_metrics;
+
+/// A snapshot of the queues and threads of an executor provided by the
+/// library, which is returned by the `snapshot` method of
+/// cti::shard::runtime, cti::deadline_scheduler, cti::run_loop and
+/// cti::blocking_pool when `CONTINUABLE_WITH_EXECUTOR_METRICS` is defined:
+/// ```cpp
+/// #define CONTINUABLE_WITH_EXECUTOR_METRICS
+/// #include <continuable/continuable.hpp>
+///
+/// cti::executor_metrics metrics = shards.snapshot();
+/// for (cti::queue_metrics const& queue : metrics.queues) {
+///   std::cout << queue.depth << " (peak " << queue.peak_depth << ")\n";
+/// }
+/// std::cout << "p99 queue wait "
+///           << metrics.queue_wait().percentile(99.).count() << "ns\n";
+/// ```
+///
+/// Every queue and thread records into its own counters which are
+/// separated by cache lines, the hot path only consists of relaxed atomic
+/// operations. Since reading the clock is the most expensive part,
+/// the queue wait is only recorded for every 16th work submitted from
+/// a thread, which is configurable through
+/// `CONTINUABLE_EXECUTOR_METRICS_SAMPLE_INTERVAL`.
+/// The snapshot is empty if `CONTINUABLE_WITH_EXECUTOR_METRICS`
+/// isn't defined, which costs nothing.
+///
+/// \note The counters are read without synchronizing with the executor,
+///       work which is submitted or started concurrently to the snapshot
+///       may be partially included.
+///
+/// \since 4.3.0
+using executor_metrics = detail::metrics::executor_metrics;
+
+/// The type erasure an object was stored in,
+/// which is either a cti::continuable, a cti::promise or a cti::work.
+///
+/// \since 4.3.0
+using erasure_kind = detail::spill::erasure_kind;
+
+/// The constructions of a type erasure with a specific signature,
+/// split into objects which were stored inline and objects which
+/// were allocated on the heap, together with the sizes of the objects.
+///
+/// \since 4.3.0
+using erasure_statistics = detail::spill::erasure_statistics;
+
+/// Returns the constructions of all type erasures with a specific signature
+/// ordered by their signature, which are recorded when
+/// `CONTINUABLE_WITH_ERASURE_STATISTICS` is defined:
+/// ```cpp
+/// #define CONTINUABLE_WITH_ERASURE_STATISTICS
+/// #include <continuable/continuable.hpp>
+///
+/// for (cti::erasure_statistics const& erasure : cti::erasure_report()) {
+///   std::cout << erasure.signature << ": "
+///             << erasure.heap_constructions << " of "
+///             << erasure.constructions() << " on the heap, "
+///             << "recommended capacity " << erasure.recommended_capacity
+///             << " (current " << erasure.capacity << ")\n";
+/// }
+/// ```
+///
+/// \param coverage The fraction of constructions the recommended capacity
+///                 should store inline, defaults to 99%.
+///
+/// \note Each stored type is counted through a single relaxed atomic
+///       increment after it was registered once. Erasures are only
+///       recorded when `CONTINUABLE_WITH_IMMEDIATE_TYPES` isn't defined.
+///
+/// \since 4.3.0
+inline std::vector<erasure_statistics> erasure_report(double coverage = 0.99) {
+#if defined(CONTINUABLE_WITH_ERASURE_STATISTICS)
+  return detail::spill::registry::instance().snapshot(coverage);
+#else  // CONTINUABLE_WITH_ERASURE_STATISTICS
+  (void)coverage;
+  return {};
+#endif // CONTINUABLE_WITH_ERASURE_STATISTICS
+}
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_STATISTICS_HPP_INCLUDED
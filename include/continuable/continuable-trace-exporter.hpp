@@ -0,0 +1,138 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_TRACE_EXPORTER_HPP_INCLUDED
+#define CONTINUABLE_TRACE_EXPORTER_HPP_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <continuable/continuable-tracing.hpp>
+
+namespace cti {
+/// \ingroup Tracing
+/// \{
+
+/// Collects trace events and writes them in the Chrome trace event format,
+/// which can be inspected in `chrome://tracing` or other trace viewers.
+///
+/// Every chain is displayed as its own track, and events are recorded
+/// together with the thread they were emitted on.
+/// ```cpp
+/// cti::chrome_trace_exporter exporter;
+///
+/// struct my_trace_hooks {
+///   static void trace(cti::trace_event const& event) noexcept {
+///     exporter.record(event);
+///   }
+/// };
+///
+/// // ...
+/// exporter.write("continuable-trace.json");
+/// ```
+///
+/// \since 4.3.0
+class chrome_trace_exporter {
+  struct recorded {
+    trace_event event;
+    std::thread::id thread;
+  };
+
+  mutable std::mutex lock_;
+  std::vector<recorded> events_;
+
+public:
+  /// Records the given event, this method is thread-safe
+  void record(trace_event const& event) {
+    std::thread::id const thread = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> guard(lock_);
+    events_.push_back(recorded{event, thread});
+  }
+
+  /// Returns the count of recorded events
+  std::size_t size() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return events_.size();
+  }
+
+  /// Removes all recorded events
+  void clear() {
+    std::lock_guard<std::mutex> guard(lock_);
+    events_.clear();
+  }
+
+  /// Writes all recorded events as Chrome trace event JSON to the stream
+  void write(std::ostream& out) const {
+    std::lock_guard<std::mutex> guard(lock_);
+
+    std::hash<std::thread::id> const thread_hash;
+
+    out << "{\"traceEvents\":[";
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+      auto const& current = events_[i];
+      auto const timestamp =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              current.event.timestamp.time_since_epoch())
+              .count();
+
+      if (i != 0) {
+        out << ",";
+      }
+      out << "\n{\"name\":\"" << to_string(current.event.kind)
+          << "\",\"cat\":\"continuable\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0"
+          << ",\"tid\":" << current.event.chain << ",\"ts\":"
+          << (timestamp / 1000) << "." << (timestamp % 1000 / 100)
+          << ",\"args\":{\"thread\":" << thread_hash(current.thread) << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  }
+
+  /// Writes all recorded events as Chrome trace event JSON to the file
+  /// at the given path, returns false when the file couldn't be written.
+  bool write(std::string const& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+    write(file);
+    return bool(file);
+  }
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_TRACE_EXPORTER_HPP_INCLUDED
@@ -0,0 +1,122 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_TRACING_HPP_INCLUDED
+#define CONTINUABLE_TRACING_HPP_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+
+namespace cti {
+/// \defgroup Tracing Tracing
+/// provides optional hooks into the lifecycle of continuations.
+///
+/// The hooks are disabled by default and cost nothing in this case.
+/// They are enabled by defining `CONTINUABLE_WITH_TRACE_HOOKS` to the name of
+/// a class which provides a static `trace` function accepting a
+/// cti::trace_event. The class has to be declared before the library
+/// is included:
+/// ```cpp
+/// #include <continuable/continuable-tracing.hpp>
+///
+/// struct my_trace_hooks {
+///   static void trace(cti::trace_event const& event) noexcept;
+/// };
+///
+/// #define CONTINUABLE_WITH_TRACE_HOOKS my_trace_hooks
+/// #include <continuable/continuable.hpp>
+/// ```
+///
+/// \attention The definition needs to be the same in all translation units
+///            which include the library.
+///
+/// The cti::chrome_trace_exporter is provided by
+/// `<continuable/continuable-trace-exporter.hpp>`, which isn't included
+/// by `<continuable/continuable.hpp>`.
+/// \{
+
+/// Describes the point in the lifecycle of a continuation a
+/// cti::trace_event was emitted at.
+///
+/// \since 4.3.0
+enum class trace_kind {
+  /// A continuation was created through make_continuable or
+  /// by chaining a callback through then, fail or next.
+  create,
+  /// A continuation chain was started through done or on destruction
+  dispatch,
+  /// A callback was submitted to an executor
+  submit,
+  /// A continuation was resolved with a result
+  resolve,
+  /// A continuation was resolved with an exception
+  fail,
+  /// A continuation was cancelled
+  cancel
+};
+
+/// Returns the name of the given cti::trace_kind
+///
+/// \since 4.3.0
+inline char const* to_string(trace_kind kind) noexcept {
+  switch (kind) {
+    case trace_kind::create:
+      return "create";
+    case trace_kind::dispatch:
+      return "dispatch";
+    case trace_kind::submit:
+      return "submit";
+    case trace_kind::resolve:
+      return "resolve";
+    case trace_kind::fail:
+      return "fail";
+    case trace_kind::cancel:
+      return "cancel";
+  }
+  return "unknown";
+}
+
+/// Is passed to the `trace` function of the class
+/// `CONTINUABLE_WITH_TRACE_HOOKS` is defined to.
+///
+/// \since 4.3.0
+struct trace_event {
+  /// The point in the lifecycle the event was emitted at
+  trace_kind kind;
+  /// The id of the continuation chain, all continuations which are chained
+  /// together through then, fail or next share the same id.
+  std::uint64_t chain;
+  /// The time at which the event was emitted
+  std::chrono::steady_clock::time_point timestamp;
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_TRACING_HPP_INCLUDED
@@ -31,6 +31,8 @@
 #ifndef CONTINUABLE_TRAVERSE_ASYNC_HPP_INCLUDED
 #define CONTINUABLE_TRAVERSE_ASYNC_HPP_INCLUDED
 
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <continuable/detail/traversal/traverse-async.hpp>
 
@@ -119,11 +121,41 @@ using async_traverse_in_place_tag =
 /// See `traverse_pack` for a detailed description about the
 /// traversal behaviour and capabilities.
 ///
-template <typename Visitor, typename... T>
+template <typename Visitor, typename... T,
+          std::enable_if_t<!std::is_same<std::decay_t<Visitor>,
+                                         std::allocator_arg_t>::value>* =
+              nullptr>
 auto traverse_pack_async(Visitor&& visitor, T&&... pack) {
   return detail::traversal::apply_pack_transform_async(
       std::forward<Visitor>(visitor), std::forward<T>(pack)...);
 }
+
+/// Traverses the pack with the given visitor in an asynchronous way,
+/// where the frame is allocated through the given allocator.
+///
+/// The frame which stores the visitor and the pack is the only allocation
+/// of the traversal, it is requested from the allocator through
+/// `std::allocate_shared`, which makes it possible to place the frame
+/// into a custom memory resource or arena.
+///
+/// \param   allocator The allocator which is used to allocate the frame.
+///
+/// \param   visitor   A visitor object which provides the three `operator()`
+///                    overloads that are described in \ref traverse_pack_async.
+///
+/// \param   pack      The arbitrary parameter pack which is traversed
+///                    asynchronously.
+///
+/// \returns           A std::shared_ptr that references an instance of
+///                    the given visitor object.
+///
+/// \since             4.3.0
+template <typename Allocator, typename Visitor, typename... T>
+auto traverse_pack_async(std::allocator_arg_t, Allocator const& allocator,
+                         Visitor&& visitor, T&&... pack) {
+  return detail::traversal::apply_pack_transform_async_allocate(
+      allocator, std::forward<Visitor>(visitor), std::forward<T>(pack)...);
+}
 /// \}
 } // namespace cti
 
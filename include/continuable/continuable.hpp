@@ -53,9 +53,16 @@ namespace cti {}
 #include <continuable/continuable-promise-base.hpp>
 #include <continuable/continuable-promisify.hpp>
 #include <continuable/continuable-result.hpp>
+#include <continuable/continuable-tracing.hpp>
 #include <continuable/continuable-transforms.hpp>
 #include <continuable/continuable-traverse-async.hpp>
 #include <continuable/continuable-traverse.hpp>
 #include <continuable/continuable-types.hpp>
 
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS) ||                              \
+    defined(CONTINUABLE_WITH_EXECUTOR_METRICS) ||                              \
+    defined(CONTINUABLE_WITH_ERASURE_STATISTICS)
+#include <continuable/continuable-statistics.hpp>
+#endif
+
 #endif // CONTINUABLE_HPP_INCLUDED
@@ -32,19 +32,30 @@
 #define CONTINUABLE_DETAIL_CONNECTION_ALL_HPP_INCLUDED
 
 #include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/detail/connection/connection-aggregated.hpp>
 #include <continuable/detail/connection/connection.hpp>
 #include <continuable/detail/core/annotation.hpp>
 #include <continuable/detail/core/base.hpp>
 #include <continuable/detail/core/types.hpp>
+#include <continuable/detail/features.hpp>
 #include <continuable/detail/utility/traits.hpp>
 
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+#include <exception>
+#include <stdexcept>
+#else
+#include <system_error>
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
 namespace cti {
 namespace detail {
 namespace connection {
@@ -143,6 +154,223 @@ struct continuable_dispatcher {
     box.fetch().next(submitter->create_callback(std::addressof(box))).done();
   }
 };
+
+/// Stores the results into a std::vector which is allocated once
+/// and passed to the final callback.
+template <typename T>
+class owning_target {
+  std::vector<T> values_;
+
+public:
+  /// The results are owned by the connection, therefore the first error
+  /// is forwarded immediately.
+  static constexpr bool defers_errors = false;
+
+  static constexpr identity<std::vector<T>> hint() noexcept {
+    return {};
+  }
+
+  bool prepare(std::size_t size) {
+    values_.resize(size);
+    return true;
+  }
+
+  T& operator[](std::size_t index) noexcept {
+    return values_[index];
+  }
+
+  template <typename Callback>
+  void resolve(Callback&& callback) {
+    std::forward<Callback>(callback)(std::move(values_));
+  }
+};
+
+/// Stores the results into a caller supplied contiguous storage,
+/// the final callback is invoked without any arguments.
+template <typename T>
+class span_target {
+  T* data_;
+  std::size_t size_;
+
+public:
+  explicit span_target(T* data, std::size_t size) : data_(data), size_(size) {
+  }
+
+  /// The storage may be destroyed by the caller as soon as an error was
+  /// forwarded, therefore errors are forwarded after all results arrived.
+  static constexpr bool defers_errors = true;
+
+  static constexpr identity<> hint() noexcept {
+    return {};
+  }
+
+  bool prepare(std::size_t size) noexcept {
+    return size <= size_;
+  }
+
+  T& operator[](std::size_t index) noexcept {
+    return data_[index];
+  }
+
+  template <typename Callback>
+  void resolve(Callback&& callback) {
+    std::forward<Callback>(callback)();
+  }
+};
+
+/// Writes the results of a homogeneous container of continuables in place
+/// into a single contiguous target. This class is thread safe.
+template <typename Callback, typename Target>
+class contiguous_submitter
+    : public std::enable_shared_from_this<
+          contiguous_submitter<Callback, Target>>,
+      public util::non_movable {
+
+  Callback callback_;
+  Target target_;
+
+  std::atomic<std::size_t> left_;
+  std::atomic<bool> failed_{false};
+  exception_t error_;
+  std::once_flag flag_;
+
+  // Invokes the callback with the stored results or the deferred error
+  void invoke() {
+    assert((left_ == 0U) && "Expected that the submitter is finished!");
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    std::call_once(flag_, [&] {
+      if (failed_.load(std::memory_order_relaxed)) {
+        std::move(callback_)(exception_arg_t{}, std::move(error_));
+      } else {
+        target_.resolve(std::move(callback_));
+      }
+    });
+  }
+
+  // Completes one result
+  void complete_one() {
+    assert((left_ > 0U) && "Expected that the submitter isn't finished!");
+
+    auto const current = --left_;
+    if (!current) {
+      invoke();
+    }
+  }
+
+  struct partial_contiguous_callback {
+    std::size_t index;
+    std::shared_ptr<contiguous_submitter> me;
+
+    template <typename Arg>
+    void operator()(Arg&& arg) && {
+      // Write the result to its slot in the target,
+      // which is pointless after a failure.
+      if (!me->failed_.load(std::memory_order_relaxed)) {
+        me->target_[index] = std::forward<Arg>(arg);
+      }
+
+      me->complete_one();
+    }
+
+    void operator()(exception_arg_t tag, exception_t exception) && {
+      if (!Target::defers_errors) {
+        // We never complete the connection, but we forward the first error
+        // which was raised.
+        std::call_once(me->flag_, std::move(me->callback_), tag,
+                       std::move(exception));
+        return;
+      }
+
+      // Keep the first error which is forwarded when no pending callback
+      // writes into the target anymore.
+      if (!me->failed_.exchange(true, std::memory_order_acq_rel)) {
+        me->error_ = std::move(exception);
+      }
+      me->complete_one();
+    }
+  };
+
+  static exception_t storage_too_small() {
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    return std::make_exception_ptr(std::length_error(
+        "The storage is too small for the results of the connection!"));
+#else
+    return std::make_error_condition(std::errc::no_buffer_space);
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+  }
+
+public:
+  explicit contiguous_submitter(Callback callback, Target&& target)
+      : callback_(std::move(callback)), target_(std::move(target)), left_(1) {
+  }
+
+  /// Dispatches all continuables and frees every continuable
+  /// directly after it was dispatched.
+  template <typename Continuables>
+  void dispatch(Continuables continuables) {
+    if (!target_.prepare(continuables.size())) {
+      // The continuables are frozen and therefore dropped without
+      // being started.
+      std::call_once(flag_, std::move(callback_), exception_arg_t{},
+                     storage_too_small());
+      return;
+    }
+
+    left_.fetch_add(continuables.size(), std::memory_order_seq_cst);
+
+    std::size_t index = 0U;
+    for (auto& continuable : continuables) {
+      std::move(continuable)
+          .next(partial_contiguous_callback{index++, this->shared_from_this()})
+          .done();
+    }
+  }
+
+  /// Initially the counter is created with an initial count of 1 in order
+  /// to prevent that the connection is finished before all callbacks
+  /// were registered.
+  void accept() {
+    complete_one();
+  }
+};
+
+/// Connects the homogeneous container of continuables with an all logic,
+/// which writes the results in place into the given target.
+template <typename Continuables, typename Target>
+auto connect_contiguous(Continuables&& continuables, Target&& target) {
+  util::ownership ownership;
+  for (auto& continuable : continuables) {
+    util::ownership current = base::attorney::ownership_of(continuable);
+    assert(current.is_acquired() &&
+           "Only valid continuables should be passed!");
+
+    // Propagate a frozen state to the new continuable
+    if (!ownership.is_frozen() && current.is_frozen()) {
+      ownership.freeze();
+    }
+
+    // Freeze the continuable since it is stored for later usage
+    continuable.freeze();
+  }
+
+  return base::attorney::create_from(
+      [continuables = std::forward<Continuables>(continuables),
+       target = std::forward<Target>(target)](auto&& callback) mutable {
+        using submitter_t =
+            contiguous_submitter<std::decay_t<decltype(callback)>,
+                                 std::decay_t<Target>>;
+
+        auto state = std::make_shared<submitter_t>(
+            std::forward<decltype(callback)>(callback), std::move(target));
+
+        state->dispatch(std::move(continuables));
+
+        // Finalize the connection if all results arrived in-place
+        state->accept();
+      },
+      std::decay_t<Target>::hint(), std::move(ownership));
+}
 } // namespace all
 
 struct connection_strategy_all_tag {};
@@ -50,14 +50,31 @@ namespace cti {
 namespace detail {
 namespace connection {
 namespace any {
+/// Invokes the callback with the arguments of the first invocation only,
+/// all subsequent invocations are ignored.
+template <typename T>
+class first_result : public util::non_movable {
+  T callback_;
+  std::once_flag flag_;
+
+public:
+  explicit first_result(T callback) : callback_(std::move(callback)) {
+  }
+
+  template <typename... ActualArgs>
+  void operator()(ActualArgs&&... args) {
+    std::call_once(flag_, std::move(callback_),
+                   std::forward<ActualArgs>(args)...);
+  }
+};
+
 /// Invokes the callback with the first arriving result
 template <typename T>
 class any_result_submitter
     : public std::enable_shared_from_this<any_result_submitter<T>>,
       public util::non_movable {
 
-  T callback_;
-  std::once_flag flag_;
+  first_result<T> result_;
 
   struct any_callback {
     std::shared_ptr<any_result_submitter> me_;
@@ -69,7 +86,7 @@ class any_result_submitter
   };
 
 public:
-  explicit any_result_submitter(T callback) : callback_(std::move(callback)) {
+  explicit any_result_submitter(T callback) : result_(std::move(callback)) {
   }
 
   /// Creates a submitter which submits it's result to the callback
@@ -81,8 +98,7 @@ private:
   // Invokes the callback with the given arguments
   template <typename... ActualArgs>
   void invoke(ActualArgs&&... args) {
-    std::call_once(flag_, std::move(callback_),
-                   std::forward<ActualArgs>(args)...);
+    result_(std::forward<ActualArgs>(args)...);
   }
 };
 
@@ -32,10 +32,13 @@
 #define CONTINUABLE_DETAIL_CONNECTION_SEQ_HPP_INCLUDED
 
 #include <cassert>
+#include <cstddef>
+#include <initializer_list>
 #include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-traverse-async.hpp>
 #include <continuable/detail/connection/connection-aggregated.hpp>
@@ -47,27 +50,6 @@ namespace cti {
 namespace detail {
 namespace connection {
 namespace seq {
-/// Connects the left and the right continuable to a sequence
-///
-/// \note This is implemented in an eager way because we would not gain
-///       any profit from chaining sequences lazily.
-template <typename Left, typename Right>
-auto sequential_connect(Left&& left, Right&& right) {
-  left.freeze(right.is_frozen());
-  right.freeze();
-
-  return std::forward<Left>(left).then(
-      [right = std::forward<Right>(right)](auto&&... args) mutable {
-        return std::move(right).then(
-            [previous = std::make_tuple(std::forward<decltype(args)>(args)...)](
-                auto&&... args) mutable {
-              return std::tuple_cat(
-                  std::move(previous),
-                  std::make_tuple(std::forward<decltype(args)>(args)...));
-            });
-      });
-}
-
 template <typename Callback, typename Box>
 struct sequential_dispatch_data {
   Callback callback;
@@ -117,7 +99,7 @@ public:
           box->assign(std::forward<decltype(args)>(args)...);
 
           // Continue the asynchronous sequential traversal
-          next();
+          std::move(next)();
         })
         .fail([me = this->shared_from_this()](exception_t exception) {
           // Abort the traversal when an error occurred
@@ -133,6 +115,313 @@ public:
                                      std::move(data_.box));
   }
 };
+
+/// Stores the callback and the boxed continuables of a flat sequence.
+///
+/// The frame is owned by the callback of the continuable which is currently
+/// running, every continuable writes its result directly into its box.
+template <typename Callback, typename Boxes>
+struct sequential_chain_frame {
+  Callback callback;
+  Boxes boxes;
+
+  explicit sequential_chain_frame(Callback callback, Boxes boxes)
+      : callback(std::move(callback)), boxes(std::move(boxes)) {
+  }
+};
+
+/// The count of continuables up to which the frame of a flat sequence is
+/// moved from callback to callback instead of being allocated on the heap.
+///
+/// Short sequences such as most `operator>>` chains stay free of
+/// allocations this way, while longer sequences don't move all of their
+/// results on every step.
+constexpr std::size_t inline_chain_frame_limit = 8U;
+
+/// Returns the frame of a sequence which is owned inline or on the heap
+template <typename Frame>
+Frame& frame_of(std::unique_ptr<Frame>& holder) noexcept {
+  return *holder;
+}
+template <typename Callback, typename Boxes>
+sequential_chain_frame<Callback, Boxes>&
+frame_of(sequential_chain_frame<Callback, Boxes>& holder) noexcept {
+  return holder;
+}
+
+template <std::size_t Index, typename Holder>
+void sequential_chain_step(Holder&& holder);
+
+/// Assigns the result of the continuable at the given index
+/// and continues the sequence with the next one.
+template <typename Hint, std::size_t Index, typename Holder>
+struct sequential_chain_callback;
+template <typename... Args, std::size_t Index, typename Holder>
+struct sequential_chain_callback<identity<Args...>, Index, Holder>
+    : util::non_copyable {
+
+  Holder holder;
+
+  explicit sequential_chain_callback(Holder&& holder)
+      : holder(std::move(holder)) {
+  }
+
+  void operator()(Args... args) && {
+    std::get<Index>(frame_of(holder).boxes).assign(std::move(args)...);
+    sequential_chain_step<Index + 1>(std::move(holder));
+  }
+
+  void operator()(exception_arg_t tag, exception_t exception) && {
+    // Abort the sequence when an error occurred
+    std::move(frame_of(holder).callback)(tag, std::move(exception));
+  }
+
+  void set_value(Args... args) noexcept {
+    std::move(*this)(std::move(args)...);
+  }
+
+  void set_exception(exception_t exception) noexcept {
+    std::move(*this)(exception_arg_t{}, std::move(exception));
+  }
+
+  void set_canceled() noexcept {
+    std::move(*this)(exception_arg_t{}, exception_t{});
+  }
+
+  explicit operator bool() const noexcept {
+    return true;
+  }
+};
+
+/// Deduces the hint of the continuable inside the given box
+template <typename Box>
+struct box_hint_of;
+template <typename Data, typename... Args>
+struct box_hint_of<
+    aggregated::continuable_box<continuable_base<Data, identity<Args...>>>>
+    : std::common_type<identity<Args...>> {};
+
+template <std::size_t Index, typename Holder>
+void sequential_chain_step_impl(std::true_type /*is_finished*/,
+                                Holder&& holder) {
+  auto& frame = frame_of(holder);
+  aggregated::finalize_data(std::move(frame.callback), std::move(frame.boxes));
+}
+template <std::size_t Index, typename Holder>
+void sequential_chain_step_impl(std::false_type /*is_finished*/,
+                                Holder&& holder) {
+  auto& box = std::get<Index>(frame_of(holder).boxes);
+  if (base::attorney::is_ready(box.peek())) {
+    // The result can be resolved directly
+    traits::unpack(
+        [&](auto&&... args) mutable {
+          box.assign(std::forward<decltype(args)>(args)...);
+        },
+        base::attorney::query(box.fetch()));
+
+    sequential_chain_step<Index + 1>(std::move(holder));
+  } else {
+    // The continuation is moved out of its box first,
+    // since an inline frame is moved into the callback.
+    auto continuation = box.fetch();
+    using hint_t = typename box_hint_of<std::decay_t<decltype(box)>>::type;
+
+    base::invoke_continuation(
+        std::move(continuation),
+        sequential_chain_callback<hint_t, Index, Holder>(std::move(holder)));
+  }
+}
+
+template <std::size_t Index, typename Holder>
+void sequential_chain_step(Holder&& holder) {
+  constexpr std::size_t size =
+      std::tuple_size<std::decay_t<decltype(frame_of(holder).boxes)>>::value;
+
+  sequential_chain_step_impl<Index>(std::integral_constant<bool, Index == size>{},
+                                    std::forward<Holder>(holder));
+}
+
+/// Evaluates to true when the connection consists of continuables only,
+/// which is always the case for connections created through `operator>>`.
+template <typename Connection>
+struct is_flat_connection : std::false_type {};
+template <typename... T>
+struct is_flat_connection<std::tuple<T...>>
+    : traits::conjunction<
+          aggregated::is_continuable_box<std::decay_t<T>>...> {};
+
+/// Moves the frame of a short sequence from callback to callback
+template <typename Frame>
+void dispatch_frame(std::true_type /*is_inline*/, Frame&& frame) {
+  sequential_chain_step<0U>(std::forward<Frame>(frame));
+}
+/// Keeps the frame of a long sequence on the heap
+template <typename Frame>
+void dispatch_frame(std::false_type /*is_inline*/, Frame&& frame) {
+  using frame_t = std::decay_t<Frame>;
+  sequential_chain_step<0U>(
+      std::unique_ptr<frame_t>(new frame_t(std::forward<Frame>(frame))));
+}
+
+/// Resolves a flat sequence of boxed continuables one after another,
+/// which requires a single instantiation per continuable instead of the
+/// resumption points created by the asynchronous traversal.
+template <typename Callback, typename Boxes>
+void dispatch(std::true_type /*is_flat*/, Callback&& callback, Boxes&& boxes) {
+  using frame_t =
+      sequential_chain_frame<std::decay_t<Callback>, std::decay_t<Boxes>>;
+
+  dispatch_frame(
+      std::integral_constant<bool, (std::tuple_size<std::decay_t<Boxes>>::value <=
+                                    inline_chain_frame_limit)>{},
+      frame_t(std::forward<Callback>(callback), std::forward<Boxes>(boxes)));
+}
+/// Resolves an arbitrary nested sequence through the asynchronous traversal
+template <typename Callback, typename Boxes>
+void dispatch(std::false_type /*is_flat*/, Callback&& callback,
+              Boxes&& boxes) {
+  // The data from which the visitor is constructed in-place
+  using data_t =
+      sequential_dispatch_data<std::decay_t<Callback>, std::decay_t<Boxes>>;
+
+  // The visitor type
+  using visitor_t = sequential_dispatch_visitor<data_t>;
+
+  traverse_pack_async(
+      async_traverse_in_place_tag<visitor_t>{},
+      data_t{std::forward<Callback>(callback), std::forward<Boxes>(boxes)});
+}
+
+template <typename Callback>
+class discarded_sequence;
+
+/// A continuable of a sequence whose results are discarded
+template <typename Callback>
+class discarded_step {
+public:
+  virtual ~discarded_step() = default;
+
+  virtual void
+  invoke(std::unique_ptr<discarded_sequence<Callback>> sequence) = 0;
+};
+
+/// Continues a sequence whose results are discarded with the next step
+template <typename Callback>
+struct discarded_callback : util::non_copyable {
+  std::unique_ptr<discarded_sequence<Callback>> sequence;
+
+  explicit discarded_callback(
+      std::unique_ptr<discarded_sequence<Callback>> sequence)
+      : sequence(std::move(sequence)) {
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... /*args*/) && {
+    discarded_sequence<Callback>::resume(std::move(sequence));
+  }
+
+  void operator()(exception_arg_t tag, exception_t exception) && {
+    // Abort the sequence when an error occurred
+    std::move(sequence->callback)(tag, std::move(exception));
+  }
+
+  template <typename... Args>
+  void set_value(Args&&... args) noexcept {
+    std::move(*this)(std::forward<Args>(args)...);
+  }
+
+  void set_exception(exception_t exception) noexcept {
+    std::move(*this)(exception_arg_t{}, std::move(exception));
+  }
+
+  void set_canceled() noexcept {
+    std::move(*this)(exception_arg_t{}, exception_t{});
+  }
+
+  explicit operator bool() const noexcept {
+    return true;
+  }
+};
+
+template <typename Callback, typename Continuable>
+class discarded_continuable : public discarded_step<Callback> {
+  Continuable continuable_;
+
+public:
+  explicit discarded_continuable(Continuable continuable)
+      : continuable_(std::move(continuable)) {
+  }
+
+  void
+  invoke(std::unique_ptr<discarded_sequence<Callback>> sequence) override {
+    base::invoke_continuation(std::move(continuable_),
+                              discarded_callback<Callback>(std::move(sequence)));
+  }
+};
+
+/// Resolves the steps of a sequence whose results are discarded one
+/// after another, which is the case when an `operator>>` chain is
+/// finalized through continuable_base::done() or its destructor.
+///
+/// Every step is erased such that it is instantiated once per continuable,
+/// instead of once per intermediate connection of an `operator>>` chain,
+/// since each of them could be finalized on destruction.
+template <typename Callback>
+class discarded_sequence {
+public:
+  Callback callback;
+  std::vector<std::unique_ptr<discarded_step<Callback>>> steps;
+  std::size_t position = 0U;
+
+  explicit discarded_sequence(Callback callback)
+      : callback(std::move(callback)) {
+  }
+
+  template <typename Continuable>
+  void push(Continuable&& continuable) {
+    using step_t =
+        discarded_continuable<Callback, traits::unrefcv_t<Continuable>>;
+    steps.emplace_back(new step_t(std::forward<Continuable>(continuable)));
+  }
+
+  static void resume(std::unique_ptr<discarded_sequence> sequence) {
+    if (sequence->position == sequence->steps.size()) {
+      std::move(sequence->callback)();
+      return;
+    }
+
+    auto& step = *sequence->steps[sequence->position++];
+    step.invoke(std::move(sequence));
+  }
+};
+
+/// Invokes the continuables of a lazy sequence one after another
+/// and discards their results
+template <typename... T>
+void finalize_discarded(std::tuple<T...> connection,
+                        util::ownership ownership) {
+  base::finalize_continuation(base::attorney::create_from(
+      [connection = std::move(connection)](auto&& callback) mutable {
+        using callback_t = std::decay_t<decltype(callback)>;
+
+        std::unique_ptr<discarded_sequence<callback_t>> sequence(
+            new discarded_sequence<callback_t>(
+                std::forward<decltype(callback)>(callback)));
+        sequence->steps.reserve(sizeof...(T));
+
+        traits::unpack(
+            [&](auto&&... continuables) {
+              (void)std::initializer_list<int>{
+                  (sequence->push(
+                       std::forward<decltype(continuables)>(continuables)),
+                   0)...};
+            },
+            std::move(connection));
+
+        discarded_sequence<callback_t>::resume(std::move(sequence));
+      },
+      identity<>{}, std::move(ownership)));
+}
 } // namespace seq
 
 struct connection_strategy_seq_tag {};
@@ -154,17 +443,9 @@ struct connection_finalizer<connection_strategy_seq_tag> {
 
     return base::attorney::create_from(
         [res = std::move(res)](auto&& callback) mutable {
-          // The data from which the visitor is constructed in-place
-          using data_t =
-              seq::sequential_dispatch_data<std::decay_t<decltype(callback)>,
-                                            std::decay_t<decltype(res)>>;
-
-          // The visitor type
-          using visitor_t = seq::sequential_dispatch_visitor<data_t>;
-
-          traverse_pack_async(async_traverse_in_place_tag<visitor_t>{},
-                              data_t{std::forward<decltype(callback)>(callback),
-                                     std::move(res)});
+          seq::dispatch(seq::is_flat_connection<std::decay_t<decltype(res)>>{},
+                        std::forward<decltype(callback)>(callback),
+                        std::move(res));
         },
         signature, std::move(ownership));
   }
@@ -175,7 +456,19 @@ struct connection_finalizer<connection_strategy_seq_tag> {
 template <>
 struct annotation_trait<connection::connection_strategy_seq_tag>
     : connection::connection_annotation_trait<
-          connection::connection_strategy_seq_tag> {};
+          connection::connection_strategy_seq_tag> {
+
+  /// Invokes the sequence without finalizing it, since the results are
+  /// discarded anyway and the finalization would be instantiated for
+  /// every intermediate connection of an `operator>>` chain.
+  template <typename Continuable>
+  static void done(Continuable&& continuable) {
+    util::ownership ownership = base::attorney::ownership_of(continuable);
+    connection::seq::finalize_discarded(
+        base::attorney::consume(std::forward<Continuable>(continuable)),
+        std::move(ownership));
+  }
+};
 
 } // namespace detail
 } // namespace cti
@@ -143,6 +143,13 @@ struct connection_annotation_trait {
   static bool is_ready(Continuable const& /*continuable*/) noexcept {
     return false;
   }
+
+  /// Finalizes the connection and invokes it while discarding its result
+  template <typename Continuable>
+  static void done(Continuable&& continuable) {
+    base::finalize_continuation(
+        finish(std::forward<Continuable>(continuable)));
+  }
 };
 
 class prepare_continuables {
@@ -47,6 +47,14 @@
 #include <exception>
 #endif // CONTINUABLE_HAS_EXCEPTIONS
 
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+#include <continuable/detail/other/tracing.hpp>
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+#include <continuable/detail/other/statistics.hpp>
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
+
 namespace cti {
 namespace detail {
 /// The namespace `base` provides the low level API for working
@@ -151,6 +159,10 @@ struct attorney {
   template <typename T, typename Annotation>
   static auto create_from_raw(T&& continuation, Annotation,
                               util::ownership ownership) {
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+    tracing::on_create(ownership);
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+
     using continuation_t = continuable_base<traits::unrefcv_t<T>, //
                                             traits::unrefcv_t<Annotation>>;
     return continuation_t{std::forward<T>(continuation), ownership};
@@ -163,9 +175,19 @@ struct attorney {
   template <typename T, typename Hint>
   static auto create_from(T&& continuation, Hint, util::ownership ownership) {
     using hint_t = traits::unrefcv_t<Hint>;
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+    tracing::on_create(ownership);
+
+    auto traced = tracing::trace_continuation(std::forward<T>(continuation),
+                                              ownership.chain());
+    using proxy_t = proxy_continuable<hint_t, decltype(traced)>;
+    return continuable_base<proxy_t, hint_t>{proxy_t{std::move(traced)},
+                                             ownership};
+#else  // CONTINUABLE_WITH_TRACE_HOOKS
     using proxy_t = proxy_continuable<hint_t, traits::unrefcv_t<T>>;
     return continuable_base<proxy_t, hint_t>{
         proxy_t{std::forward<T>(continuation)}, ownership};
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
   }
 
   /// Returns the ownership of the given continuable_base
@@ -188,7 +210,20 @@ struct attorney {
   static auto query(continuable_base<Data, Annotation>&& continuation) {
     return std::move(continuation).consume()(unpack_arg_t{});
   }
+
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+  /// Labels the stage the given continuable_base was chained from
+  template <typename Data, typename Annotation>
+  static void label(continuable_base<Data, Annotation>& continuation,
+                    char const* name) noexcept {
+    statistics::label_stage(continuation.data_, name, 0);
+  }
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
 };
+
+template <typename Data, typename... Args>
+void finalize_continuation(
+    continuable_base<Data, identity<Args...>>&& continuation) noexcept;
 } // namespace base
 
 template <typename Annotation>
@@ -206,6 +241,11 @@ struct annotation_trait<identity<Args...>> {
   static bool is_ready(Continuable const& continuable) noexcept {
     return base::attorney::is_ready(continuable);
   }
+
+  template <typename Continuable>
+  static void done(Continuable&& continuable) noexcept {
+    base::finalize_continuation(std::forward<Continuable>(continuable));
+  }
 };
 
 namespace base {
@@ -221,6 +261,10 @@ annotation_of(identity<continuable_base<Data, //
 template <typename Data, typename Annotation, typename Callback>
 void invoke_continuation(continuable_base<Data, Annotation>&& continuation,
                          Callback&& callback) noexcept {
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+  // The continuation may run arbitrary code before it resolves
+  statistics::forget_boundary();
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
   util::invoke(attorney::consume(std::move(continuation).finish()),
                std::forward<Callback>(callback));
 }
@@ -256,7 +300,40 @@ public:
   }
 };
 
+/// Deduces to a std::true_type if the callback is declared as non throwing
+/// for the arguments it is invoked with through invoke_callback.
+template <typename T, typename... Args>
+struct is_nothrow_callback
+    : util::is_nothrow_partial_invocable<0U, T, Args...> {};
+template <typename T, typename... Args>
+struct is_nothrow_callback<T, exception_arg_t, Args...>
+    : util::is_nothrow_partial_invocable<1U, T, exception_arg_t, Args...> {};
+template <typename T, typename... Args>
+struct is_nothrow_callback<T, exception_arg_t&&, Args...>
+    : util::is_nothrow_partial_invocable<1U, T, exception_arg_t&&, Args...> {};
+template <typename T, typename... Args>
+struct is_nothrow_callback<T, exception_arg_t&, Args...>
+    : util::is_nothrow_partial_invocable<1U, T, exception_arg_t&, Args...> {};
+
 #if defined(CONTINUABLE_HAS_EXCEPTIONS)
+/// Invokes the body and forwards thrown exceptions to the next callback
+template <typename NextCallback, typename Body>
+void invoke_guarded(std::false_type, NextCallback&& next_callback,
+                    Body&& body) {
+  try {
+    std::forward<Body>(body)();
+  } catch (...) {
+    std::forward<NextCallback>(next_callback)(exception_arg_t{},
+                                              std::current_exception());
+  }
+}
+/// Invokes the body of a non throwing callback, no try block is required.
+template <typename NextCallback, typename Body>
+void invoke_guarded(std::true_type, NextCallback&& /*next_callback*/,
+                    Body&& body) noexcept {
+  std::forward<Body>(body)();
+}
+
 #define CONTINUABLE_BLOCK_TRY_BEGIN try {
 #define CONTINUABLE_BLOCK_TRY_END                                              \
   }                                                                            \
@@ -265,9 +342,19 @@ public:
         exception_arg_t{}, std::current_exception());                          \
   }
 
+// Omits the try block at compile-time when the callback is noexcept
+#define CONTINUABLE_BLOCK_GUARD_BEGIN                                          \
+  invoke_guarded(                                                              \
+      is_nothrow_callback<decltype(callback), decltype(args)...>{},            \
+      std::forward<decltype(next_callback)>(next_callback), [&] {
+#define CONTINUABLE_BLOCK_GUARD_END                                            \
+  });
+
 #else // CONTINUABLE_HAS_EXCEPTIONS
 #define CONTINUABLE_BLOCK_TRY_BEGIN {
 #define CONTINUABLE_BLOCK_TRY_END }
+#define CONTINUABLE_BLOCK_GUARD_BEGIN {
+#define CONTINUABLE_BLOCK_GUARD_END }
 #endif // CONTINUABLE_HAS_EXCEPTIONS
 
 /// Invokes the callback partially, keeps the exception_arg_t such that
@@ -309,6 +396,8 @@ constexpr auto invoker_of(identity<continuable_base<Data, Annotation>>) {
 
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
+        // The returned continuation may throw itself when being invoked,
+        // therefore the try block is kept even for noexcept callbacks.
         CONTINUABLE_BLOCK_TRY_BEGIN
           auto continuation_ =
               invoke_callback(std::forward<decltype(callback)>(callback),
@@ -327,14 +416,14 @@ template <typename T>
 constexpr auto invoker_of(identity<T>) {
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
-        CONTINUABLE_BLOCK_TRY_BEGIN
+        CONTINUABLE_BLOCK_GUARD_BEGIN
           auto result =
               invoke_callback(std::forward<decltype(callback)>(callback),
                               std::forward<decltype(args)>(args)...);
 
           invoke_no_except(std::forward<decltype(next_callback)>(next_callback),
                            std::move(result));
-        CONTINUABLE_BLOCK_TRY_END
+        CONTINUABLE_BLOCK_GUARD_END
       },
       identify<T>{});
 }
@@ -344,14 +433,14 @@ template <typename T>
 constexpr auto invoker_of(identity<types::plain_tag<T>>) {
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
-        CONTINUABLE_BLOCK_TRY_BEGIN
+        CONTINUABLE_BLOCK_GUARD_BEGIN
           types::plain_tag<T> result =
               invoke_callback(std::forward<decltype(callback)>(callback),
                               std::forward<decltype(args)>(args)...);
 
           invoke_no_except(std::forward<decltype(next_callback)>(next_callback),
                            std::move(result).consume());
-        CONTINUABLE_BLOCK_TRY_END
+        CONTINUABLE_BLOCK_GUARD_END
       },
       identify<T>{});
 }
@@ -360,12 +449,12 @@ constexpr auto invoker_of(identity<types::plain_tag<T>>) {
 inline auto invoker_of(identity<void>) {
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
-        CONTINUABLE_BLOCK_TRY_BEGIN
+        CONTINUABLE_BLOCK_GUARD_BEGIN
           invoke_callback(std::forward<decltype(callback)>(callback),
                           std::forward<decltype(args)>(args)...);
                           
           invoke_no_except(std::forward<decltype(next_callback)>(next_callback));
-        CONTINUABLE_BLOCK_TRY_END
+        CONTINUABLE_BLOCK_GUARD_END
       },
       identity<>{});
 }
@@ -375,7 +464,7 @@ inline auto invoker_of(identity<empty_result>) {
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
         (void)next_callback;
-        CONTINUABLE_BLOCK_TRY_BEGIN
+        CONTINUABLE_BLOCK_GUARD_BEGIN
           empty_result result =
               invoke_callback(std::forward<decltype(callback)>(callback),
                               std::forward<decltype(args)>(args)...);
@@ -383,7 +472,7 @@ inline auto invoker_of(identity<empty_result>) {
           // Don't invoke anything here since returning an empty result
           // aborts the asynchronous chain effectively.
           (void)result;
-        CONTINUABLE_BLOCK_TRY_END
+        CONTINUABLE_BLOCK_GUARD_END
       },
       identity<>{});
 }
@@ -393,7 +482,7 @@ inline auto invoker_of(identity<cancellation_result>) {
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
         (void)next_callback;
-        CONTINUABLE_BLOCK_TRY_BEGIN
+        CONTINUABLE_BLOCK_GUARD_BEGIN
           cancellation_result result = invoke_callback(
               std::forward<decltype(callback)>(callback),
               std::forward<decltype(args)>(args)...);
@@ -403,7 +492,7 @@ inline auto invoker_of(identity<cancellation_result>) {
                            exception_arg_t{}, exception_t{});
 
           (void)result;
-        CONTINUABLE_BLOCK_TRY_END
+        CONTINUABLE_BLOCK_GUARD_END
       },
       identity<>{});
 }
@@ -413,7 +502,7 @@ inline auto invoker_of(identity<exceptional_result>) {
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
         util::unused(callback, next_callback, args...);
-        CONTINUABLE_BLOCK_TRY_BEGIN
+        CONTINUABLE_BLOCK_GUARD_BEGIN
           exceptional_result result =
               invoke_callback(std::forward<decltype(callback)>(callback),
                               std::forward<decltype(args)>(args)...);
@@ -422,7 +511,7 @@ inline auto invoker_of(identity<exceptional_result>) {
           invoke_no_except(std::forward<decltype(next_callback)>(next_callback),
                            exception_arg_t{},
                            std::move(result).get_exception());
-        CONTINUABLE_BLOCK_TRY_END
+        CONTINUABLE_BLOCK_GUARD_END
       },
       identity<>{});
 }
@@ -432,7 +521,7 @@ template <typename... Args>
 auto invoker_of(identity<result<Args...>>) {
   return make_invoker(
       [](auto&& callback, auto&& next_callback, auto&&... args) {
-        CONTINUABLE_BLOCK_TRY_BEGIN
+        CONTINUABLE_BLOCK_GUARD_BEGIN
           result<Args...> result =
               invoke_callback(std::forward<decltype(callback)>(callback),
                               std::forward<decltype(args)>(args)...);
@@ -461,7 +550,7 @@ auto invoker_of(identity<result<Args...>>) {
 
         // Otherwise the result is empty and we are cancelling our
         // asynchronous chain.
-        CONTINUABLE_BLOCK_TRY_END
+        CONTINUABLE_BLOCK_GUARD_END
       },
       identity<Args...>{});
 }
@@ -470,7 +559,7 @@ auto invoker_of(identity<result<Args...>>) {
 /// objects where std::get is applicable.
 inline auto sequenced_unpack_invoker() {
   return [](auto&& callback, auto&& next_callback, auto&&... args) {
-    CONTINUABLE_BLOCK_TRY_BEGIN
+    CONTINUABLE_BLOCK_GUARD_BEGIN
       auto result = invoke_callback(std::forward<decltype(callback)>(callback),
                                     std::forward<decltype(args)>(args)...);
 
@@ -484,7 +573,7 @@ inline auto sequenced_unpack_invoker() {
                              std::forward<decltype(values)>(values)...);
           },
           std::move(result));
-    CONTINUABLE_BLOCK_TRY_END
+    CONTINUABLE_BLOCK_GUARD_END
   };
 } // namespace decoration
 
@@ -502,6 +591,8 @@ constexpr auto invoker_of(identity<std::tuple<Args...>>) {
 
 #undef CONTINUABLE_BLOCK_TRY_BEGIN
 #undef CONTINUABLE_BLOCK_TRY_END
+#undef CONTINUABLE_BLOCK_GUARD_BEGIN
+#undef CONTINUABLE_BLOCK_GUARD_END
 } // namespace decoration
 
 /// Invoke the callback immediately
@@ -995,6 +1086,44 @@ auto chain_continuation(Continuation&& continuation, Callback&& callback,
   auto data =
       attorney::consume(std::forward<Continuation>(continuation).finish());
 
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS) ||                                   \
+    defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+  auto timed_callback =
+      statistics::time_callback(std::forward<Callback>(callback));
+  auto timed_executor =
+      statistics::time_executor(std::forward<Executor>(executor));
+#else  // CONTINUABLE_WITH_STAGE_STATISTICS
+  traits::unrefcv_t<Callback> timed_callback(std::forward<Callback>(callback));
+  traits::unrefcv_t<Executor> timed_executor(std::forward<Executor>(executor));
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
+
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+  if (ownership.chain() == 0) {
+    ownership.chain(tracing::make_chain_id());
+  }
+
+  auto traced_executor =
+      tracing::trace_executor(std::move(timed_executor), ownership.chain());
+#else  // CONTINUABLE_WITH_TRACE_HOOKS
+  auto traced_executor = std::move(timed_executor);
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+
+  using continuation_t = chained_continuation<
+      Hint, traits::unrefcv_t<decltype(next_hint)>, HandleResults, HandleErrors,
+      decltype(data), decltype(timed_callback), decltype(traced_executor)>;
+
+  continuation_t chained(std::move(data), std::move(timed_callback),
+                         std::move(traced_executor));
+
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+  return attorney::create_from_raw(
+      tracing::trace_continuation(std::move(chained), ownership.chain()),
+      next_hint, ownership);
+#else  // CONTINUABLE_WITH_TRACE_HOOKS
+  return attorney::create_from_raw(std::move(chained), next_hint, ownership);
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+#else  // CONTINUABLE_WITH_TRACE_HOOKS || CONTINUABLE_WITH_STAGE_STATISTICS
   using continuation_t = chained_continuation<
       Hint, traits::unrefcv_t<decltype(next_hint)>, HandleResults, HandleErrors,
       decltype(data), traits::unrefcv_t<Callback>, traits::unrefcv_t<Executor>>;
@@ -1003,6 +1132,7 @@ auto chain_continuation(Continuation&& continuation, Callback&& callback,
       continuation_t(std::move(data), std::forward<Callback>(callback),
                      std::forward<Executor>(executor)),
       next_hint, ownership);
+#endif // CONTINUABLE_WITH_TRACE_HOOKS || CONTINUABLE_WITH_STAGE_STATISTICS
 }
 
 /// Final invokes the given continuation chain:
@@ -1012,6 +1142,11 @@ auto chain_continuation(Continuation&& continuation, Callback&& callback,
 template <typename Data, typename... Args>
 void finalize_continuation(
     continuable_base<Data, identity<Args...>>&& continuation) noexcept {
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+  tracing::emit(trace_kind::dispatch,
+                attorney::ownership_of(continuation).chain());
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+
 #ifdef CONTINUABLE_WITH_CUSTOM_FINAL_CALLBACK
   invoke_continuation(std::move(continuation),
                       CONTINUABLE_WITH_CUSTOM_FINAL_CALLBACK<Args...>{});
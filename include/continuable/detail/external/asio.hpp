@@ -155,6 +155,44 @@ auto promise_resolver_handler(Promise&& promise, Token&& token) noexcept {
       std::forward<Promise>(promise), std::forward<Token>(token));
 }
 
+// Resolves the promise with the error code as first value instead of
+// converting it to the exception type, which doesn't allocate.
+template <typename Promise, typename Token>
+class error_code_resolver {
+public:
+  explicit error_code_resolver(Promise promise, Token token)
+    : promise_(std::move(promise))
+    , token_(std::move(token)) {}
+
+  template <typename... T>
+  void operator()(T&&... args) noexcept {
+    promise_.set_value(std::forward<T>(args)...);
+  }
+
+  template <typename... T>
+  void operator()(error_code_t e, T&&... args) noexcept {
+    if (e) {
+      if (token_.is_ignored(e)) {
+        e.clear();
+      } else if (token_.is_cancellation(e)) {
+        promise_.set_canceled();
+        return;
+      }
+    }
+    promise_.set_value(std::move(e), std::forward<T>(args)...);
+  }
+
+private:
+  Promise promise_;
+  Token token_;
+};
+
+template <typename Promise, typename Token>
+auto error_code_resolver_handler(Promise&& promise, Token&& token) noexcept {
+  return error_code_resolver<std::decay_t<Promise>, std::decay_t<Token>>(
+      std::forward<Promise>(promise), std::forward<Token>(token));
+}
+
 // Helper struct wrapping a call to `cti::make_continuable` and, if needed,
 // providing an erased, explicit `return_type` for `async_result`.
 template <typename Signature>
@@ -190,6 +228,29 @@ template <typename... Args>
 struct initiate_make_continuable<void(error_code_t const&, Args...)>
   : initiate_make_continuable<void(error_code_t, Args...)> {};
 
+// Creates a continuable which passes the error code as first value
+template <typename Signature>
+struct initiate_make_error_code_continuable
+  : initiate_make_continuable<Signature> {};
+
+template <typename... Args>
+struct initiate_make_error_code_continuable<void(error_code_t, Args...)> {
+#if defined(CTI_DETAIL_ASIO_HAS_EXPLICIT_RET_TYPE_INTEGRATION)
+  using erased_return_type = continuable<error_code_t, Args...>;
+#endif
+
+  template <typename Continuation>
+  auto operator()(Continuation&& continuation) {
+    return base::attorney::create_from(std::forward<Continuation>(continuation),
+                                       identity<error_code_t, Args...>{},
+                                       util::ownership{});
+  }
+};
+
+template <typename... Args>
+struct initiate_make_error_code_continuable<void(error_code_t const&, Args...)>
+  : initiate_make_error_code_continuable<void(error_code_t, Args...)> {};
+
 struct map_default {
   constexpr map_default() noexcept {}
 
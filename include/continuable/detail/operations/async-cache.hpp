@@ -0,0 +1,179 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_ASYNC_CACHE_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_ASYNC_CACHE_HPP_INCLUDED
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <continuable/continuable-result.hpp>
+
+namespace cti {
+namespace detail {
+namespace operations {
+/// The default weigher which only accounts the inline size of an entry
+struct default_weigher {
+  template <typename Key, typename Value>
+  std::size_t operator()(Key const& /*key*/, Value const& /*value*/) const
+      noexcept {
+    return sizeof(Key) + sizeof(Value);
+  }
+};
+
+/// Returns the time point at which an entry inserted at now expires
+template <typename Clock>
+typename Clock::time_point expiry_of(typename Clock::time_point now,
+                                     typename Clock::duration ttl) {
+  if (ttl >= Clock::time_point::max() - now) {
+    return Clock::time_point::max();
+  }
+  return now + ttl;
+}
+
+/// A part of the cache which is protected by its own lock, every shard
+/// maintains its own LRU order and its own part of the memory budget.
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Clock>
+class cache_shard {
+  using time_point = typename Clock::time_point;
+
+  struct entry {
+    Key key;
+    Value value;
+    time_point expiry;
+    std::size_t weight;
+  };
+
+  using list_t = std::list<entry>;
+
+  mutable std::mutex lock_;
+  /// The entries ordered from the most to the least recently used one
+  list_t lru_;
+  std::unordered_map<Key, typename list_t::iterator, Hash, KeyEqual> index_;
+  std::size_t weight_ = 0;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+  std::size_t evictions_ = 0;
+  std::size_t rejections_ = 0;
+
+public:
+  /// Returns a copy of the cached value or an empty result on a miss,
+  /// expired entries are removed lazily here.
+  result<Value> lookup(Key const& key, time_point now) {
+    std::lock_guard<std::mutex> guard(lock_);
+
+    auto itr = index_.find(key);
+    if (itr == index_.end()) {
+      ++misses_;
+      return empty_result{};
+    }
+
+    auto const node = itr->second;
+    if (node->expiry <= now) {
+      remove(itr);
+      ++misses_;
+      return empty_result{};
+    }
+
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, node);
+    return make_result(node->value);
+  }
+
+  template <typename V>
+  void insert(Key const& key, V&& value, time_point expiry, std::size_t weight,
+              std::size_t budget) {
+    std::lock_guard<std::mutex> guard(lock_);
+
+    auto itr = index_.find(key);
+    if (itr != index_.end()) {
+      remove(itr);
+    }
+
+    if (weight > budget) {
+      ++rejections_;
+      return;
+    }
+
+    while (!lru_.empty() && (weight_ + weight > budget)) {
+      remove(index_.find(lru_.back().key));
+      ++evictions_;
+    }
+
+    lru_.push_front(entry{key, std::forward<V>(value), expiry, weight});
+    index_.emplace(key, lru_.begin());
+    weight_ += weight;
+  }
+
+  bool erase(Key const& key) {
+    std::lock_guard<std::mutex> guard(lock_);
+
+    auto itr = index_.find(key);
+    if (itr == index_.end()) {
+      return false;
+    }
+    remove(itr);
+    return true;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> guard(lock_);
+    index_.clear();
+    lru_.clear();
+    weight_ = 0;
+  }
+
+  template <typename Stats>
+  void accumulate(Stats& stats) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    stats.hits += hits_;
+    stats.misses += misses_;
+    stats.evictions += evictions_;
+    stats.rejections += rejections_;
+    stats.size += index_.size();
+    stats.weight += weight_;
+  }
+
+private:
+  template <typename Iterator>
+  void remove(Iterator itr) {
+    weight_ -= itr->second->weight;
+    lru_.erase(itr->second);
+    index_.erase(itr);
+  }
+};
+} // namespace operations
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_ASYNC_CACHE_HPP_INCLUDED
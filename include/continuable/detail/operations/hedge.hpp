@@ -0,0 +1,255 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_HEDGE_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_HEDGE_HPP_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/detail/connection/connection-any.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/operations/retry.hpp>
+#include <continuable/detail/utility/identity.hpp>
+#include <continuable/detail/utility/traits.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+#include <exception>
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+namespace cti {
+namespace detail {
+namespace operations {
+/// Holds the state of a hedged operation over all its attempts.
+///
+/// The first successful attempt resolves the promise through the first
+/// wins logic of the any connection, the results of the other attempts
+/// are dropped.
+template <typename Promise, typename Timer, typename Factory>
+class hedge_frame : public std::enable_shared_from_this<
+                        hedge_frame<Promise, Timer, Factory>> {
+  connection::any::first_result<Promise> result_;
+  std::chrono::nanoseconds delay_;
+  std::size_t max_attempts_;
+  Timer timer_;
+  Factory factory_;
+
+  std::mutex lock_;
+  std::size_t launched_ = 0;
+  std::size_t running_ = 0;
+  bool timer_pending_ = false;
+  bool resolved_ = false;
+  exception_t last_;
+
+public:
+  explicit hedge_frame(Promise promise, std::chrono::nanoseconds delay,
+                       std::size_t max_attempts, Timer timer, Factory factory)
+      : result_(std::move(promise)), delay_(delay),
+        max_attempts_(max_attempts), timer_(std::move(timer)),
+        factory_(std::move(factory)) {
+  }
+
+  /// Starts the next attempt unless the operation was resolved
+  /// or no attempts are left.
+  void launch() {
+    bool arm = false;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (!reserve(arm)) {
+        return;
+      }
+    }
+    start(arm);
+  }
+
+  template <typename... Args>
+  void resolve(Args&&... args) {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      --running_;
+      if (resolved_) {
+        return;
+      }
+      resolved_ = true;
+    }
+    result_(std::forward<Args>(args)...);
+  }
+
+  void resolve(exception_arg_t, exception_t exception) {
+    bool arm = false;
+    bool hedged = false;
+    bool exhausted = false;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      --running_;
+      if (resolved_) {
+        return;
+      }
+
+      // A failed attempt is hedged immediately,
+      // a cancelled one waits for the pending timer.
+      bool const is_error = bool(exception);
+      if (is_error || !last_) {
+        last_ = std::move(exception);
+      }
+      if (is_error) {
+        hedged = reserve(arm);
+      }
+      if (!hedged) {
+        exhausted = fail_if_exhausted();
+      }
+    }
+
+    if (hedged) {
+      start(arm);
+    } else if (exhausted) {
+      fail();
+    }
+  }
+
+private:
+  /// Is invoked when the hedging delay has elapsed
+  void wake() {
+    bool arm = false;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      timer_pending_ = false;
+      if (!reserve(arm)) {
+        return;
+      }
+    }
+    start(arm);
+  }
+  /// Is invoked when the timer was cancelled or failed,
+  /// no further attempts are started in this case.
+  void wake(exception_arg_t, exception_t /*timer*/) {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      timer_pending_ = false;
+      max_attempts_ = launched_;
+      if (resolved_ || !fail_if_exhausted()) {
+        return;
+      }
+    }
+    fail();
+  }
+
+  /// Reserves the next attempt and decides whether the timer for the
+  /// attempt after it is armed, must be called while the lock is held.
+  bool reserve(bool& arm) noexcept {
+    if (resolved_ || (launched_ == max_attempts_)) {
+      return false;
+    }
+    ++launched_;
+    ++running_;
+
+    // Only a single timer is pending at any time
+    arm = !timer_pending_ && (launched_ != max_attempts_);
+    timer_pending_ = timer_pending_ || arm;
+    return true;
+  }
+
+  /// Starts the reserved attempt and the timer if it was armed
+  void start(bool arm) {
+    if (arm) {
+      util::invoke(timer_, delay_)
+          .next([me = this->shared_from_this()](auto&&... args) {
+            me->wake(std::forward<decltype(args)>(args)...);
+          });
+    }
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    try {
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+      util::invoke(factory_).next(
+          [me = this->shared_from_this()](auto&&... args) {
+            me->resolve(std::forward<decltype(args)>(args)...);
+          });
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    } catch (...) {
+      resolve(exception_arg_t{}, std::current_exception());
+    }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+  }
+
+  /// Marks the operation as resolved if no attempt is running and none
+  /// will be started anymore, must be called while the lock is held.
+  bool fail_if_exhausted() noexcept {
+    if ((running_ != 0U) ||
+        ((launched_ != max_attempts_) && timer_pending_)) {
+      return false;
+    }
+    resolved_ = true;
+    return true;
+  }
+
+  /// Propagates the last error, which is a cancellation if no attempt
+  /// failed with an error.
+  void fail() {
+    result_(exception_arg_t{}, std::move(last_));
+  }
+};
+
+template <typename Timer, typename Factory>
+auto hedge(std::chrono::nanoseconds delay, Timer&& timer, Factory&& factory,
+           std::size_t max_attempts) {
+  using invocation_result_t = decltype(util::invoke(factory).finish());
+
+  auto constexpr hint = base::annotation_of(identify<invocation_result_t>{});
+
+  using trait_t = retry_trait<std::remove_const_t<decltype(hint)>>;
+
+  return trait_t::make([delay, max_attempts,
+                        timer = std::forward<Timer>(timer),
+                        factory = std::forward<Factory>(factory)](
+                           auto&& promise) mutable {
+    using frame_t = hedge_frame<traits::unrefcv_t<decltype(promise)>,
+                                traits::unrefcv_t<Timer>,
+                                traits::unrefcv_t<Factory>>;
+
+    auto frame = std::make_shared<frame_t>(
+        std::forward<decltype(promise)>(promise), delay,
+        max_attempts ? max_attempts : 1U, std::move(timer),
+        std::move(factory));
+    frame->launch();
+  });
+}
+} // namespace operations
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_HEDGE_HPP_INCLUDED
@@ -0,0 +1,482 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_PARALLEL_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_PARALLEL_HPP_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/traits.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+namespace cti {
+namespace detail {
+namespace operations {
+namespace parallel {
+/// Returns the count of elements a single chunk covers.
+///
+/// The range is split into a few chunks per hardware thread,
+/// such that chunks of uneven cost are balanced by the executor,
+/// but a chunk never covers less elements than the given grain.
+inline std::size_t chunk_size_of(std::size_t size, std::size_t grain) noexcept {
+  // Querying the hardware threads reads from sysfs on some platforms
+  static std::size_t const threads =
+      std::max(std::thread::hardware_concurrency(), 1U);
+  std::size_t const target = threads * 4U;
+  std::size_t const balanced = (size / target) + ((size % target) != 0U);
+  return std::max({grain, balanced, std::size_t(1U)});
+}
+
+/// Returns the count of chunks a range of the given size is split into
+inline std::size_t chunks_of(std::size_t size, std::size_t chunk) noexcept {
+  return (size / chunk) + ((size % chunk) != 0U);
+}
+
+/// The shared state of all chunks of a bulk operation.
+///
+/// The frame is owned by the chunks which are outstanding and by the
+/// submission, the last owner resolves the promise and destroys the frame.
+template <typename Promise, typename Body>
+class bulk_frame {
+public:
+  bulk_frame(Promise promise, Body body, std::size_t chunks)
+      : pending_(chunks), promise_(std::move(promise)), body_(std::move(body)) {
+  }
+
+  /// Processes the elements [begin, end) unless a chunk failed already
+  void run(std::size_t begin, std::size_t end) noexcept {
+    if (state_.load(std::memory_order_relaxed) == state::ok) {
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+      try {
+        body_(begin, end);
+      } catch (...) {
+        record(std::current_exception());
+      }
+#else  // CONTINUABLE_HAS_EXCEPTIONS
+      body_(begin, end);
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+    }
+    complete();
+  }
+
+  /// Fails the bulk operation, the first exception wins
+  void fail(exception_t exception) noexcept {
+    record(std::move(exception));
+    complete();
+  }
+
+  /// Fails the given count of chunks at once
+  void fail(exception_t exception, std::size_t chunks) noexcept {
+    record(std::move(exception));
+    complete(chunks);
+  }
+
+  /// Completes the given count of chunks which succeeded
+  void complete(std::size_t chunks = 1U) noexcept {
+    if (pending_.fetch_sub(chunks, std::memory_order_acq_rel) != chunks) {
+      return;
+    }
+
+    if (state_.load(std::memory_order_relaxed) != state::ok) {
+      promise_.set_exception(std::move(exception_));
+    } else {
+      std::move(body_).finish(std::move(promise_));
+    }
+    delete this;
+  }
+
+private:
+  enum class state { ok, canceled, recording, failed };
+
+  /// Records the failure, the first exception wins over cancellations
+  /// which never write the exception.
+  void record(exception_t exception) noexcept {
+    state expected = state::ok;
+    if (!exception) {
+      state_.compare_exchange_strong(expected, state::canceled,
+                                     std::memory_order_relaxed);
+      return;
+    }
+
+    if (!state_.compare_exchange_strong(expected, state::recording,
+                                        std::memory_order_relaxed)) {
+      expected = state::canceled;
+      if (!state_.compare_exchange_strong(expected, state::recording,
+                                          std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    exception_ = std::move(exception);
+    state_.store(state::failed, std::memory_order_relaxed);
+  }
+
+  std::atomic<std::size_t> pending_;
+  std::atomic<state> state_{state::ok};
+  exception_t exception_;
+  Promise promise_;
+  Body body_;
+};
+
+/// The work which is submitted to the executor for a single chunk.
+///
+/// A chunk which is destroyed without being invoked
+/// cancels the bulk operation.
+template <typename Frame>
+class bulk_chunk {
+public:
+  bulk_chunk(Frame* frame, std::size_t begin, std::size_t end) noexcept
+      : frame_(frame), begin_(begin), end_(end) {
+  }
+  ~bulk_chunk() {
+    if (frame_) {
+      frame_->fail(exception_t{});
+    }
+  }
+
+  bulk_chunk(bulk_chunk&& other) noexcept
+      : frame_(std::exchange(other.frame_, nullptr)), begin_(other.begin_),
+        end_(other.end_) {
+  }
+  bulk_chunk(bulk_chunk const&) = delete;
+  bulk_chunk& operator=(bulk_chunk&&) = delete;
+  bulk_chunk& operator=(bulk_chunk const&) = delete;
+
+  void operator()() && noexcept {
+    std::exchange(frame_, nullptr)->run(begin_, end_);
+  }
+
+  void operator()(exception_arg_t, exception_t exception) && noexcept {
+    std::exchange(frame_, nullptr)->fail(std::move(exception));
+  }
+
+private:
+  Frame* frame_;
+  std::size_t begin_;
+  std::size_t end_;
+};
+
+/// Invokes the function for every element of a chunk
+template <typename Iterator, typename Function>
+struct for_each_body {
+  Iterator first;
+  Function function;
+
+  void operator()(std::size_t begin, std::size_t end) {
+    auto current = std::next(first, begin);
+    for (std::size_t i = begin; i != end; ++i, ++current) {
+      util::invoke(function, *current);
+    }
+  }
+
+  template <typename Promise>
+  void finish(Promise&& promise) && {
+    std::forward<Promise>(promise).set_value();
+  }
+};
+
+/// Writes the result of the function for every element of a chunk
+/// to the element at the same position of the output
+template <typename InputIterator, typename OutputIterator, typename Function>
+struct transform_body {
+  InputIterator input;
+  OutputIterator output;
+  Function function;
+
+  void operator()(std::size_t begin, std::size_t end) {
+    auto current = std::next(input, begin);
+    auto target = std::next(output, begin);
+    for (std::size_t i = begin; i != end; ++i, ++current, ++target) {
+      *target = util::invoke(function, *current);
+    }
+  }
+
+  template <typename Promise>
+  void finish(Promise&& promise) && {
+    std::forward<Promise>(promise).set_value();
+  }
+};
+
+/// A partial result of a reduction which is published to the parent
+/// node in the combining tree.
+template <typename T>
+class reduce_node {
+public:
+  reduce_node() = default;
+  ~reduce_node() {
+    if (has_value_) {
+      get().~T();
+    }
+  }
+
+  reduce_node(reduce_node const&) = delete;
+  reduce_node& operator=(reduce_node const&) = delete;
+
+  void put(T value) {
+    new (&storage_) T(std::move(value));
+    has_value_ = true;
+  }
+
+  T take() {
+    T value(std::move(get()));
+    get().~T();
+    has_value_ = false;
+    return value;
+  }
+
+  bool has_value() const noexcept {
+    return has_value_;
+  }
+
+  /// Returns true if this is the second child that arrives at the node
+  bool arrive() noexcept {
+    return arrived_.exchange(true, std::memory_order_acq_rel);
+  }
+
+private:
+  T& get() noexcept {
+    return *reinterpret_cast<T*>(&storage_);
+  }
+
+  std::aligned_storage_t<sizeof(T), alignof(T)> storage_;
+  bool has_value_ = false;
+  std::atomic<bool> arrived_{false};
+};
+
+/// Folds every chunk and combines the partial results of neighbouring
+/// chunks in a binary tree as soon as both of them are available.
+///
+/// The tree is laid out as a heap over the chunks [0, chunks),
+/// where the node i covers the chunks of its children 2i and 2i + 1.
+/// The left partial is always passed first to the operation, therefore
+/// the operation is only required to be associative.
+template <typename Iterator, typename T, typename Operation>
+class reduce_body {
+public:
+  reduce_body(Iterator first, T init, Operation operation, std::size_t chunk,
+              std::size_t chunks)
+      : first_(std::move(first)), init_(std::move(init)),
+        operation_(std::move(operation)), chunk_(chunk), chunks_(chunks),
+        nodes_(chunks ? new reduce_node<T>[chunks * 4U] : nullptr) {
+  }
+
+  void operator()(std::size_t begin, std::size_t end) {
+    auto current = std::next(first_, begin);
+    T value(*current);
+    for (std::size_t i = begin + 1U; i != end; ++i) {
+      value = util::invoke(operation_, std::move(value), *++current);
+    }
+
+    combine(leaf_of(begin / chunk_), std::move(value));
+  }
+
+  template <typename Promise>
+  void finish(Promise&& promise) && {
+    if (!nodes_ || !nodes_[1U].has_value()) {
+      std::forward<Promise>(promise).set_value(std::move(init_));
+      return;
+    }
+
+    // The root node is reused to store the result
+    auto& root = nodes_[1U];
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    try {
+      root.put(util::invoke(operation_, std::move(init_), root.take()));
+    } catch (...) {
+      std::forward<Promise>(promise).set_exception(std::current_exception());
+      return;
+    }
+#else  // CONTINUABLE_HAS_EXCEPTIONS
+    root.put(util::invoke(operation_, std::move(init_), root.take()));
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+    std::forward<Promise>(promise).set_value(root.take());
+  }
+
+private:
+  /// Returns the node of the chunk with the given index
+  std::size_t leaf_of(std::size_t index) const noexcept {
+    std::size_t node = 1U;
+    std::size_t low = 0U;
+    std::size_t high = chunks_;
+    while ((high - low) > 1U) {
+      std::size_t const mid = low + ((high - low) / 2U);
+      if (index < mid) {
+        node = node * 2U;
+        high = mid;
+      } else {
+        node = node * 2U + 1U;
+        low = mid;
+      }
+    }
+    return node;
+  }
+
+  /// Publishes the partial of the given node and combines it with its
+  /// sibling for as long as we are the second child arriving at the parent.
+  void combine(std::size_t node, T value) {
+    while (node != 1U) {
+      nodes_[node].put(std::move(value));
+
+      std::size_t const parent = node / 2U;
+      if (!nodes_[parent].arrive()) {
+        return;
+      }
+
+      value = util::invoke(operation_, nodes_[parent * 2U].take(),
+                           nodes_[parent * 2U + 1U].take());
+      node = parent;
+    }
+    nodes_[1U].put(std::move(value));
+  }
+
+  Iterator first_;
+  T init_;
+  Operation operation_;
+  std::size_t chunk_;
+  std::size_t chunks_;
+  std::unique_ptr<reduce_node<T>[]> nodes_;
+};
+
+/// Splits the elements [0, size) into chunks of the given size which are
+/// processed through the given body, every chunk is submitted to the
+/// executor as single work.
+template <typename... Args, typename Executor, typename Body>
+auto bulk(Executor&& executor, std::size_t size, std::size_t chunk,
+          Body&& body) {
+  return make_continuable<Args...>(
+      [executor = std::forward<Executor>(executor), size, chunk,
+       body = std::forward<Body>(body)](auto&& promise) mutable {
+        using promise_t = traits::unrefcv_t<decltype(promise)>;
+        using frame_t = bulk_frame<promise_t, std::decay_t<Body>>;
+
+        std::size_t const chunks = chunks_of(size, chunk);
+        if (chunks == 0U) {
+          std::move(body).finish(std::forward<decltype(promise)>(promise));
+          return;
+        }
+
+        // The submission holds an additional count of the frame, such that
+        // the frame is still alive when the executor throws.
+        auto* frame = new frame_t(std::forward<decltype(promise)>(promise),
+                                  std::move(body), chunks + 1U);
+
+        std::size_t submitted = 0U;
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+        try {
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+          for (std::size_t begin = 0U; begin != size; ++submitted) {
+            std::size_t const end = begin + std::min(chunk, size - begin);
+            executor(bulk_chunk<frame_t>(frame, begin, end));
+            begin = end;
+          }
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+        } catch (...) {
+          // The chunk which was passed to the throwing executor completes
+          // itself when it is destroyed, the chunks which were never
+          // submitted are completed together with the submission.
+          frame->fail(std::current_exception(), chunks - submitted);
+          return;
+        }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+        frame->complete();
+      });
+}
+
+template <typename Range>
+std::size_t size_of(Range&& range) {
+  using std::begin;
+  using std::end;
+  return static_cast<std::size_t>(std::distance(begin(range), end(range)));
+}
+
+template <typename Executor, typename Range, typename Function>
+auto parallel_for(Executor&& executor, Range&& range, std::size_t grain,
+                  Function&& function) {
+  using std::begin;
+  using body_t = for_each_body<decltype(begin(range)), std::decay_t<Function>>;
+
+  std::size_t const size = size_of(range);
+  return bulk<void>(std::forward<Executor>(executor), size,
+                    chunk_size_of(size, grain),
+                    body_t{begin(range), std::forward<Function>(function)});
+}
+
+template <typename Executor, typename InputRange, typename OutputRange,
+          typename Function>
+auto parallel_transform(Executor&& executor, InputRange&& input,
+                        OutputRange&& output, std::size_t grain,
+                        Function&& function) {
+  using std::begin;
+  using body_t = transform_body<decltype(begin(input)), decltype(begin(output)),
+                                std::decay_t<Function>>;
+
+  std::size_t const size = size_of(input);
+  assert((size_of(output) >= size) &&
+         "The output range is smaller than the input range!");
+
+  return bulk<void>(
+      std::forward<Executor>(executor), size, chunk_size_of(size, grain),
+      body_t{begin(input), begin(output), std::forward<Function>(function)});
+}
+
+template <typename Executor, typename Range, typename T, typename Operation>
+auto parallel_reduce(Executor&& executor, Range&& range, T&& init,
+                     Operation&& operation, std::size_t grain) {
+  using std::begin;
+  using value_t = std::decay_t<T>;
+  using body_t = reduce_body<decltype(begin(range)), value_t,
+                             std::decay_t<Operation>>;
+
+  std::size_t const size = size_of(range);
+  std::size_t const chunk = chunk_size_of(size, grain);
+  return bulk<value_t>(
+      std::forward<Executor>(executor), size, chunk,
+      body_t(begin(range), std::forward<T>(init),
+             std::forward<Operation>(operation), chunk, chunks_of(size, chunk)));
+}
+} // namespace parallel
+} // namespace operations
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_PARALLEL_HPP_INCLUDED
@@ -0,0 +1,222 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_RETRY_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_RETRY_HPP_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/identity.hpp>
+#include <continuable/detail/utility/traits.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+#include <exception>
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+namespace cti {
+namespace detail {
+template <typename T>
+struct retry_trait {
+  static_assert(!std::is_same<T, T>::value,
+                "The factory passed to cti::retry must always return a "
+                "cti::continuable_base.");
+};
+template <typename... Args>
+struct retry_trait<identity<Args...>> {
+  template <typename Callable>
+  static auto make(Callable&& callable) {
+    return make_continuable<Args...>(std::forward<Callable>(callable));
+  }
+};
+template <>
+struct retry_trait<identity<>> {
+  template <typename Callable>
+  static auto make(Callable&& callable) {
+    return make_continuable<void>(std::forward<Callable>(callable));
+  }
+};
+
+namespace operations {
+/// Holds the state of a retried operation over all its attempts, such that
+/// subsequent attempts don't need to allocate a new frame.
+template <typename Promise, typename Policy, typename Timer, typename Factory>
+class retry_frame : public std::enable_shared_from_this<
+                        retry_frame<Promise, Policy, Timer, Factory>> {
+  using clock = std::chrono::steady_clock;
+
+  Promise promise_;
+  Policy policy_;
+  Timer timer_;
+  Factory factory_;
+  std::size_t attempt_ = 0;
+  std::chrono::nanoseconds backoff_;
+  clock::time_point deadline_;
+  std::minstd_rand engine_;
+
+public:
+  explicit retry_frame(Promise promise, Policy policy, Timer timer,
+                       Factory factory)
+      : promise_(std::move(promise)), policy_(std::move(policy)),
+        timer_(std::move(timer)), factory_(std::move(factory)),
+        backoff_(policy_.initial_delay),
+        deadline_(deadline_of(clock::now(), policy_.deadline)),
+        engine_(static_cast<std::minstd_rand::result_type>(
+            clock::now().time_since_epoch().count())) {
+  }
+
+  void attempt() {
+    ++attempt_;
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    try {
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+      util::invoke(factory_).next(
+          [me = this->shared_from_this()](auto&&... args) {
+            me->resolve(std::forward<decltype(args)>(args)...);
+          });
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    } catch (...) {
+      resolve(exception_arg_t{}, std::current_exception());
+    }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+  }
+
+  template <typename... Args>
+  void resolve(Args&&... args) {
+    std::move(promise_).set_value(std::forward<Args>(args)...);
+  }
+
+  void resolve(exception_arg_t, exception_t exception) {
+    if (!exception) {
+      // Cancellations are never retried
+      std::move(promise_).set_canceled();
+      return;
+    }
+
+    if (attempt_ >= policy_.max_attempts) {
+      std::move(promise_).set_exception(std::move(exception));
+      return;
+    }
+
+    auto const delay = next_delay();
+    if ((deadline_ - clock::now()) <= delay) {
+      std::move(promise_).set_exception(std::move(exception));
+      return;
+    }
+
+    util::invoke(timer_, delay)
+        .next([me = this->shared_from_this(),
+               exception = std::move(exception)](auto&&... args) mutable {
+          me->wake(std::move(exception),
+                   std::forward<decltype(args)>(args)...);
+        });
+  }
+
+private:
+  /// Is invoked when the backoff delay has elapsed
+  void wake(exception_t /*last*/) {
+    attempt();
+  }
+  /// Is invoked when the timer was cancelled or failed,
+  /// the last error of the operation is propagated in this case.
+  void wake(exception_t last, exception_arg_t, exception_t /*timer*/) {
+    std::move(promise_).set_exception(std::move(last));
+  }
+
+  /// Returns the jittered delay before the next attempt and increases
+  /// the exponential backoff for the attempt after.
+  std::chrono::nanoseconds next_delay() {
+    auto const current = backoff_;
+
+    double const next = static_cast<double>(backoff_.count()) *
+                        policy_.multiplier;
+    double const limit = static_cast<double>(policy_.max_delay.count());
+    backoff_ = (next >= limit) ? policy_.max_delay
+                               : std::chrono::nanoseconds(
+                                     static_cast<std::int64_t>(next));
+
+    if (policy_.jitter <= 0.0) {
+      return current;
+    }
+
+    std::uniform_real_distribution<double> distribution(
+        1.0 - std::min(policy_.jitter, 1.0), 1.0);
+    return std::chrono::nanoseconds(static_cast<std::int64_t>(
+        static_cast<double>(current.count()) * distribution(engine_)));
+  }
+
+  static clock::time_point deadline_of(clock::time_point now,
+                                       std::chrono::nanoseconds deadline) {
+    if (deadline >= (clock::time_point::max() - now)) {
+      return clock::time_point::max();
+    }
+    return now + std::chrono::duration_cast<clock::duration>(deadline);
+  }
+};
+
+template <typename Policy, typename Timer, typename Factory>
+auto retry(Policy&& policy, Timer&& timer, Factory&& factory) {
+  using invocation_result_t = decltype(util::invoke(factory).finish());
+
+  auto constexpr hint = base::annotation_of(identify<invocation_result_t>{});
+
+  using trait_t = retry_trait<std::remove_const_t<decltype(hint)>>;
+
+  return trait_t::make([policy = std::forward<Policy>(policy),
+                        timer = std::forward<Timer>(timer),
+                        factory = std::forward<Factory>(factory)](
+                           auto&& promise) mutable {
+    using frame_t =
+        retry_frame<traits::unrefcv_t<decltype(promise)>,
+                    traits::unrefcv_t<Policy>, traits::unrefcv_t<Timer>,
+                    traits::unrefcv_t<Factory>>;
+
+    auto frame = std::make_shared<frame_t>(
+        std::forward<decltype(promise)>(promise), std::move(policy),
+        std::move(timer), std::move(factory));
+    frame->attempt();
+  });
+}
+} // namespace operations
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_RETRY_HPP_INCLUDED
@@ -0,0 +1,235 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_RUN_LOOP_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_RUN_LOOP_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace cti {
+class run_loop;
+
+namespace detail {
+namespace event_loop {
+using clock = std::chrono::steady_clock;
+
+/// Returns the run_loop which is run by the current thread
+inline run_loop*& this_loop() noexcept {
+  static thread_local run_loop* current = nullptr;
+  return current;
+}
+
+/// Marks the current thread as running the given loop while it is alive
+class running_scope {
+public:
+  explicit running_scope(run_loop* loop) noexcept : previous_(this_loop()) {
+    this_loop() = loop;
+  }
+  ~running_scope() {
+    this_loop() = previous_;
+  }
+
+  running_scope(running_scope const&) = delete;
+  running_scope& operator=(running_scope const&) = delete;
+
+private:
+  run_loop* previous_;
+};
+
+/// The assumed size of a cache line which separates the head of the
+/// inbox written by the producers from the data of the consumer.
+constexpr std::size_t cache_line_size = 64U;
+
+/// A work which is linked into the inbox of a run_loop
+struct node : metrics::stamp {
+  explicit node(work current) : item(std::move(current)) {
+    mark();
+  }
+
+  node* next = nullptr;
+  work item;
+};
+
+/// A lock-free queue of nodes which is written by many threads and
+/// drained by a single thread.
+///
+/// The producers push the nodes onto an intrusive stack, the consumer
+/// takes the whole stack at once and reverses it into a batch
+/// in submission order.
+class inbox {
+public:
+  /// Links the node into the inbox
+  void push(node* item) noexcept {
+    node* head = head_.value.load(std::memory_order_relaxed);
+    do {
+      item->next = head;
+    } while (!head_.value.compare_exchange_weak(head, item,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+  }
+
+  /// Takes all nodes out of the inbox in the order they were pushed,
+  /// may only be called from the consuming thread.
+  node* take_all() noexcept {
+    if (head_.value.load(std::memory_order_relaxed) == nullptr) {
+      return nullptr;
+    }
+
+    node* current = head_.value.exchange(nullptr, std::memory_order_acquire);
+    node* batch = nullptr;
+    while (current) {
+      node* next = current->next;
+      current->next = batch;
+      batch = current;
+      current = next;
+    }
+    return batch;
+  }
+
+  /// Returns true if the inbox contains nodes
+  bool has_work() const noexcept {
+    return head_.value.load(std::memory_order_seq_cst) != nullptr;
+  }
+
+private:
+  struct padded_head {
+    std::atomic<node*> value{nullptr};
+    char padding[cache_line_size - sizeof(std::atomic<node*>)];
+  };
+
+  padded_head head_;
+};
+
+/// Blocks the consuming thread of a run_loop until it is signaled.
+///
+/// An eventfd is used on Linux, other platforms and a failure to create
+/// the eventfd fall back to a condition variable.
+class wakeup {
+public:
+  wakeup() noexcept {
+#if defined(__linux__)
+    fd_ = ::eventfd(0, EFD_CLOEXEC);
+#endif
+  }
+
+  ~wakeup() {
+#if defined(__linux__)
+    if (fd_ != -1) {
+      ::close(fd_);
+    }
+#endif
+  }
+
+  wakeup(wakeup const&) = delete;
+  wakeup& operator=(wakeup const&) = delete;
+
+  /// Wakes the thread which waits or the next thread which will wait
+  void signal() noexcept {
+#if defined(__linux__)
+    if (fd_ != -1) {
+      std::uint64_t const one = 1U;
+      ssize_t written;
+      do {
+        written = ::write(fd_, &one, sizeof(one));
+      } while ((written == -1) && (errno == EINTR));
+      return;
+    }
+#endif
+    std::lock_guard<std::mutex> guard(lock_);
+    signaled_ = true;
+    condition_.notify_one();
+  }
+
+  /// Waits until the wakeup was signaled or the deadline was reached
+  void wait_until(clock::time_point deadline) noexcept {
+#if defined(__linux__)
+    if (fd_ != -1) {
+      pollfd descriptor{fd_, POLLIN, 0};
+      if (deadline == clock::time_point::max()) {
+        (void)::poll(&descriptor, 1, -1);
+      } else {
+        auto const remaining =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                deadline - clock::now());
+        if (remaining.count() <= 0) {
+          return;
+        }
+        timespec timeout;
+        timeout.tv_sec = static_cast<std::time_t>(remaining.count() /
+                                                  1000000000);
+        timeout.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+        (void)::ppoll(&descriptor, 1, &timeout, nullptr);
+      }
+
+      if (descriptor.revents & POLLIN) {
+        std::uint64_t count;
+        (void)::read(fd_, &count, sizeof(count));
+      }
+      return;
+    }
+#endif
+    std::unique_lock<std::mutex> guard(lock_);
+    if (deadline == clock::time_point::max()) {
+      condition_.wait(guard, [&] { return signaled_; });
+    } else {
+      condition_.wait_until(guard, deadline, [&] { return signaled_; });
+    }
+    signaled_ = false;
+  }
+
+private:
+#if defined(__linux__)
+  int fd_ = -1;
+#endif
+  std::mutex lock_;
+  std::condition_variable condition_;
+  bool signaled_ = false;
+};
+} // namespace event_loop
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_RUN_LOOP_HPP_INCLUDED
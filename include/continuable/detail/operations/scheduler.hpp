@@ -0,0 +1,131 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_SCHEDULER_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_SCHEDULER_HPP_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+
+namespace cti {
+namespace detail {
+namespace scheduling {
+using clock = std::chrono::steady_clock;
+
+enum class priority : unsigned char { interactive, normal, batch };
+
+/// The scheduling class or deadline a chain was tagged with
+struct context {
+  enum class kind : unsigned char { none, priority, deadline };
+
+  kind type;
+  scheduling::priority level;
+  clock::time_point deadline;
+
+  static context none() noexcept {
+    return {kind::none, priority::normal, clock::time_point{}};
+  }
+  static context of(scheduling::priority level) noexcept {
+    return {kind::priority, level, clock::time_point{}};
+  }
+  static context until(clock::time_point deadline) noexcept {
+    return {kind::deadline, priority::normal, deadline};
+  }
+};
+
+/// Returns the context of the work which runs on the current thread
+inline context& current_context() noexcept {
+  static thread_local context current = context::none();
+  return current;
+}
+
+/// Replaces the context of the current thread for the lifetime of the guard
+class context_guard {
+public:
+  explicit context_guard(context const& next) noexcept
+      : previous_(current_context()) {
+    current_context() = next;
+  }
+  ~context_guard() {
+    current_context() = previous_;
+  }
+
+  context_guard(context_guard const&) = delete;
+  context_guard& operator=(context_guard const&) = delete;
+
+private:
+  context previous_;
+};
+
+/// Resumes the chain on the current thread with the given context,
+/// such that the context is inherited by the work the chain submits next.
+struct context_executor {
+  context tagged;
+
+  template <typename Work>
+  void operator()(Work&& work) const {
+    context_guard guard(tagged);
+    std::forward<Work>(work)();
+  }
+};
+
+/// A work which is queued until its deadline is the earliest one
+struct entry : metrics::stamp {
+  entry(clock::time_point until, std::uint64_t order, context tag,
+        work current)
+      : deadline(until), sequence(order), tagged(tag),
+        item(std::move(current)) {
+    mark();
+  }
+
+  clock::time_point deadline;
+  std::uint64_t sequence;
+  context tagged;
+  work item;
+};
+
+/// Orders the entries as heap with the earliest deadline on top,
+/// entries with the same deadline are ordered by their submission.
+struct later_deadline {
+  bool operator()(entry const& left, entry const& right) const noexcept {
+    if (left.deadline != right.deadline) {
+      return left.deadline > right.deadline;
+    }
+    return left.sequence > right.sequence;
+  }
+};
+} // namespace scheduling
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_SCHEDULER_HPP_INCLUDED
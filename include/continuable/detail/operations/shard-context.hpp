@@ -0,0 +1,83 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_SHARD_CONTEXT_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_SHARD_CONTEXT_HPP_INCLUDED
+
+#include <cstddef>
+#include <utility>
+#include <continuable/continuable-types.hpp>
+
+namespace cti {
+namespace shard {
+class runtime;
+} // namespace shard
+
+namespace detail {
+namespace shard {
+/// The runtime and core the current thread belongs to
+struct current_core {
+  cti::shard::runtime* owner;
+  std::size_t index;
+  /// Posts work to a core of the owner, which makes it possible to
+  /// resume on the core without depending on the runtime itself.
+  void (*post)(cti::shard::runtime* owner, std::size_t index, work item);
+};
+
+inline current_core& this_core() noexcept {
+  static thread_local current_core current{nullptr, 0U, nullptr};
+  return current;
+}
+
+/// An executor which continues on the core the current thread belonged to
+/// when the executor was created, or on the invoking thread when the thread
+/// didn't belong to a runtime.
+class resume_executor {
+public:
+  resume_executor() noexcept : core_(this_core()) {
+  }
+
+  template <typename Work>
+  void operator()(Work&& item) const {
+    if (core_.owner) {
+      core_.post(core_.owner, core_.index, work(std::forward<Work>(item)));
+    } else {
+      std::forward<Work>(item)();
+    }
+  }
+
+private:
+  current_core core_;
+};
+} // namespace shard
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_SHARD_CONTEXT_HPP_INCLUDED
@@ -0,0 +1,188 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_SHARD_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_SHARD_HPP_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/operations/shard-context.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cti {
+namespace detail {
+namespace shard {
+/// The assumed size of a cache line which separates the data
+/// written by the producer from the data written by the consumer.
+constexpr std::size_t cache_line_size = 64U;
+
+/// The count of work a mailbox between two cores buffers
+constexpr std::size_t mailbox_capacity = 256U;
+
+/// The count of work which is taken from a single queue in a row
+constexpr std::size_t batch_size = 64U;
+
+/// The work which is queued on a core
+using queued_work = metrics::stamped_work;
+
+/// A bounded ring buffer of work which is written by a single core
+/// and read by a single other core.
+class mailbox {
+public:
+  mailbox() : slots_(new queued_work[mailbox_capacity]) {
+  }
+
+  /// Moves the work into the mailbox unless it is full,
+  /// may only be called from the producing core.
+  bool try_push(queued_work& item) noexcept {
+    std::size_t const tail = producer_.tail.load(std::memory_order_relaxed);
+    if ((tail - producer_.head) == mailbox_capacity) {
+      producer_.head = consumer_.head.load(std::memory_order_acquire);
+      if ((tail - producer_.head) == mailbox_capacity) {
+        return false;
+      }
+    }
+
+    slots_[tail % mailbox_capacity] = std::move(item);
+    producer_.tail.store(tail + 1U, std::memory_order_release);
+    return true;
+  }
+
+  /// Moves the oldest work out of the mailbox unless it is empty,
+  /// may only be called from the consuming core.
+  bool try_pop(queued_work& item) noexcept {
+    std::size_t const head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.tail) {
+      consumer_.tail = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.tail) {
+        return false;
+      }
+    }
+
+    item = std::move(slots_[head % mailbox_capacity]);
+    consumer_.head.store(head + 1U, std::memory_order_release);
+    return true;
+  }
+
+  /// Returns true if the mailbox contains work,
+  /// may only be called from the consuming core.
+  bool has_work() const noexcept {
+    return consumer_.head.load(std::memory_order_relaxed) !=
+           producer_.tail.load(std::memory_order_seq_cst);
+  }
+
+private:
+  struct producer_side {
+    std::atomic<std::size_t> tail{0U};
+    /// The last head seen by the producer
+    std::size_t head{0U};
+    char padding[cache_line_size - sizeof(std::atomic<std::size_t>) -
+                 sizeof(std::size_t)];
+  };
+
+  struct consumer_side {
+    std::atomic<std::size_t> head{0U};
+    /// The last tail seen by the consumer
+    std::size_t tail{0U};
+    char padding[cache_line_size - sizeof(std::atomic<std::size_t>) -
+                 sizeof(std::size_t)];
+  };
+
+  producer_side producer_;
+  consumer_side consumer_;
+  std::unique_ptr<queued_work[]> slots_;
+};
+
+/// The state of a single core of the runtime
+struct core {
+  explicit core(std::size_t cores) : overflow(cores), sent(cores) {
+  }
+
+  /// The work which was submitted from this core to itself
+  std::deque<queued_work> local;
+  /// The work which didn't fit into the mailbox to a core,
+  /// only accessed from this core.
+  std::vector<std::deque<queued_work>> overflow;
+
+  /// Guards the work submitted from threads outside of the runtime
+  /// and the wakeup of the core.
+  std::mutex lock;
+  std::condition_variable condition;
+  std::deque<queued_work> external;
+  /// Counts the work submitted from threads outside of the runtime,
+  /// only written while the lock is held.
+  metrics::sender_recorder external_sent;
+  std::atomic<bool> has_external{false};
+  std::atomic<bool> sleeping{false};
+  bool woken = false;
+
+  std::thread thread;
+
+  /// Counts the work this core submitted to every core,
+  /// only written from this core.
+  std::vector<metrics::sender_recorder> sent;
+  /// Counts the work taken out of the queues of this core
+  metrics::receiver_recorder queue;
+  /// Counts the work run by this core
+  metrics::worker_recorder worker;
+};
+
+/// Pins the current thread to the given processor if it exists
+inline void pin_current_thread(std::size_t processor) noexcept {
+#if defined(__linux__)
+  if (processor < std::thread::hardware_concurrency() &&
+      processor < CPU_SETSIZE) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(processor, &set);
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#else
+  (void)processor;
+#endif
+}
+} // namespace shard
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_SHARD_HPP_INCLUDED
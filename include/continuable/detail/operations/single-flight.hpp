@@ -0,0 +1,158 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_SINGLE_FLIGHT_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_SINGLE_FLIGHT_HPP_INCLUDED
+
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+#include <exception>
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+namespace cti {
+namespace detail {
+namespace operations {
+/// Resolves all promises in the given container with the same result,
+/// the last promise receives the forwarded arguments, all others a copy.
+template <typename Promises, typename... Args>
+void resolve_all(Promises& promises, Args&&... args) {
+  assert(!promises.empty() && "Expected at least one waiting promise!");
+
+  auto const last = promises.size() - 1;
+  for (std::size_t i = 0; i != last; ++i) {
+    std::move(promises[i])(args...);
+  }
+  std::move(promises[last])(std::forward<Args>(args)...);
+}
+
+/// A part of the in-flight table which is protected by its own lock,
+/// keys are distributed across shards by their hash to reduce contention.
+template <typename Key, typename Promise, typename Hash, typename KeyEqual>
+struct flight_shard {
+  using waiters_t = std::vector<Promise>;
+
+  /// The waiters of a flight, the id tells apart flights of the same key
+  /// which were started one after another.
+  struct flight {
+    std::size_t id;
+    waiters_t waiters;
+  };
+
+  mutable std::mutex lock;
+  std::unordered_map<Key, flight, Hash, KeyEqual> flights;
+  std::size_t next_id = 0;
+
+  /// Registers the promise as waiter on the given key and returns the
+  /// non zero id of a new flight when the caller is the first one
+  /// and needs to start the loader.
+  template <typename P>
+  std::size_t join(Key const& key, P&& promise) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto itr = flights.find(key);
+    if (itr != flights.end()) {
+      itr->second.waiters.emplace_back(std::forward<P>(promise));
+      return 0U;
+    }
+
+    std::size_t const id = ++next_id;
+    flights.emplace(key, flight{id, waiters_t{}})
+        .first->second.waiters.emplace_back(std::forward<P>(promise));
+    return id;
+  }
+
+  /// Removes the in-flight entry of the given key and returns its waiters,
+  /// nothing is returned when the flight with the given id has left already.
+  waiters_t leave(Key const& key, std::size_t id) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto itr = flights.find(key);
+    if ((itr == flights.end()) || (itr->second.id != id)) {
+      return {};
+    }
+
+    waiters_t waiters = std::move(itr->second.waiters);
+    flights.erase(itr);
+    return waiters;
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return flights.size();
+  }
+};
+
+/// Starts the loader for the given key and resolves all waiters of the
+/// key in the shard once its result is available.
+///
+/// The flight is left only once, even when an exception is thrown after
+/// the resolver already left it, such as from a synchronously resolved
+/// loader whose result fails to be copied to a waiter.
+template <typename Shard, typename Key, typename Loader>
+void start_flight(Shard& shard, Key const& key, std::size_t id,
+                  Loader& loader) {
+  auto resolver = [&shard, key, id](auto&&... args) {
+    auto waiters = shard.leave(key, id);
+    if (!waiters.empty()) {
+      resolve_all(waiters, std::forward<decltype(args)>(args)...);
+    }
+  };
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+  try {
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+    util::invoke(loader).next(std::move(resolver));
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+  } catch (...) {
+    auto waiters = shard.leave(key, id);
+    if (!waiters.empty()) {
+      resolve_all(waiters, exception_arg_t{}, std::current_exception());
+    }
+  }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+}
+} // namespace operations
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_SINGLE_FLIGHT_HPP_INCLUDED
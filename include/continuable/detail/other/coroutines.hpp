@@ -77,6 +77,17 @@ public:
 };
 #  endif // CONTINUABLE_HAS_EXCEPTIONS
 
+/// The type which is passed to the compiler that describes the properties
+/// of a continuable_base used as coroutine promise type.
+template <typename Continuable, typename Promise, typename... Args>
+struct promise_type;
+
+template <typename T>
+struct is_promise_type : std::false_type {};
+template <typename Continuable, typename Promise, typename... Args>
+struct is_promise_type<promise_type<Continuable, Promise, Args...>>
+  : std::true_type {};
+
 template <typename T>
 struct result_from_identity;
 template <typename... T>
@@ -112,21 +123,33 @@ public:
   /// Return whether the continuable can provide its result instantly,
   /// which also means its execution is side-effect free.
   bool await_ready() const noexcept {
-    return !result_.is_empty();
+    // Results which are forwarded suspend the coroutine in order
+    // to get access to its promise.
+    return !result_.is_empty() && !is_forwarded(result_);
   }
 
   /// Suspend the current context
   // TODO Convert this to an r-value function once possible
-  void await_suspend(coroutine_handle<> h) {
-    assert(result_.is_empty());
+  template <typename Promise>
+  bool await_suspend(coroutine_handle<Promise> h) {
+    if (!result_.is_empty()) {
+      // The ready result is forwarded, the coroutine stays suspended
+      // if it was destroyed.
+      return forward(is_promise_type<Promise>{}, h);
+    }
+
     // Forward every result to the current awaitable
     std::move(continuable_)
         .next([h, this](auto&&... args) mutable {
           assert(result_.is_empty());
           result_ = result_t::from(std::forward<decltype(args)>(args)...);
-          h.resume();
+          if (!is_forwarded(result_) ||
+              !forward(is_promise_type<Promise>{}, h)) {
+            h.resume();
+          }
         })
         .done();
+    return true;
   }
 
   /// Resume the coroutine represented by the handle
@@ -149,6 +172,37 @@ public:
     CTI_DETAIL_TRAP();
 #  endif // CONTINUABLE_HAS_EXCEPTIONS
   }
+
+private:
+  /// Returns true when the result is passed to the promise of the awaiting
+  /// coroutine directly, instead of resuming the coroutine with it.
+  ///
+  /// Without exceptions every exceptional result is forwarded,
+  /// otherwise cancellations are forwarded if
+  /// CONTINUABLE_WITH_DIRECT_AWAIT_CANCELLATION is defined.
+  static bool is_forwarded(result_t const& result) noexcept {
+#  if !defined(CONTINUABLE_HAS_EXCEPTIONS)
+    return result.is_exception();
+#  elif defined(CONTINUABLE_WITH_DIRECT_AWAIT_CANCELLATION)
+    return result.is_exception() && !bool(result.get_exception());
+#  else
+    (void)result;
+    return false;
+#  endif
+  }
+
+  /// Destroys the awaiting coroutine and resolves its promise with the
+  /// exceptional result. This awaitable is destroyed together with the
+  /// coroutine frame, returns false if the coroutine isn't a continuable.
+  template <typename Promise>
+  bool forward(std::true_type, coroutine_handle<Promise> h) noexcept {
+    h.promise().resolve_exceptionally(h, std::move(result_).get_exception());
+    return true;
+  }
+  template <typename Promise>
+  bool forward(std::false_type, coroutine_handle<Promise>) noexcept {
+    return false;
+  }
 };
 
 /// Converts a continuable into an awaitable object as described by
@@ -173,11 +227,6 @@ struct handle_takeover {
   void await_resume() noexcept {}
 };
 
-/// The type which is passed to the compiler that describes the properties
-/// of a continuable_base used as coroutine promise type.
-template <typename Continuable, typename Promise, typename... Args>
-struct promise_type;
-
 /// Implements the resolving method return_void and return_value accordingly
 template <typename Base>
 struct promise_resolver_base;
@@ -229,6 +278,17 @@ struct promise_type
     return {};
   }
 
+  /// Destroys the coroutine without resuming it and resolves the promise
+  /// through the given exception, which is used to propagate errors
+  /// of awaited continuables without throwing them.
+  template <typename Handle>
+  void resolve_exceptionally(Handle handle, exception_t exception) noexcept {
+    // The promise is part of the coroutine frame
+    Promise promise = std::move(promise_);
+    handle.destroy();
+    promise.set_exception(std::move(exception));
+  }
+
   void unhandled_exception() noexcept {
 #  if defined(CONTINUABLE_HAS_EXCEPTIONS)
     try {
@@ -38,6 +38,10 @@
 #include <continuable/detail/features.hpp>
 #include <continuable/detail/utility/traits.hpp>
 
+#if defined(CONTINUABLE_WITH_ERASURE_STATISTICS)
+#include <continuable/detail/other/spill.hpp>
+#endif // CONTINUABLE_WITH_ERASURE_STATISTICS
+
 namespace cti {
 namespace detail {
 namespace erasure {
@@ -76,6 +80,7 @@ public:
       std::enable_if_t<std::is_convertible<T, erasure_t>::value>* = nullptr,
       std::enable_if_t<!is_callback<traits::unrefcv_t<T>>::value>* = nullptr>
   /* implicit */ callback(T&& callable) : erasure_(std::forward<T>(callable)) {
+    record<traits::unrefcv_t<T>>();
   }
 
   template <
@@ -84,6 +89,7 @@ public:
       std::enable_if_t<!is_callback<traits::unrefcv_t<T>>::value>* = nullptr>
   callback& operator=(T&& callable) {
     erasure_ = std::forward<T>(callable);
+    record<traits::unrefcv_t<T>>();
     return *this;
   }
 
@@ -99,11 +105,22 @@ public:
   explicit operator bool() const noexcept {
     return bool(erasure_);
   }
+
+private:
+  template <typename T>
+  static void record() noexcept {
+#if defined(CONTINUABLE_WITH_ERASURE_STATISTICS)
+    // The callback erasure has no inline capacity
+    spill::record<spill::erasure_kind::callback, 0U, 0U, T, Args...>();
+#endif // CONTINUABLE_WITH_ERASURE_STATISTICS
+  }
 };
 #endif
 
+using work_capacity = fu2::capacity_fixed<32UL>;
+
 using work_erasure_t =
-    fu2::function_base<true, false, fu2::capacity_fixed<32UL>, true, false,
+    fu2::function_base<true, false, work_capacity, true, false,
                        void()&&, void(exception_arg_t, exception_t) &&>;
 
 #ifdef CONTINUABLE_HAS_IMMEDIATE_TYPES
@@ -133,6 +150,7 @@ public:
       std::enable_if_t<std::is_convertible<T, erasure_t>::value>* = nullptr,
       std::enable_if_t<!is_work<traits::unrefcv_t<T>>::value>* = nullptr>
   /* implicit */ work(T&& callable) : erasure_(std::forward<T>(callable)) {
+    record<traits::unrefcv_t<T>>();
   }
 
   template <
@@ -141,6 +159,7 @@ public:
       std::enable_if_t<!is_work<traits::unrefcv_t<T>>::value>* = nullptr>
   work& operator=(T&& callable) {
     erasure_ = std::forward<T>(callable);
+    record<traits::unrefcv_t<T>>();
     return *this;
   }
 
@@ -155,6 +174,15 @@ public:
   explicit operator bool() const noexcept {
     return bool(erasure_);
   }
+
+private:
+  template <typename T>
+  static void record() noexcept {
+#if defined(CONTINUABLE_WITH_ERASURE_STATISTICS)
+    spill::record<spill::erasure_kind::work, work_capacity::capacity,
+                  work_capacity::alignment, T>();
+#endif // CONTINUABLE_WITH_ERASURE_STATISTICS
+  }
 };
 #endif
 
@@ -207,6 +235,7 @@ public:
           nullptr>
   /* implicit */ continuation(T&& callable)
       : erasure_(std::forward<T>(callable)) {
+    record<traits::unrefcv_t<T>>();
   }
 
   template <
@@ -216,6 +245,7 @@ public:
           nullptr>
   continuation& operator=(T&& callable) {
     erasure_ = std::forward<T>(callable);
+    record<traits::unrefcv_t<T>>();
     return *this;
   }
 
@@ -232,6 +262,16 @@ public:
   result<Args...> operator()(unpack_arg_t query_arg) {
     return erasure_(query_arg);
   }
+
+private:
+  template <typename T>
+  static void record() noexcept {
+#if defined(CONTINUABLE_WITH_ERASURE_STATISTICS)
+    using capacity_t = continuation_capacity<Args...>;
+    spill::record<spill::erasure_kind::continuation, capacity_t::capacity,
+                  capacity_t::alignment, T, Args...>();
+#endif // CONTINUABLE_WITH_ERASURE_STATISTICS
+  }
 };
 #endif
 } // namespace erasure
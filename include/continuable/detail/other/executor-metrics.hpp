@@ -0,0 +1,418 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_EXECUTOR_METRICS_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_EXECUTOR_METRICS_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/other/statistics.hpp>
+
+namespace cti {
+namespace detail {
+/// The namespace `metrics` contains the counters of the executors provided
+/// by the library which are recorded when `CONTINUABLE_WITH_EXECUTOR_METRICS`
+/// is defined.
+namespace metrics {
+#if defined(CONTINUABLE_WITH_EXECUTOR_METRICS)
+constexpr bool enabled = true;
+#else  // CONTINUABLE_WITH_EXECUTOR_METRICS
+constexpr bool enabled = false;
+#endif // CONTINUABLE_WITH_EXECUTOR_METRICS
+
+/// The assumed size of a cache line which separates the counters
+/// written by different threads.
+constexpr std::size_t cache_line_size = 64U;
+
+#if defined(CONTINUABLE_EXECUTOR_METRICS_SAMPLE_INTERVAL)
+/// The queue wait is recorded for every n-th work submitted from a thread
+constexpr std::uint32_t sample_interval =
+    CONTINUABLE_EXECUTOR_METRICS_SAMPLE_INTERVAL;
+#else  // CONTINUABLE_EXECUTOR_METRICS_SAMPLE_INTERVAL
+/// The queue wait is recorded for every n-th work submitted from a thread
+constexpr std::uint32_t sample_interval = 16U;
+#endif // CONTINUABLE_EXECUTOR_METRICS_SAMPLE_INTERVAL
+
+/// The counters of a queue of an executor
+struct queue_metrics {
+  /// The count of work which is waiting in the queue
+  std::uint64_t depth = 0U;
+  /// The largest depth the queue had when work was taken out of it
+  std::uint64_t peak_depth = 0U;
+  /// The count of work which was submitted to the queue
+  std::uint64_t enqueued = 0U;
+};
+
+/// The counters of a thread of an executor
+struct worker_metrics {
+  /// The count of work which was run
+  std::uint64_t executed = 0U;
+  /// The time the thread was sleeping while waiting for work
+  std::chrono::nanoseconds idle{0};
+  /// The time between the submission of work and its start
+  statistics::latency_histogram queue_wait;
+};
+
+/// A snapshot of the queues and threads of an executor
+struct executor_metrics {
+  std::vector<queue_metrics> queues;
+  std::vector<worker_metrics> workers;
+
+  /// Returns the count of work which was run by all workers
+  std::uint64_t executed() const noexcept {
+    std::uint64_t executed = 0U;
+    for (auto const& worker : workers) {
+      executed += worker.executed;
+    }
+    return executed;
+  }
+
+  /// Returns the queue wait of all workers merged into a single histogram
+  statistics::latency_histogram queue_wait() const {
+    statistics::latency_histogram merged;
+    for (auto const& worker : workers) {
+      merged.merge(worker.queue_wait);
+    }
+    return merged;
+  }
+};
+
+#if defined(CONTINUABLE_WITH_EXECUTOR_METRICS)
+inline std::uint64_t now() noexcept {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/// The point in time work was submitted to an executor, which is only
+/// taken for every n-th work submitted from a thread since reading
+/// the clock is the most expensive part of the metrics.
+class stamp {
+public:
+  void mark() noexcept {
+    static thread_local std::uint32_t submissions = 0U;
+    if (++submissions >= sample_interval) {
+      submissions = 0U;
+      submitted_ = now();
+    }
+  }
+
+  std::uint64_t submitted() const noexcept {
+    return submitted_;
+  }
+
+private:
+  std::uint64_t submitted_ = 0U;
+};
+
+/// Counts the work which is submitted to a queue from arbitrary threads
+/// and taken out of it by a single thread at a time.
+class queue_recorder {
+public:
+  void enqueued() noexcept {
+    producer_.enqueued.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  void dequeued() noexcept {
+    std::uint64_t const dequeued =
+        consumer_.dequeued.load(std::memory_order_relaxed);
+    std::uint64_t const enqueued =
+        producer_.enqueued.load(std::memory_order_relaxed);
+    consumer_.dequeued.store(dequeued + 1U, std::memory_order_relaxed);
+
+    std::uint64_t const depth = enqueued > dequeued ? enqueued - dequeued : 0U;
+    if (depth > consumer_.peak_depth.load(std::memory_order_relaxed)) {
+      consumer_.peak_depth.store(depth, std::memory_order_relaxed);
+    }
+  }
+
+  queue_metrics snapshot() const noexcept {
+    queue_metrics metrics;
+    std::uint64_t const dequeued =
+        consumer_.dequeued.load(std::memory_order_relaxed);
+    metrics.enqueued = producer_.enqueued.load(std::memory_order_relaxed);
+    metrics.depth =
+        metrics.enqueued > dequeued ? metrics.enqueued - dequeued : 0U;
+    metrics.peak_depth = consumer_.peak_depth.load(std::memory_order_relaxed);
+    return metrics;
+  }
+
+private:
+  struct producer_side {
+    std::atomic<std::uint64_t> enqueued{0U};
+    char padding[cache_line_size - sizeof(std::atomic<std::uint64_t>)];
+  };
+
+  struct consumer_side {
+    std::atomic<std::uint64_t> dequeued{0U};
+    std::atomic<std::uint64_t> peak_depth{0U};
+    char padding[cache_line_size - 2U * sizeof(std::atomic<std::uint64_t>)];
+  };
+
+  producer_side producer_;
+  consumer_side consumer_;
+};
+
+/// Counts the work which a single sender submits to a queue, the queue sums
+/// up the counts of all of its senders, therefore a sender never writes
+/// a counter which is written by other threads as well.
+class sender_recorder {
+public:
+  void enqueued() noexcept {
+    enqueued_.store(enqueued_.load(std::memory_order_relaxed) + 1U,
+                    std::memory_order_relaxed);
+  }
+
+  std::uint64_t count() const noexcept {
+    return enqueued_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::uint64_t> enqueued_{0U};
+};
+
+/// Counts the work which arbitrary threads submit to a queue through
+/// a single counter, for senders which can't be told apart.
+class shared_sender_recorder {
+public:
+  void enqueued() noexcept {
+    counters_.enqueued.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  std::uint64_t count() const noexcept {
+    return counters_.enqueued.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct counters {
+    /// Separates the counter from the data in front of the recorder
+    char padding[cache_line_size];
+    std::atomic<std::uint64_t> enqueued{0U};
+  };
+
+  counters counters_;
+};
+
+/// Counts the work which is taken out of a queue by a single thread at a time,
+/// while the submitted work is counted by a sender_recorder per sender.
+class receiver_recorder {
+public:
+  /// Records the depth of the queue for the given count of submitted work
+  void observed(std::uint64_t enqueued) noexcept {
+    std::uint64_t const dequeued =
+        counters_.dequeued.load(std::memory_order_relaxed);
+    std::uint64_t const depth = enqueued > dequeued ? enqueued - dequeued : 0U;
+    if (depth > counters_.peak_depth.load(std::memory_order_relaxed)) {
+      counters_.peak_depth.store(depth, std::memory_order_relaxed);
+    }
+  }
+
+  void dequeued() noexcept {
+    auto& dequeued = counters_.dequeued;
+    dequeued.store(dequeued.load(std::memory_order_relaxed) + 1U,
+                   std::memory_order_relaxed);
+  }
+
+  queue_metrics snapshot(std::uint64_t enqueued) const noexcept {
+    queue_metrics metrics;
+    std::uint64_t const dequeued =
+        counters_.dequeued.load(std::memory_order_relaxed);
+    metrics.enqueued = enqueued;
+    metrics.depth = enqueued > dequeued ? enqueued - dequeued : 0U;
+    metrics.peak_depth = counters_.peak_depth.load(std::memory_order_relaxed);
+    return metrics;
+  }
+
+private:
+  struct counters {
+    /// Separates the counters from the data in front of the recorder
+    char padding[cache_line_size];
+    std::atomic<std::uint64_t> dequeued{0U};
+    std::atomic<std::uint64_t> peak_depth{0U};
+  };
+
+  counters counters_;
+};
+
+/// Counts the work which is run by a single thread at a time
+class worker_recorder {
+public:
+  /// Records the start of the work which was submitted at the given stamp
+  void started(stamp const& submitted) noexcept {
+    if (submitted.submitted() != 0U) {
+      std::uint64_t const started = now();
+      if (submitted.submitted() <= started) {
+        queue_wait_.record(started - submitted.submitted());
+      }
+    }
+    count_executed();
+  }
+
+  /// Records the start of the work which waited for the given duration
+  void started(std::chrono::nanoseconds waited) noexcept {
+    if (waited.count() >= 0) {
+      queue_wait_.record(static_cast<std::uint64_t>(waited.count()));
+    }
+    count_executed();
+  }
+
+  /// Records the time the thread sleeps while the scope is alive
+  class idle_scope {
+  public:
+    explicit idle_scope(worker_recorder& recorder) noexcept
+        : recorder_(recorder), began_(now()) {
+    }
+    ~idle_scope() {
+      auto& idle = recorder_.counters_.idle;
+      idle.store(idle.load(std::memory_order_relaxed) + (now() - began_),
+                 std::memory_order_relaxed);
+    }
+
+    idle_scope(idle_scope const&) = delete;
+    idle_scope& operator=(idle_scope const&) = delete;
+
+  private:
+    worker_recorder& recorder_;
+    std::uint64_t began_;
+  };
+
+  worker_metrics snapshot() const {
+    worker_metrics metrics;
+    metrics.executed = counters_.executed.load(std::memory_order_relaxed);
+    metrics.idle = std::chrono::nanoseconds(static_cast<std::int64_t>(
+        counters_.idle.load(std::memory_order_relaxed)));
+    queue_wait_.merge_into(metrics.queue_wait);
+    return metrics;
+  }
+
+private:
+  struct counters {
+    /// Separates the counters from the data in front of the recorder
+    char padding[cache_line_size];
+    std::atomic<std::uint64_t> executed{0U};
+    std::atomic<std::uint64_t> idle{0U};
+  };
+
+  void count_executed() noexcept {
+    auto& executed = counters_.executed;
+    executed.store(executed.load(std::memory_order_relaxed) + 1U,
+                   std::memory_order_relaxed);
+  }
+
+  counters counters_;
+  statistics::shared_histogram queue_wait_;
+};
+#else  // CONTINUABLE_WITH_EXECUTOR_METRICS
+class stamp {
+public:
+  void mark() noexcept {
+  }
+};
+
+class queue_recorder {
+public:
+  void enqueued() noexcept {
+  }
+  void dequeued() noexcept {
+  }
+  queue_metrics snapshot() const noexcept {
+    return {};
+  }
+};
+
+class sender_recorder {
+public:
+  void enqueued() noexcept {
+  }
+  std::uint64_t count() const noexcept {
+    return 0U;
+  }
+};
+
+class shared_sender_recorder {
+public:
+  void enqueued() noexcept {
+  }
+  std::uint64_t count() const noexcept {
+    return 0U;
+  }
+};
+
+class receiver_recorder {
+public:
+  void observed(std::uint64_t) noexcept {
+  }
+  void dequeued() noexcept {
+  }
+  queue_metrics snapshot(std::uint64_t) const noexcept {
+    return {};
+  }
+};
+
+class worker_recorder {
+public:
+  void started(stamp const&) noexcept {
+  }
+  void started(std::chrono::nanoseconds) noexcept {
+  }
+
+  class idle_scope {
+  public:
+    explicit idle_scope(worker_recorder&) noexcept {
+    }
+  };
+
+  worker_metrics snapshot() const {
+    return {};
+  }
+};
+#endif // CONTINUABLE_WITH_EXECUTOR_METRICS
+
+/// A work which carries the point in time it was submitted to an executor,
+/// the stamp occupies no space if the metrics are disabled.
+struct stamped_work : stamp {
+  stamped_work() = default;
+  explicit stamped_work(work current) : item(std::move(current)) {
+    mark();
+  }
+
+  work item;
+};
+} // namespace metrics
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_EXECUTOR_METRICS_HPP_INCLUDED
@@ -31,7 +31,15 @@
 #ifndef CONTINUABLE_DETAIL_PROMISIFY_HPP_INCLUDED
 #define CONTINUABLE_DETAIL_PROMISIFY_HPP_INCLUDED
 
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <continuable/continuable-base.hpp>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/detail/features.hpp>
@@ -62,6 +70,13 @@ inline auto default_resolver() {
   };
 }
 
+/// A resolver which passes the error as first value to the promise.
+inline auto error_value_resolver() {
+  return [](auto&& promise, auto&&... args) {
+    promise.set_value(std::forward<decltype(args)>(args)...);
+  };
+}
+
 template <typename... Result>
 struct promisify_helper {
   template <typename Resolver, typename Callable, typename... Args>
@@ -90,6 +105,294 @@ struct promisify_helper {
         });
   }
 };
+
+/// The inline capacity of a slot in a c_callback_pool, callbacks which are
+/// larger than this are moved to the heap.
+constexpr std::size_t c_callback_capacity = 64U;
+
+template <typename... CArgs>
+class c_callback_pool;
+
+/// A stable storage for a single outstanding C callback,
+/// the address of the slot is passed as `void*` user data to the C API.
+template <typename... CArgs>
+struct c_callback_slot {
+  using invoker_t = void (*)(c_callback_slot*, CArgs...);
+  using destroyer_t = void (*)(c_callback_slot*);
+  using rejecter_t = void (*)(c_callback_slot*, exception_t);
+
+  std::aligned_storage_t<c_callback_capacity> storage;
+  invoker_t invoker = nullptr;
+  destroyer_t destroyer = nullptr;
+  rejecter_t rejecter = nullptr;
+  c_callback_slot* next = nullptr;
+  c_callback_pool<CArgs...>* owner = nullptr;
+  /// Is increased when the slot is acquired and again when the callable
+  /// is claimed for its resolution, thus it is odd while the slot is
+  /// occupied by a callable which wasn't claimed yet.
+  std::atomic<std::size_t> serial{0U};
+
+  template <typename T>
+  static constexpr bool is_inplace() noexcept {
+    return (sizeof(T) <= c_callback_capacity) &&
+           (alignof(T) <= alignof(std::aligned_storage_t<c_callback_capacity>)) &&
+           std::is_nothrow_move_constructible<T>::value;
+  }
+
+  /// Stores the given callable into the slot
+  template <typename T>
+  void emplace(T&& callable) {
+    using type = std::decay_t<T>;
+    assert(!invoker && "The slot is occupied already!");
+    store<type>(std::integral_constant<bool, is_inplace<type>()>{},
+                std::forward<T>(callable));
+  }
+
+  /// Destroys the callable which was never invoked
+  void reset() noexcept {
+    if (destroyer) {
+      destroyer(this);
+      invoker = nullptr;
+      destroyer = nullptr;
+      rejecter = nullptr;
+    }
+  }
+
+  /// Claims the callable of the acquisition with the given serial for
+  /// its resolution, which succeeds only once per acquisition.
+  bool claim(std::size_t current) noexcept {
+    return ((current & 1U) != 0U) &&
+           serial.compare_exchange_strong(current, current + 1U,
+                                          std::memory_order_acq_rel);
+  }
+
+  /// Releases the slot and resolves the callable which will never be
+  /// invoked by the C API with the given exception.
+  ///
+  /// The callable is required to be claimed before.
+  void reject(exception_t exception) {
+    assert(rejecter && "The slot was resolved already!");
+    rejecter(this, std::move(exception));
+  }
+
+  /// The function which is passed to the C API
+  static void invoke(void* user_data, CArgs... args) {
+    auto* slot = static_cast<c_callback_slot*>(user_data);
+    bool const claimed =
+        slot->claim(slot->serial.load(std::memory_order_acquire));
+    assert(claimed && "The slot was resolved already!");
+    if (claimed) {
+      slot->invoker(slot, std::move(args)...);
+    }
+  }
+
+private:
+  template <typename T, typename Arg>
+  void store(std::true_type /*inplace*/, Arg&& callable) {
+    new (&storage) T(std::forward<Arg>(callable));
+    invoker = [](c_callback_slot* me, CArgs... args) {
+      T* stored = reinterpret_cast<T*>(&me->storage);
+      // Move the callable out of the slot, so the slot can be reused
+      // by continuations which are started from the callable.
+      T callable(std::move(*stored));
+      stored->~T();
+      me->owner->release(me);
+      std::move(callable)(std::move(args)...);
+    };
+    destroyer = [](c_callback_slot* me) {
+      reinterpret_cast<T*>(&me->storage)->~T();
+    };
+    rejecter = [](c_callback_slot* me, exception_t exception) {
+      T* stored = reinterpret_cast<T*>(&me->storage);
+      T callable(std::move(*stored));
+      stored->~T();
+      me->owner->release(me);
+      callable.set_exception(std::move(exception));
+    };
+  }
+  template <typename T, typename Arg>
+  void store(std::false_type /*inplace*/, Arg&& callable) {
+    new (&storage) T*(new T(std::forward<Arg>(callable)));
+    invoker = [](c_callback_slot* me, CArgs... args) {
+      std::unique_ptr<T> callable(*reinterpret_cast<T**>(&me->storage));
+      me->owner->release(me);
+      std::move(*callable)(std::move(args)...);
+    };
+    destroyer = [](c_callback_slot* me) {
+      delete *reinterpret_cast<T**>(&me->storage);
+    };
+    rejecter = [](c_callback_slot* me, exception_t exception) {
+      std::unique_ptr<T> callable(*reinterpret_cast<T**>(&me->storage));
+      me->owner->release(me);
+      callable->set_exception(std::move(exception));
+    };
+  }
+};
+
+/// A pool of slots which hold outstanding C callbacks.
+///
+/// Slots are allocated in blocks and recycled through a free list,
+/// thus no allocation is done per call once enough slots are available.
+template <typename... CArgs>
+class c_callback_pool {
+public:
+  using slot_t = c_callback_slot<CArgs...>;
+
+  c_callback_pool() = default;
+  c_callback_pool(c_callback_pool const&) = delete;
+  c_callback_pool(c_callback_pool&&) = delete;
+  c_callback_pool& operator=(c_callback_pool const&) = delete;
+  c_callback_pool& operator=(c_callback_pool&&) = delete;
+
+  ~c_callback_pool() {
+    // Destroy the callables which were never invoked by the C API
+    for (auto& block : blocks_) {
+      for (std::size_t i = 0; i != block.second; ++i) {
+        block.first[i].reset();
+      }
+    }
+  }
+
+  /// Allocates the given count of slots through a single allocation
+  void reserve(std::size_t count) {
+    std::lock_guard<std::mutex> guard(lock_);
+    grow(count);
+  }
+
+  /// Returns the count of slots which are not occupied
+  std::size_t available() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return available_;
+  }
+
+  /// Takes a slot from the free list, the pool grows by its current
+  /// size if there is no free slot left.
+  slot_t* acquire() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!free_) {
+      grow(size_ ? size_ : 8U);
+    }
+
+    slot_t* slot = free_;
+    free_ = slot->next;
+    slot->serial.fetch_add(1U, std::memory_order_relaxed);
+    --available_;
+    return slot;
+  }
+
+  /// Returns the given slot to the free list
+  void release(slot_t* slot) noexcept {
+    slot->invoker = nullptr;
+    slot->destroyer = nullptr;
+    slot->rejecter = nullptr;
+
+    std::lock_guard<std::mutex> guard(lock_);
+    slot->next = free_;
+    free_ = slot;
+    ++available_;
+  }
+
+private:
+  void grow(std::size_t count) {
+    if (count == 0U) {
+      return;
+    }
+
+    std::unique_ptr<slot_t[]> block(new slot_t[count]);
+    for (std::size_t i = count; i != 0U; --i) {
+      slot_t& slot = block[i - 1];
+      slot.owner = this;
+      slot.next = free_;
+      free_ = &slot;
+    }
+
+    blocks_.emplace_back(std::move(block), count);
+    size_ += count;
+    available_ += count;
+  }
+
+  mutable std::mutex lock_;
+  std::vector<std::pair<std::unique_ptr<slot_t[]>, std::size_t>> blocks_;
+  slot_t* free_ = nullptr;
+  std::size_t size_ = 0U;
+  std::size_t available_ = 0U;
+};
+
+/// Resolves the promise through the resolver when the C API calls back
+template <typename Resolver, typename Promise>
+struct c_resolver {
+  Resolver resolver;
+  Promise promise;
+
+  template <typename... Args>
+  void operator()(Args&&... args) && {
+    resolver(std::move(promise), std::forward<Args>(args)...);
+  }
+
+  void set_exception(exception_t exception) {
+    promise.set_exception(std::move(exception));
+  }
+};
+
+template <typename... CArgs>
+struct promisify_c_helper {
+  using pool_t = c_callback_pool<CArgs...>;
+  using slot_t = typename pool_t::slot_t;
+
+  /// Converts the C callback taking callable into a continuable, the
+  /// factory creates the callable which is stored inside the slot
+  /// from the promise of the continuation.
+  template <typename... Result, typename Factory, typename Callable,
+            typename... Args>
+  static auto from(pool_t& pool, Factory&& factory, Callable&& callable,
+                   Args&&... args) {
+    return make_continuable<Result...>(
+        [pool = &pool, factory = std::forward<Factory>(factory),
+         args = traits::make_flat_tuple(std::forward<Callable>(callable),
+                                        std::forward<Args>(args)...)](
+            auto&& promise) mutable {
+          auto callable = factory(std::forward<decltype(promise)>(promise));
+          slot_t* slot = pool->acquire();
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+          std::size_t const serial =
+              slot->serial.load(std::memory_order_relaxed);
+          try {
+            slot->emplace(std::move(callable));
+          } catch (...) {
+            // The callable couldn't be stored, return the slot to the pool
+            slot->claim(serial);
+            pool->release(slot);
+            callable.set_exception(std::current_exception());
+            return;
+          }
+
+          try {
+#else
+          slot->emplace(std::move(callable));
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+            traits::unpack(
+                [slot](auto&&... args) {
+                  void (*callback)(void*, CArgs...) = &slot_t::invoke;
+                  util::invoke(std::forward<decltype(args)>(args)...,
+                               callback, static_cast<void*>(slot));
+                },
+                std::move(args));
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+          } catch (...) {
+            // Resolve the promise with the exception of the C API unless
+            // the callback was invoked already, which claimed the slot
+            // and possibly handed it to another call after its release.
+            if (slot->claim(serial)) {
+              slot->reject(std::current_exception());
+            }
+          }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+        });
+  }
+};
 } // namespace convert
 } // namespace detail
 } // namespace cti
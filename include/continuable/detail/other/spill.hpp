@@ -0,0 +1,277 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_SPILL_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_SPILL_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <continuable/detail/features.hpp>
+
+namespace cti {
+namespace detail {
+/// Accounts the objects which are stored inside the type erasures
+/// of continuations, callbacks and work, and whether they fit into
+/// the inline buffer of the erasure or spilled to the heap.
+namespace spill {
+enum class erasure_kind { continuation, callback, work };
+
+inline char const* to_string(erasure_kind kind) noexcept {
+  switch (kind) {
+    case erasure_kind::continuation:
+      return "continuation";
+    case erasure_kind::callback:
+      return "callback";
+    default:
+      return "work";
+  }
+}
+
+/// The constructions of a type erasure with a specific signature
+struct erasure_statistics {
+  /// The arguments of the erased signature, e.g. `int, std::string`
+  std::string signature;
+  erasure_kind kind;
+  /// The current inline capacity and alignment of the erasure in bytes
+  std::size_t capacity;
+  std::size_t alignment;
+  std::uint64_t inline_constructions;
+  std::uint64_t heap_constructions;
+  /// The count of constructions per stored object size, ordered by size
+  std::vector<std::pair<std::size_t, std::uint64_t>> sizes;
+  /// The smallest capacity which would have stored the requested
+  /// fraction of all constructions inline
+  std::size_t recommended_capacity;
+
+  std::uint64_t constructions() const noexcept {
+    return inline_constructions + heap_constructions;
+  }
+};
+
+/// Returns the smallest size which covers the given fraction of
+/// all constructions, rounded up to a multiple of a pointer size.
+inline std::size_t
+recommend_capacity(std::vector<std::pair<std::size_t, std::uint64_t>> const&
+                       sizes,
+                   double coverage) noexcept {
+  std::uint64_t total = 0;
+  for (auto const& size : sizes) {
+    total += size.second;
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  coverage = (std::min)((std::max)(coverage, 0.), 1.);
+  // Tolerate the rounding error of the multiplication on exact fractions
+  auto const required = static_cast<std::uint64_t>(
+      std::ceil(coverage * static_cast<double>(total) - 1e-6));
+
+  std::size_t capacity = 0;
+  std::uint64_t covered = 0;
+  for (auto const& size : sizes) {
+    if (covered >= required) {
+      break;
+    }
+    covered += size.second;
+    capacity = size.first;
+  }
+
+  std::size_t const granularity = sizeof(void*);
+  return (capacity + granularity - 1) / granularity * granularity;
+}
+
+/// Returns a readable representation of the given template arguments
+/// without requiring RTTI.
+template <typename... Args>
+std::string signature_name() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  std::string const name = __FUNCSIG__;
+  std::string const begin_token = "signature_name<";
+  std::string const end_token = ">(void)";
+#else
+  std::string const name = __PRETTY_FUNCTION__;
+#if defined(__clang__)
+  std::string const begin_token = "Args = <";
+  std::string const end_token = ">]";
+#else
+  std::string const begin_token = "Args = {";
+  std::string const end_token = "}";
+#endif
+#endif
+
+  auto const begin = name.find(begin_token);
+  if (begin == std::string::npos) {
+    return name;
+  }
+  auto const first = begin + begin_token.size();
+  auto const last = name.rfind(end_token);
+  if ((last == std::string::npos) || (last < first)) {
+    return name;
+  }
+  return name.substr(first, last - first);
+}
+
+#if defined(CONTINUABLE_WITH_ERASURE_STATISTICS)
+/// Counts the constructions of a specific type inside a specific erasure
+struct site {
+  erasure_kind kind;
+  std::string (*signature)();
+  std::size_t capacity;
+  std::size_t alignment;
+  std::size_t size;
+  bool is_inline;
+  std::atomic<std::uint64_t> constructions{0};
+};
+
+class registry {
+  std::mutex lock_;
+  std::vector<std::unique_ptr<site>> sites_;
+
+public:
+  static registry& instance() {
+    static registry instance;
+    return instance;
+  }
+
+  /// Registers a new site, returns a nullptr if the site couldn't be
+  /// allocated, in which case its constructions aren't recorded.
+  site* attach(erasure_kind kind, std::string (*signature)(),
+               std::size_t capacity, std::size_t alignment, std::size_t size,
+               bool is_inline) noexcept {
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    try {
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+      std::unique_ptr<site> created(new site());
+      created->kind = kind;
+      created->signature = signature;
+      created->capacity = capacity;
+      created->alignment = alignment;
+      created->size = size;
+      created->is_inline = is_inline;
+
+      std::lock_guard<std::mutex> guard(lock_);
+      sites_.push_back(std::move(created));
+      return sites_.back().get();
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    } catch (...) {
+      return nullptr;
+    }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+  }
+
+  std::vector<erasure_statistics> snapshot(double coverage) {
+    using key_t = std::tuple<std::string, erasure_kind>;
+    std::map<key_t, erasure_statistics> merged;
+    std::map<key_t, std::map<std::size_t, std::uint64_t>> sizes;
+
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      for (auto const& current : sites_) {
+        auto const count =
+            current->constructions.load(std::memory_order_relaxed);
+        if (count == 0) {
+          continue;
+        }
+
+        key_t key(current->signature(), current->kind);
+        auto itr = merged.find(key);
+        if (itr == merged.end()) {
+          erasure_statistics statistics{std::get<0>(key),
+                                        current->kind,
+                                        current->capacity,
+                                        current->alignment,
+                                        0U,
+                                        0U,
+                                        {},
+                                        0U};
+          itr = merged.emplace(key, std::move(statistics)).first;
+        }
+
+        if (current->is_inline) {
+          itr->second.inline_constructions += count;
+        } else {
+          itr->second.heap_constructions += count;
+        }
+        sizes[key][current->size] += count;
+      }
+    }
+
+    std::vector<erasure_statistics> result;
+    result.reserve(merged.size());
+    for (auto& entry : merged) {
+      auto& current = sizes[entry.first];
+      entry.second.sizes.assign(current.begin(), current.end());
+      entry.second.recommended_capacity =
+          recommend_capacity(entry.second.sizes, coverage);
+      result.push_back(std::move(entry.second));
+    }
+    return result;
+  }
+};
+
+/// Records the construction of an erasure with the given capacity
+/// from an object of type T, the site is registered once per type.
+///
+/// An object is assumed to be stored inline when its size and alignment
+/// fit into the capacity of the erasure, which is the rule
+/// function2 applies to its in-place storage.
+/// The constructions of a type are never recorded when its site
+/// couldn't be registered, so recording never throws.
+template <erasure_kind Kind, std::size_t Capacity, std::size_t Alignment,
+          typename T, typename... Args>
+void record() noexcept {
+  static constexpr bool is_inline =
+      (sizeof(T) <= Capacity) && (alignof(T) <= Alignment);
+
+  static site* const current = registry::instance().attach(
+      Kind, &signature_name<Args...>, Capacity, Alignment, sizeof(T),
+      is_inline);
+
+  if (current) {
+    current->constructions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+#endif // CONTINUABLE_WITH_ERASURE_STATISTICS
+} // namespace spill
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_SPILL_HPP_INCLUDED
@@ -0,0 +1,618 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_STATISTICS_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_STATISTICS_HPP_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/detail/core/types.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/traits.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+#include <continuable/detail/other/tracing.hpp>
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cti {
+namespace detail {
+/// The namespace `statistics` contains the latency histograms which are
+/// recorded per labeled stage when `CONTINUABLE_WITH_STAGE_STATISTICS`
+/// is defined.
+namespace statistics {
+/// The histograms use a log-linear bucket layout similar to HdrHistogram:
+/// every power of two range is split into `sub_bucket_count` linear
+/// sub buckets, which bounds the relative error to 1 / sub_bucket_count.
+constexpr std::size_t sub_bucket_bits = 5U;
+constexpr std::size_t sub_bucket_count = std::size_t(1U) << sub_bucket_bits;
+/// Values above 2^40 ns (about 18 minutes) are clamped into the last bucket
+constexpr std::size_t magnitude_limit = 40U;
+constexpr std::size_t bucket_count =
+    (magnitude_limit - sub_bucket_bits + 1U) * sub_bucket_count;
+constexpr std::uint64_t highest_trackable_value =
+    (std::uint64_t(1U) << magnitude_limit) - 1U;
+
+/// Returns the position of the most significant bit of a non zero value
+inline std::size_t most_significant_bit(std::uint64_t value) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return index;
+#elif defined(_MSC_VER)
+  unsigned long index;
+  if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32U))) {
+    return index + 32U;
+  }
+  _BitScanReverse(&index, static_cast<unsigned long>(value));
+  return index;
+#else
+  return 63U - static_cast<std::size_t>(__builtin_clzll(value));
+#endif
+}
+
+/// Returns the bucket the given value in nanoseconds is counted in
+inline std::size_t bucket_of(std::uint64_t value) noexcept {
+  value = (std::min)(value, highest_trackable_value);
+  if (value < sub_bucket_count) {
+    return static_cast<std::size_t>(value);
+  }
+  std::size_t const shift = most_significant_bit(value) - sub_bucket_bits;
+  return (shift + 1U) * sub_bucket_count +
+         static_cast<std::size_t>((value >> shift) & (sub_bucket_count - 1U));
+}
+
+/// Returns the lowest value which is counted in the given bucket
+constexpr std::uint64_t lowest_value_of(std::size_t bucket) noexcept {
+  return bucket < sub_bucket_count
+             ? bucket
+             : (sub_bucket_count + bucket % sub_bucket_count)
+                   << (bucket / sub_bucket_count - 1U);
+}
+
+/// Returns the highest value which is counted in the given bucket
+constexpr std::uint64_t highest_value_of(std::size_t bucket) noexcept {
+  return bucket < sub_bucket_count
+             ? bucket
+             : lowest_value_of(bucket) +
+                   ((std::uint64_t(1U) << (bucket / sub_bucket_count - 1U)) -
+                    1U);
+}
+
+/// A latency histogram which isn't shared across threads
+class latency_histogram {
+public:
+  latency_histogram() : counts_(bucket_count, 0U) {
+  }
+
+  /// Adds the given duration to the histogram
+  void record(std::chrono::nanoseconds duration) {
+    using Rep = std::chrono::nanoseconds::rep;
+    std::uint64_t const value =
+        static_cast<std::uint64_t>((std::max)(duration.count(), Rep(0)));
+    ++counts_[bucket_of(value)];
+    ++count_;
+    sum_ += value;
+  }
+
+  /// Adds all durations recorded into the other histogram to this one
+  void merge(latency_histogram const& other) {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+  }
+
+  /// Returns the count of recorded durations
+  std::uint64_t count() const noexcept {
+    return count_;
+  }
+
+  /// Returns the arithmetic mean of all recorded durations
+  std::chrono::nanoseconds mean() const noexcept {
+    return std::chrono::nanoseconds(
+        count_ == 0U ? 0 : static_cast<std::int64_t>(sum_ / count_));
+  }
+
+  /// Returns the lowest recorded duration up to the histogram precision
+  std::chrono::nanoseconds min() const noexcept {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      if (counts_[i] != 0U) {
+        return std::chrono::nanoseconds(
+            static_cast<std::int64_t>(lowest_value_of(i)));
+      }
+    }
+    return std::chrono::nanoseconds(0);
+  }
+
+  /// Returns the highest recorded duration up to the histogram precision
+  std::chrono::nanoseconds max() const noexcept {
+    for (std::size_t i = bucket_count; i != 0; --i) {
+      if (counts_[i - 1U] != 0U) {
+        return std::chrono::nanoseconds(
+            static_cast<std::int64_t>(highest_value_of(i - 1U)));
+      }
+    }
+    return std::chrono::nanoseconds(0);
+  }
+
+  /// Returns the duration which is greater or equal than the given
+  /// percentage of recorded durations, the percentile is given in [0, 100].
+  std::chrono::nanoseconds percentile(double percentile) const noexcept {
+    if (count_ == 0U) {
+      return std::chrono::nanoseconds(0);
+    }
+    double const clamped = (std::min)((std::max)(percentile, 0.), 100.);
+    auto const target = (std::max)(
+        std::uint64_t(1U),
+        static_cast<std::uint64_t>(clamped / 100. * double(count_) + 0.5));
+
+    std::uint64_t seen = 0U;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      seen += counts_[i];
+      if (seen >= target) {
+        return std::chrono::nanoseconds(
+            static_cast<std::int64_t>(highest_value_of(i)));
+      }
+    }
+    return max();
+  }
+
+private:
+  friend class shared_histogram;
+
+  std::vector<std::uint64_t> counts_;
+  std::uint64_t count_ = 0U;
+  std::uint64_t sum_ = 0U;
+};
+
+/// The merged statistics of all stages carrying the same label
+struct stage_statistics {
+  /// The label the stage was tagged with through cti::label
+  std::string label;
+  /// The time between the submission of the stage to its executor and
+  /// the invocation of its callback, only recorded for stages which
+  /// are not invoked inline.
+  latency_histogram queue_wait;
+  /// The time the callback of the stage was running
+  latency_histogram run;
+};
+
+/// A histogram which is written by a single thread at a time and can be read
+/// concurrently without locking.
+class shared_histogram {
+public:
+  void record(std::uint64_t value) noexcept {
+    // There is only one writer, a relaxed load and store
+    // is sufficient and cheaper than a read-modify-write.
+    auto& bucket = counts_[bucket_of(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1U,
+                 std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value,
+               std::memory_order_relaxed);
+  }
+
+  void merge_into(latency_histogram& histogram) const {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      std::uint64_t const count = counts_[i].load(std::memory_order_relaxed);
+      histogram.counts_[i] += count;
+      histogram.count_ += count;
+    }
+    histogram.sum_ += sum_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, bucket_count> counts_{};
+  std::atomic<std::uint64_t> sum_{0U};
+};
+
+#if defined(CONTINUABLE_WITH_STAGE_STATISTICS)
+using clock_type = std::chrono::steady_clock;
+
+struct stage_histograms {
+  shared_histogram queue_wait;
+  shared_histogram run;
+};
+
+/// The histograms recorded by a single thread, indexed by the address of
+/// the label.
+class thread_recorder {
+public:
+  /// The count of distinct labels a single thread is able to record,
+  /// stages with further labels are ignored.
+  static constexpr std::size_t max_labels = 64U;
+
+  /// Returns the histograms of the given label, or a nullptr if the
+  /// capacity of the recorder is exhausted.
+  stage_histograms* find(char const* label) {
+    // Consecutive stages are likely to carry the same label
+    if (label == last_label_) {
+      return last_histograms_;
+    }
+    std::size_t const size = size_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < size; ++i) {
+      if (labels_[i] == label) {
+        return remember(label, histograms_[i].get());
+      }
+    }
+    if (size == max_labels) {
+      return nullptr;
+    }
+    labels_[size] = label;
+    histograms_[size] = std::make_unique<stage_histograms>();
+    // Publishes the new slot to concurrent snapshots
+    size_.store(size + 1U, std::memory_order_release);
+    return remember(label, histograms_[size].get());
+  }
+
+  /// Invokes the visitor with the label and histograms of every slot
+  /// which was published so far.
+  template <typename Visitor>
+  void visit(Visitor&& visitor) const {
+    std::size_t const size = size_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < size; ++i) {
+      visitor(labels_[i], *histograms_[i]);
+    }
+  }
+
+private:
+  stage_histograms* remember(char const* label,
+                             stage_histograms* histograms) noexcept {
+    last_label_ = label;
+    last_histograms_ = histograms;
+    return histograms;
+  }
+
+  char const* last_label_ = nullptr;
+  stage_histograms* last_histograms_ = nullptr;
+  std::atomic<std::size_t> size_{0U};
+  std::array<char const*, max_labels> labels_{};
+  std::array<std::unique_ptr<stage_histograms>, max_labels> histograms_{};
+};
+
+/// Keeps the recorders of all threads alive such that
+/// the statistics of exited threads are still merged into snapshots.
+class registry {
+public:
+  static registry& instance() {
+    static registry instance;
+    return instance;
+  }
+
+  std::shared_ptr<thread_recorder> attach() {
+    auto recorder = std::make_shared<thread_recorder>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    recorders_.push_back(recorder);
+    return recorder;
+  }
+
+  std::vector<stage_statistics> snapshot() const {
+    std::map<std::string, stage_statistics> merged;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto const& recorder : recorders_) {
+        recorder->visit(
+            [&](char const* label, stage_histograms const& histograms) {
+              auto& statistics = merged[label];
+              histograms.queue_wait.merge_into(statistics.queue_wait);
+              histograms.run.merge_into(statistics.run);
+            });
+      }
+    }
+
+    std::vector<stage_statistics> result;
+    result.reserve(merged.size());
+    for (auto& entry : merged) {
+      entry.second.label = entry.first;
+      result.push_back(std::move(entry.second));
+    }
+    return result;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<thread_recorder>> recorders_;
+};
+
+inline thread_recorder& this_thread_recorder() {
+  thread_local std::shared_ptr<thread_recorder> recorder =
+      registry::instance().attach();
+  return *recorder;
+}
+
+/// Returns the current reading of the clock the stages are timed with.
+///
+/// On x86 this is the time stamp counter, which is several times cheaper
+/// to read than the steady_clock and keeps the overhead of a labeled stage
+/// small. The ticks are converted through nanoseconds_per_tick.
+inline std::uint64_t now() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          clock_type::now().time_since_epoch())
+          .count());
+#endif
+}
+
+/// Measures the ticks of now() against the steady_clock for a short
+/// period of time, which is done once per process.
+inline double calibrate_ticks() noexcept {
+  auto const begin = clock_type::now();
+  std::uint64_t const first = now();
+  auto end = begin;
+  do {
+    end = clock_type::now();
+  } while (end - begin < std::chrono::microseconds(200));
+  std::uint64_t const last = now();
+
+  if (last <= first) {
+    return 1.;
+  }
+  auto const elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
+  return double(elapsed.count()) / double(last - first);
+}
+
+/// Returns the nanoseconds which pass per tick of now()
+inline double nanoseconds_per_tick() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) ||             \
+    defined(__x86_64__) || defined(__i386__)
+  static double const scale = calibrate_ticks();
+  return scale;
+#else
+  return 1.;
+#endif
+}
+
+/// Converts a count of ticks of now() into nanoseconds
+inline std::uint64_t to_nanoseconds(std::uint64_t ticks) noexcept {
+  return static_cast<std::uint64_t>(double(ticks) * nanoseconds_per_tick());
+}
+
+/// The end of the labeled stage which finished last on this thread,
+/// zero if code outside of the library could have run since then.
+inline std::uint64_t& boundary() noexcept {
+  thread_local std::uint64_t last = 0U;
+  return last;
+}
+
+/// Returns the end of the stage which finished directly before, such that
+/// the clock is read once per boundary between two stages, or reads the
+/// clock if there is no such stage.
+inline std::uint64_t take_boundary() noexcept {
+  std::uint64_t& last = boundary();
+  std::uint64_t const taken = last;
+  last = 0U;
+  return taken != 0U ? taken : now();
+}
+
+/// Forgets the end of the previous stage, which is required whenever
+/// code outside of the library may run before the next stage.
+inline void forget_boundary() noexcept {
+  boundary() = 0U;
+}
+
+/// The point in time the work which is currently executed on this thread
+/// was submitted to its executor, zero if no such work is running.
+inline std::uint64_t& submitted_at() noexcept {
+  thread_local std::uint64_t submitted = 0U;
+  return submitted;
+}
+
+/// Wraps the callback of a stage and records its run time and the time it
+/// waited on its executor if the stage was labeled.
+template <typename Callback>
+class timed_callback {
+  Callback callback_;
+  char const* label_ = nullptr;
+
+  /// Records the histograms of the labeled stage when leaving the scope
+  class scope {
+    stage_histograms* histograms_;
+    std::uint64_t submitted_;
+    std::uint64_t started_;
+
+    /// Registers the label before the callback is invoked, such that the
+    /// destructor records into the histograms without allocating.
+    static stage_histograms* histograms_of(char const* label) noexcept {
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+      try {
+        return this_thread_recorder().find(label);
+      } catch (...) {
+        // The stage isn't recorded if its histograms can't be allocated
+        return nullptr;
+      }
+#else  // CONTINUABLE_HAS_EXCEPTIONS
+      return this_thread_recorder().find(label);
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+    }
+
+  public:
+    explicit scope(char const* label) noexcept
+        : histograms_(histograms_of(label)), submitted_(submitted_at()),
+          started_(take_boundary()) {
+    }
+    ~scope() {
+      if (histograms_ != nullptr) {
+        std::uint64_t const finished = now();
+        if (submitted_ != 0U && submitted_ <= started_) {
+          histograms_->queue_wait.record(to_nanoseconds(started_ - submitted_));
+        }
+        histograms_->run.record(to_nanoseconds(finished - started_));
+        boundary() = finished;
+      }
+    }
+  };
+
+public:
+  explicit timed_callback(Callback callback) : callback_(std::move(callback)) {
+  }
+
+  void label(char const* label) noexcept {
+    label_ = label;
+  }
+
+  template <typename... Args>
+  auto operator()(Args&&... args) noexcept(noexcept(
+      util::invoke(std::declval<Callback>(), std::declval<Args>()...)))
+      -> decltype(util::invoke(std::declval<Callback>(),
+                               std::declval<Args>()...)) {
+    if (label_ == nullptr) {
+      forget_boundary();
+      return util::invoke(std::move(callback_), std::forward<Args>(args)...);
+    }
+    scope const measured(label_);
+    return util::invoke(std::move(callback_), std::forward<Args>(args)...);
+  }
+};
+
+template <typename Callback>
+auto time_callback(Callback&& callback) {
+  return timed_callback<std::decay_t<Callback>>(
+      std::forward<Callback>(callback));
+}
+
+/// Stamps the time of the submission into the work such that the
+/// callback it invokes is able to measure its queue wait.
+template <typename Work>
+class timed_work {
+  Work work_;
+  std::uint64_t submitted_;
+
+  void run() noexcept {
+    std::uint64_t& current = submitted_at();
+    std::uint64_t const previous = current;
+    current = submitted_;
+    forget_boundary();
+    std::move(work_)();
+    current = previous;
+  }
+
+public:
+  explicit timed_work(Work work)
+      : work_(std::move(work)), submitted_(take_boundary()) {
+  }
+
+  void operator()() && noexcept {
+    run();
+  }
+
+  void operator()(exception_arg_t tag, exception_t exception) && noexcept {
+    std::move(work_)(tag, std::move(exception));
+  }
+
+  void set_value() noexcept {
+    run();
+  }
+
+  void set_exception(exception_t exception) noexcept {
+    std::move(work_)(exception_arg_t{}, std::move(exception));
+  }
+
+  void set_canceled() noexcept {
+    std::move(work_)(exception_arg_t{}, exception_t{});
+  }
+
+  explicit operator bool() const noexcept {
+    return true;
+  }
+};
+
+/// Wraps the work passed to the executor into a timed_work
+template <typename Executor>
+class timed_executor {
+  Executor executor_;
+
+public:
+  explicit timed_executor(Executor executor) : executor_(std::move(executor)) {
+  }
+
+  template <typename Work>
+  void operator()(Work&& work) {
+    util::invoke(std::move(executor_),
+                 timed_work<std::decay_t<Work>>(std::forward<Work>(work)));
+  }
+};
+
+template <typename Executor>
+auto time_executor(Executor&& executor) {
+  return timed_executor<std::decay_t<Executor>>(
+      std::forward<Executor>(executor));
+}
+/// Callbacks which are invoked inline don't wait on any queue
+inline types::this_thread_executor_tag
+time_executor(types::this_thread_executor_tag tag) noexcept {
+  return tag;
+}
+
+/// Labels the stage the given continuation was chained from,
+/// continuations which aren't stages are left untouched.
+template <typename Continuation>
+auto label_stage(Continuation& continuation, char const* label, int)
+    -> decltype(continuation.callback_.label(label)) {
+  continuation.callback_.label(label);
+}
+template <typename Continuation>
+void label_stage(Continuation& /*continuation*/, char const* /*label*/, long) {
+}
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+template <typename Continuation>
+void label_stage(tracing::traced_continuation<Continuation>& continuation,
+                 char const* label, int) {
+  label_stage(continuation.inner(), label, 0);
+}
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+#endif // CONTINUABLE_WITH_STAGE_STATISTICS
+} // namespace statistics
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_STATISTICS_HPP_INCLUDED
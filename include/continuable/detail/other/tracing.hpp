@@ -0,0 +1,187 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_TRACING_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_TRACING_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/continuable-tracing.hpp>
+#include <continuable/detail/core/types.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+namespace cti {
+namespace detail {
+/// The namespace `tracing` wraps continuations, callbacks and executors
+/// such that the hooks of `CONTINUABLE_WITH_TRACE_HOOKS` are invoked.
+/// Nothing in here is used when the hooks are disabled.
+namespace tracing {
+/// Returns a new process wide unique chain id which is never zero
+inline std::uint64_t make_chain_id() noexcept {
+  static std::atomic<std::uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/// Invokes the trace hook, the event type is a template parameter such that
+/// the hook class only needs to be declared when the library is instantiated.
+template <typename Event = trace_event>
+void emit(trace_kind kind, std::uint64_t chain) noexcept {
+  CONTINUABLE_WITH_TRACE_HOOKS::trace(
+      Event{kind, chain, std::chrono::steady_clock::now()});
+}
+
+/// Assigns a chain id to the ownership when it doesn't belong to a chain yet
+/// and emits the creation of a continuation.
+inline void on_create(util::ownership& ownership) noexcept {
+  if (ownership.chain() == 0) {
+    ownership.chain(make_chain_id());
+  }
+  emit(trace_kind::create, ownership.chain());
+}
+
+/// Emits the resolution of the wrapped callback
+template <typename Callback>
+class traced_callback {
+  Callback callback_;
+  std::uint64_t chain_;
+
+public:
+  explicit traced_callback(Callback callback, std::uint64_t chain)
+      : callback_(std::move(callback)), chain_(chain) {
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args) && {
+    emit(trace_kind::resolve, chain_);
+    std::move(callback_)(std::forward<Args>(args)...);
+  }
+
+  void operator()(exception_arg_t tag, exception_t exception) && {
+    emit(bool(exception) ? trace_kind::fail : trace_kind::cancel, chain_);
+    std::move(callback_)(tag, std::move(exception));
+  }
+
+  template <typename... Args>
+  void set_value(Args&&... args) noexcept {
+    std::move(*this)(std::forward<Args>(args)...);
+  }
+
+  void set_exception(exception_t exception) noexcept {
+    std::move(*this)(exception_arg_t{}, std::move(exception));
+  }
+
+  void set_canceled() noexcept {
+    std::move(*this)(exception_arg_t{}, exception_t{});
+  }
+
+  explicit operator bool() const noexcept {
+    return true;
+  }
+};
+
+/// Wraps the callback passed to the continuation into a traced_callback
+template <typename Continuation>
+class traced_continuation {
+  Continuation continuation_;
+  std::uint64_t chain_;
+
+public:
+  explicit traced_continuation(Continuation continuation, std::uint64_t chain)
+      : continuation_(std::move(continuation)), chain_(chain) {
+  }
+
+  /// Returns the wrapped continuation
+  Continuation& inner() noexcept {
+    return continuation_;
+  }
+
+  template <typename Callback>
+  void operator()(Callback&& callback) {
+    util::invoke(std::move(continuation_),
+                 traced_callback<std::decay_t<Callback>>(
+                     std::forward<Callback>(callback), chain_));
+  }
+
+  bool operator()(is_ready_arg_t) const noexcept {
+    return util::as_const(continuation_)(is_ready_arg_t{});
+  }
+
+  decltype(auto) operator()(unpack_arg_t) {
+    return std::move(continuation_)(unpack_arg_t{});
+  }
+};
+
+template <typename Continuation>
+auto trace_continuation(Continuation&& continuation, std::uint64_t chain) {
+  return traced_continuation<std::decay_t<Continuation>>(
+      std::forward<Continuation>(continuation), chain);
+}
+
+/// Emits the submission of work to the wrapped executor
+template <typename Executor>
+class traced_executor {
+  Executor executor_;
+  std::uint64_t chain_;
+
+public:
+  explicit traced_executor(Executor executor, std::uint64_t chain)
+      : executor_(std::move(executor)), chain_(chain) {
+  }
+
+  template <typename Work>
+  void operator()(Work&& work) {
+    emit(trace_kind::submit, chain_);
+    util::invoke(std::move(executor_), std::forward<Work>(work));
+  }
+};
+
+template <typename Executor>
+auto trace_executor(Executor&& executor, std::uint64_t chain) {
+  return traced_executor<std::decay_t<Executor>>(
+      std::forward<Executor>(executor), chain);
+}
+/// Callbacks which are invoked inline are not submitted anywhere
+inline types::this_thread_executor_tag
+trace_executor(types::this_thread_executor_tag tag,
+               std::uint64_t /*chain*/) noexcept {
+  return tag;
+}
+} // namespace tracing
+} // namespace detail
+} // namespace cti
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+
+#endif // CONTINUABLE_DETAIL_TRACING_HPP_INCLUDED
@@ -78,28 +78,35 @@ using explicit_range_sequence_of_t =
                                  std::make_index_sequence<End - Begin>>::type;
 
 /// Continues the traversal when the object is called
+///
+/// The callable is the only object of the traversal which owns the frame,
+/// all traversal points refer to the frame through a plain pointer.
 template <typename Frame, typename State>
 class resume_traversal_callable {
-  Frame frame_;
+  std::shared_ptr<typename Frame::visitor_type> owner_;
   State state_;
 
 public:
-  explicit resume_traversal_callable(Frame frame, State state)
-      : frame_(std::move(frame)), state_(std::move(state)) {
+  explicit resume_traversal_callable(
+      std::shared_ptr<typename Frame::visitor_type> owner, State state)
+      : owner_(std::move(owner)), state_(std::move(state)) {
   }
 
   /// The callable operator for resuming
   /// the asynchronous pack traversal
-  void operator()();
+  void operator()() &;
+  /// The callable operator for resuming the asynchronous pack traversal,
+  /// which releases the ownership of the frame afterwards.
+  void operator()() &&;
 };
 
-/// Creates a resume_traversal_callable from the given frame and the
+/// Creates a resume_traversal_callable from the given frame owner and the
 /// given iterator tuple.
-template <typename Frame, typename State>
-auto make_resume_traversal_callable(Frame&& frame, State&& state)
-    -> resume_traversal_callable<std::decay_t<Frame>, std::decay_t<State>> {
-  return resume_traversal_callable<std::decay_t<Frame>, std::decay_t<State>>(
-      std::forward<Frame>(frame), std::forward<State>(state));
+template <typename Frame, typename Owner, typename State>
+auto make_resume_traversal_callable(Owner&& owner, State&& state)
+    -> resume_traversal_callable<Frame, std::decay_t<State>> {
+  return resume_traversal_callable<Frame, std::decay_t<State>>(
+      std::forward<Owner>(owner), std::forward<State>(state));
 }
 
 template <typename T, typename = void>
@@ -165,6 +172,9 @@ class async_traversal_frame : public data_layout_t<Visitor, Args...> {
   }
 
 public:
+  /// The visitor type which owns the frame
+  using visitor_type = Visitor;
+
   template <typename... T>
   explicit async_traversal_frame(T&&... args)
       : data_layout_t<Visitor, Args...>(std::forward<T>(args)...)
@@ -190,14 +200,10 @@ public:
   /// when it's called later.
   template <typename T, typename Hierarchy>
   void async_continue(T&& value, Hierarchy&& hierarchy) {
-    // Cast the frame up
-    auto frame = std::static_pointer_cast<async_traversal_frame>(
-        this->shared_from_this());
-
-    // Create a callable object which resumes the current
-    // traversal when it's called.
-    auto resumable = make_resume_traversal_callable(
-        std::move(frame), std::forward<Hierarchy>(hierarchy));
+    // Create a callable object which owns the frame and resumes
+    // the current traversal when it's called.
+    auto resumable = make_resume_traversal_callable<async_traversal_frame>(
+        this->shared_from_this(), std::forward<Hierarchy>(hierarchy));
 
     // Invoke the visitor with the current value and the
     // callable object to resume the control flow.
@@ -514,9 +520,31 @@ struct resume_state_callable {
 };
 
 template <typename Frame, typename State>
-void resume_traversal_callable<Frame, State>::operator()() {
-  auto hierarchy = std::tuple_cat(std::make_tuple(frame_), state_);
-  traits::unpack(resume_state_callable{}, std::move(hierarchy));
+void resume_traversal_callable<Frame, State>::operator()() & {
+  // The holder of this callable may drop it while the traversal is resumed,
+  // therefore the frame and the state are kept alive through local copies.
+  // Below this call the frame is passed around without a reference count.
+  auto owner = owner_;
+  auto state = state_;
+  Frame* frame = static_cast<Frame*>(owner.get());
+  traits::unpack(
+      [&](auto&&... hierarchy) {
+        resume_state_callable{}(frame,
+                                std::forward<decltype(hierarchy)>(hierarchy)...);
+      },
+      std::move(state));
+}
+
+template <typename Frame, typename State>
+void resume_traversal_callable<Frame, State>::operator()() && {
+  auto owner = std::move(owner_);
+  Frame* frame = static_cast<Frame*>(owner.get());
+  traits::unpack(
+      [&](auto&&... hierarchy) {
+        resume_state_callable{}(frame,
+                                std::forward<decltype(hierarchy)>(hierarchy)...);
+      },
+      std::move(state_));
 }
 
 /// Gives access to types related to the traversal frame
@@ -536,42 +564,72 @@ struct async_traversal_types<async_traverse_in_place_tag<Visitor>, VisitorArg,
                              Args...>
     : async_traversal_types<Visitor, Args...> {};
 
+/// Starts the asynchronous traversal of the given frame
+template <typename Frame, typename Visitor>
+std::shared_ptr<Visitor> start_pack_transform_async(
+    std::shared_ptr<Visitor> owner) {
+  // The owner keeps the frame alive until the synchronous part of the
+  // traversal returned, the points refer to the frame directly.
+  Frame* frame = static_cast<Frame*>(owner.get());
+
+  // Start the asynchronous traversal with a static range
+  // of the top level tuple.
+  resume_state_callable{}(frame, make_static_range(frame->head()));
+
+  // The frame is returned as the given visitor type
+  // for implementation invisibility
+  return owner;
+}
+
+/// Checks whether the visitor is able to own the traversal frame
+template <typename Visitor>
+void assert_async_visitor() {
+  // Check whether the visitor inherits enable_shared_from_this
+  static_assert(std::is_base_of<std::enable_shared_from_this<Visitor>,
+                                Visitor>::value,
+                "The visitor must inherit std::enable_shared_from_this!");
+
+  // Check whether the visitor is virtual destructible
+  static_assert(std::has_virtual_destructor<Visitor>::value,
+                "The visitor must have a virtual destructor!");
+}
+
 /// Traverses the given pack with the given mapper
 template <typename Visitor, typename... Args>
 auto apply_pack_transform_async(Visitor&& visitor, Args&&... args) {
-
   // Provide the frame and visitor type
   using types = async_traversal_types<Visitor, Args...>;
   using frame_t = typename types::frame_t;
   using visitor_t = typename types::visitor_t;
 
-  // Check whether the visitor inherits enable_shared_from_this
-  static_assert(std::is_base_of<std::enable_shared_from_this<visitor_t>,
-                                visitor_t>::value,
-                "The visitor must inherit std::enable_shared_from_this!");
-
-  // Check whether the visitor is virtual destructible
-  static_assert(std::has_virtual_destructor<visitor_t>::value,
-                "The visitor must have a virtual destructor!");
+  assert_async_visitor<visitor_t>();
 
   // Create the frame on the heap which stores the arguments
   // to traverse asynchronous. It persists until the
   // traversal frame isn't referenced anymore.
-  auto frame = std::make_shared<frame_t>(std::forward<Visitor>(visitor),
-                                         std::forward<Args>(args)...);
+  std::shared_ptr<visitor_t> owner = std::make_shared<frame_t>(
+      std::forward<Visitor>(visitor), std::forward<Args>(args)...);
+
+  return start_pack_transform_async<frame_t>(std::move(owner));
+}
 
-  // Create a static range for the top level tuple
-  auto range = std::make_tuple(make_static_range(frame->head()));
+/// Traverses the given pack with the given mapper,
+/// the frame is allocated through the given allocator.
+template <typename Allocator, typename Visitor, typename... Args>
+auto apply_pack_transform_async_allocate(Allocator const& allocator,
+                                         Visitor&& visitor, Args&&... args) {
+  using types = async_traversal_types<Visitor, Args...>;
+  using frame_t = typename types::frame_t;
+  using visitor_t = typename types::visitor_t;
 
-  // Create a resumer to start the asynchronous traversal
-  auto resumer = make_resume_traversal_callable(frame, std::move(range));
+  assert_async_visitor<visitor_t>();
 
-  // Start the asynchronous traversal
-  resumer();
+  // The frame and the reference count share a single allocation
+  // which is requested from the given allocator.
+  std::shared_ptr<visitor_t> owner = std::allocate_shared<frame_t>(
+      allocator, std::forward<Visitor>(visitor), std::forward<Args>(args)...);
 
-  // Cast the shared_ptr down to the given visitor type
-  // for implementation invisibility
-  return std::static_pointer_cast<visitor_t>(std::move(frame));
+  return start_pack_transform_async<frame_t>(std::move(owner));
 }
 } // namespace traversal
 } // namespace detail
@@ -34,12 +34,26 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <initializer_list>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/result-trait.hpp>
 #include <continuable/detail/utility/traits.hpp>
 
+// The exception_ptr of libstdc++ and libc++ is a single pointer to the
+// reference counted exception object, which is never misaligned.
+// Therefore its representation provides a niche for the states of a result
+// and it can be relocated to another address through copying its bytes.
+#if defined(CONTINUABLE_HAS_EXCEPTIONS) &&                                     \
+    (defined(__GLIBCXX__) || defined(_LIBCPP_VERSION))
+#define CONTINUABLE_DETAIL_HAS_EXCEPTION_NICHE
+#endif
+
 namespace cti {
 namespace detail {
 namespace container {
@@ -48,6 +62,18 @@ enum class result_slot_t : std::uint8_t {
   slot_value,
   slot_exception,
 };
+
+/// Is true for types which can be moved to another address through copying
+/// their bytes, whereby the source isn't destroyed afterwards.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+template <typename... T>
+struct is_trivially_relocatable<std::tuple<T...>>
+  : traits::conjunction<is_trivially_relocatable<T>...> {};
+#if defined(CONTINUABLE_DETAIL_HAS_EXCEPTION_NICHE)
+template <>
+struct is_trivially_relocatable<std::exception_ptr> : std::true_type {};
+#endif // CONTINUABLE_DETAIL_HAS_EXCEPTION_NICHE
 } // namespace container
 
 struct init_empty_arg_t {};
@@ -62,6 +88,9 @@ class result_variant {
   static constexpr bool is_nothrow_move_constructible = //
       std::is_nothrow_move_constructible<T>::value &&
       std::is_nothrow_move_constructible<exception_t>::value;
+  static constexpr bool is_trivially_relocatable = //
+      container::is_trivially_relocatable<T>::value &&
+      container::is_trivially_relocatable<exception_t>::value;
 
 public:
   result_variant() = default;
@@ -90,22 +119,7 @@ public:
   result_variant(result_variant&& other) noexcept(
       is_nothrow_destructible&& is_nothrow_move_constructible)
     : slot_(other.slot_) {
-
-    switch (other.slot_) {
-      case container::result_slot_t::slot_value: {
-        new (value_ptr()) T(std::move(*other.value_ptr()));
-        break;
-      }
-      case container::result_slot_t::slot_exception: {
-        new (exception_ptr()) exception_t(std::move(*other.exception_ptr()));
-        break;
-      }
-      default: {
-        break;
-      }
-    }
-
-    other.destroy();
+    relocate(std::integral_constant<bool, is_trivially_relocatable>{}, other);
     other.slot_ = container::result_slot_t::slot_empty;
   }
 
@@ -114,22 +128,7 @@ public:
 
     destroy();
     slot_ = other.slot_;
-
-    switch (other.slot_) {
-      case container::result_slot_t::slot_value: {
-        new (value_ptr()) T(std::move(*other.value_ptr()));
-        break;
-      }
-      case container::result_slot_t::slot_exception: {
-        new (exception_ptr()) exception_t(std::move(*other.exception_ptr()));
-        break;
-      }
-      default: {
-        break;
-      }
-    }
-
-    other.destroy();
+    relocate(std::integral_constant<bool, is_trivially_relocatable>{}, other);
     other.slot_ = container::result_slot_t::slot_empty;
     return *this;
   }
@@ -189,6 +188,31 @@ private:
     return reinterpret_cast<exception_t*>(&storage_);
   }
 
+  /// Moves the content of other into this and leaves other destroyed
+  void relocate(std::true_type, result_variant& other) noexcept {
+    if (slot_ != container::result_slot_t::slot_empty) {
+      std::memcpy(&storage_, &other.storage_, sizeof(storage_));
+    }
+  }
+  void relocate(std::false_type, result_variant& other) noexcept(
+      is_nothrow_destructible&& is_nothrow_move_constructible) {
+    switch (other.slot_) {
+      case container::result_slot_t::slot_value: {
+        new (value_ptr()) T(std::move(*other.value_ptr()));
+        break;
+      }
+      case container::result_slot_t::slot_exception: {
+        new (exception_ptr()) exception_t(std::move(*other.exception_ptr()));
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+
+    other.destroy();
+  }
+
   void destroy() noexcept(is_nothrow_destructible) {
     switch (slot_) {
       case container::result_slot_t::slot_value: {
@@ -211,6 +235,130 @@ private:
       (alignof(T) > alignof(exception_t) ? alignof(T) : alignof(exception_t))>
       storage_;
 };
+
+#if defined(CONTINUABLE_DETAIL_HAS_EXCEPTION_NICHE)
+/// The variant of a `result<>`, which doesn't store a value, encodes its
+/// empty and value state in the representation of the exception_ptr,
+/// which makes it as large as a pointer.
+template <>
+class result_variant<void_arg_t> : void_arg_t {
+  static_assert(sizeof(exception_t) == sizeof(std::uintptr_t),
+                "The exception_ptr is expected to be a single pointer!");
+
+  // Tags which are never a valid exception_ptr, a null exception_ptr
+  // represents a cancellation and is a valid exception therefore.
+  static constexpr std::uintptr_t empty_tag = 1U;
+  static constexpr std::uintptr_t value_tag = 2U;
+
+public:
+  result_variant() noexcept {
+    set_tag(empty_tag);
+  }
+  ~result_variant() noexcept {
+    destroy();
+  }
+
+  explicit result_variant(init_empty_arg_t) noexcept {
+    set_tag(empty_tag);
+  }
+  explicit result_variant(init_result_arg_t, void_arg_t) noexcept {
+    set_tag(value_tag);
+  }
+  explicit result_variant(init_exception_arg_t,
+                          exception_t exception) noexcept {
+    new (exception_ptr()) exception_t(std::move(exception));
+  }
+
+  result_variant(result_variant const&) = delete;
+  result_variant& operator=(result_variant const&) = delete;
+
+  result_variant(result_variant&& other) noexcept {
+    std::memcpy(&storage_, &other.storage_, sizeof(storage_));
+    other.set_tag(empty_tag);
+  }
+
+  result_variant& operator=(result_variant&& other) noexcept {
+    destroy();
+    std::memcpy(&storage_, &other.storage_, sizeof(storage_));
+    other.set_tag(empty_tag);
+    return *this;
+  }
+
+  void set_empty() noexcept {
+    destroy();
+    set_tag(empty_tag);
+  }
+  void set_value(void_arg_t) noexcept {
+    destroy();
+    set_tag(value_tag);
+  }
+  void set_exception(exception_t exception) noexcept {
+    destroy();
+    new (exception_ptr()) exception_t(std::move(exception));
+  }
+
+  container::result_slot_t slot() const noexcept {
+    switch (tag()) {
+      case empty_tag:
+        return container::result_slot_t::slot_empty;
+      case value_tag:
+        return container::result_slot_t::slot_value;
+      default:
+        return container::result_slot_t::slot_exception;
+    }
+  }
+
+  bool is_empty() const noexcept {
+    return tag() == empty_tag;
+  }
+  bool is_value() const noexcept {
+    return tag() == value_tag;
+  }
+  bool is_exception() const noexcept {
+    return !is_empty() && !is_value();
+  }
+
+  void_arg_t& get_value() noexcept {
+    assert(is_value());
+    return *this;
+  }
+  void_arg_t const& get_value() const noexcept {
+    assert(is_value());
+    return *this;
+  }
+
+  exception_t& get_exception() noexcept {
+    assert(is_exception());
+    return *exception_ptr();
+  }
+  exception_t const& get_exception() const noexcept {
+    assert(is_exception());
+    return *reinterpret_cast<exception_t const*>(&storage_);
+  }
+
+private:
+  exception_t* exception_ptr() noexcept {
+    return reinterpret_cast<exception_t*>(&storage_);
+  }
+
+  std::uintptr_t tag() const noexcept {
+    std::uintptr_t tag;
+    std::memcpy(&tag, &storage_, sizeof(tag));
+    return tag;
+  }
+  void set_tag(std::uintptr_t tag) noexcept {
+    std::memcpy(&storage_, &tag, sizeof(tag));
+  }
+
+  void destroy() noexcept {
+    if (is_exception()) {
+      exception_ptr()->~exception_t();
+    }
+  }
+
+  std::aligned_storage_t<sizeof(exception_t), alignof(exception_t)> storage_;
+};
+#endif // CONTINUABLE_DETAIL_HAS_EXCEPTION_NICHE
 } // namespace detail
 } // namespace cti
 
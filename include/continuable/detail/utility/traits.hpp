@@ -147,6 +147,24 @@ using is_invocable_from_tuple =
 template <typename T, typename... Args>
 using is_invocable = is_invocable_from_tuple<T, std::tuple<Args...>>;
 
+namespace detail {
+template <typename T, typename Args, typename = traits::void_t<>>
+struct is_nothrow_invokable_impl : std::common_type<std::false_type> {};
+
+template <typename T, typename... Args>
+struct is_nothrow_invokable_impl<
+    T, std::tuple<Args...>,
+    void_t<decltype(std::declval<T>()(std::declval<Args>()...))>>
+    : std::common_type<std::integral_constant<
+          bool, noexcept(std::declval<T>()(std::declval<Args>()...))>> {};
+} // namespace detail
+
+/// Deduces to a std::true_type if the given type is callable with the arguments
+/// inside the given tuple and the call is declared as non throwing.
+template <typename T, typename Args>
+using is_nothrow_invocable_from_tuple =
+    typename detail::is_nothrow_invokable_impl<T, Args>::type;
+
 /// Deduces to a std::false_type
 template <typename T>
 using fail = std::integral_constant<bool, !std::is_same<T, T>::value>;
@@ -32,6 +32,7 @@
 #define CONTINUABLE_DETAIL_UTIL_HPP_INCLUDED
 
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <tuple>
 #include <type_traits>
@@ -192,6 +193,37 @@ struct invocation_env {
 };
 } // namespace detail
 
+namespace detail {
+template <typename Args, typename Indices>
+struct except_last_impl;
+template <typename Args, std::size_t... I>
+struct except_last_impl<Args, std::index_sequence<I...>> {
+  using type = std::tuple<std::tuple_element_t<I, Args>...>;
+};
+
+template <std::size_t Keep, typename T, typename Args,
+          bool IsInvocable = traits::is_invocable_from_tuple<T, Args>::value,
+          bool CanDrop = (std::tuple_size<Args>::value > Keep)>
+struct is_nothrow_partial_invocable_impl : std::false_type {};
+template <std::size_t Keep, typename T, typename Args, bool CanDrop>
+struct is_nothrow_partial_invocable_impl<Keep, T, Args, true, CanDrop>
+    : traits::is_nothrow_invocable_from_tuple<T, Args> {};
+template <std::size_t Keep, typename T, typename Args>
+struct is_nothrow_partial_invocable_impl<Keep, T, Args, false, true>
+    : is_nothrow_partial_invocable_impl<
+          Keep, T,
+          typename except_last_impl<
+              Args, std::make_index_sequence<std::tuple_size<Args>::value -
+                                             1U>>::type> {};
+} // namespace detail
+
+/// Deduces to a std::true_type if the call which partial_invoke selects
+/// for the given arguments is declared as non throwing.
+template <std::size_t KeepArgs, typename T, typename... Args>
+using is_nothrow_partial_invocable =
+    typename detail::is_nothrow_partial_invocable_impl<
+        KeepArgs, T, std::tuple<Args...>>::type;
+
 /// Partially invokes the given callable with the given arguments.
 ///
 /// \note This function will assert statically if there is no way to call the
@@ -265,9 +297,15 @@ struct non_movable {
 /// move-able ownership that is invalidated when the object
 /// is moved to another instance.
 class ownership {
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+  explicit constexpr ownership(bool acquired, bool frozen, std::uint64_t chain)
+      : acquired_(acquired), frozen_(frozen), chain_(chain) {
+  }
+#else  // CONTINUABLE_WITH_TRACE_HOOKS
   explicit constexpr ownership(bool acquired, bool frozen)
       : acquired_(acquired), frozen_(frozen) {
   }
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
 
 public:
   constexpr ownership() : acquired_(true), frozen_(false) {
@@ -275,18 +313,29 @@ public:
   constexpr ownership(ownership const&) = default;
   ownership(ownership&& right) noexcept
       : acquired_(right.consume()), frozen_(right.is_frozen()) {
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+    chain_ = right.chain_;
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
   }
   ownership& operator=(ownership const&) = default;
   ownership& operator=(ownership&& right) noexcept {
     acquired_ = right.consume();
     frozen_ = right.is_frozen();
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+    chain_ = right.chain_;
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
     return *this;
   }
 
   // Merges both ownerships together
   ownership operator|(ownership const& right) const noexcept {
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+    return ownership(is_acquired() && right.is_acquired(),
+                     is_frozen() || right.is_frozen(), chain_);
+#else  // CONTINUABLE_WITH_TRACE_HOOKS
     return ownership(is_acquired() && right.is_acquired(),
                      is_frozen() || right.is_frozen());
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
   }
 
   constexpr bool is_acquired() const noexcept {
@@ -305,6 +354,17 @@ public:
     frozen_ = enabled;
   }
 
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+  /// Returns the id of the chain the owning continuable belongs to,
+  /// zero if no id was assigned yet.
+  constexpr std::uint64_t chain() const noexcept {
+    return chain_;
+  }
+  void chain(std::uint64_t id) noexcept {
+    chain_ = id;
+  }
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
+
 private:
   bool consume() noexcept {
     if (is_acquired()) {
@@ -318,6 +378,10 @@ private:
   bool acquired_ : 1;
   /// Is true when the automatic invocation on destruction is disabled
   bool frozen_ : 1;
+#if defined(CONTINUABLE_WITH_TRACE_HOOKS)
+  /// The id of the traced chain which is shared by all its continuations
+  std::uint64_t chain_ = 0;
+#endif // CONTINUABLE_WITH_TRACE_HOOKS
 };
 } // namespace util
 } // namespace detail
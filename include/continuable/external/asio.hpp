@@ -142,6 +142,41 @@ auto use_continuable_ignoring(Args&&... args) noexcept {
   return use_continuable_t<detail::asio::map_ignore<sizeof...(Args)>>{
       {asio_basic_errors_t(std::forward<Args>(args))...}};
 }
+
+/// Type used as an ASIO completion token to specify an asynchronous operation
+/// that should return a continuable_base which passes the asio error code
+/// as its first value instead of failing with it.
+///
+/// Errors don't allocate an exception in this case and are handled inside
+/// the next handler, which makes the token suitable for operations which
+/// fail routinely like reads from connections which are reset:
+/// ```cpp
+/// socket.async_read_some(asio::buffer(data), cti::use_continuable_ec)
+///   .then([](cti::asio_error_code_t ec, std::size_t bytes) {
+///     if (ec) {
+///       // Handle the error
+///     }
+///   });
+/// ```
+///
+/// The token can be selected per operation and the error code isn't
+/// converted to the exception type used by the library.
+/// The given Mapper is applied as for use_continuable_t: ignored errors are
+/// passed as a cleared error code and
+/// `asio::error::basic_errors::operation_aborted` cancels the continuation
+/// through a default constructed exception type, which doesn't allocate.
+///
+/// \since 4.3.0
+template <typename Mapper = detail::asio::map_default>
+struct use_continuable_ec_t : public Mapper {
+  using Mapper::Mapper;
+};
+
+/// Special value for instance of use_continuable_ec_t which passes the
+/// asio error code as first value to the continuation.
+///
+/// \copydetails use_continuable_ec_t
+constexpr use_continuable_ec_t<> use_continuable_ec{};
 } // namespace cti
 
 CTI_DETAIL_ASIO_NAMESPACE_BEGIN
@@ -174,6 +209,37 @@ public:
   }
 };
 
+template <typename Signature, typename Matcher>
+class async_result<cti::use_continuable_ec_t<Matcher>, Signature> {
+public:
+#if defined(CTI_DETAIL_ASIO_HAS_EXPLICIT_RET_TYPE_INTEGRATION)
+  using return_type =
+      typename cti::detail::asio::initiate_make_error_code_continuable<
+          Signature>::erased_return_type;
+#endif
+
+  template <typename Initiation, typename... Args>
+  static auto initiate(Initiation initiation,
+                       cti::use_continuable_ec_t<Matcher> token,
+                       Args... args) {
+    return cti::detail::asio::initiate_make_error_code_continuable<
+        Signature>{}([initiation = std::move(initiation),
+                      token = std::move(token),
+                      init_args = std::make_tuple(std::move(args)...)](
+                         auto&& promise) mutable {
+      cti::detail::traits::unpack(
+          [initiation = std::move(initiation),
+           handler = cti::detail::asio::error_code_resolver_handler(
+               std::forward<decltype(promise)>(promise), std::move(token))](
+              auto&&... args) mutable {
+            std::move(initiation)(std::move(handler),
+                                  std::forward<decltype(args)>(args)...);
+          },
+          std::move(init_args));
+    });
+  }
+};
+
 CTI_DETAIL_ASIO_NAMESPACE_END
 
 #undef CTI_DETAIL_ASIO_NAMESPACE_BEGIN
@@ -0,0 +1,242 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_ASYNC_CACHE_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_ASYNC_CACHE_HPP_INCLUDED
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/operations/async-cache.hpp>
+#include <continuable/detail/utility/util.hpp>
+#include <continuable/operations/single-flight.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// A snapshot of the counters of a cti::async_cache
+///
+/// \since 4.3.0
+struct cache_stats {
+  /// The count of lookups which were served from the cache
+  std::size_t hits = 0;
+  /// The count of lookups which weren't present or expired
+  std::size_t misses = 0;
+  /// The count of entries which were evicted to stay inside the budget
+  std::size_t evictions = 0;
+  /// The count of entries which weren't cached because they were heavier
+  /// than the budget of a shard
+  std::size_t rejections = 0;
+  /// The count of entries currently cached
+  std::size_t size = 0;
+  /// The accumulated weight of all entries currently cached
+  std::size_t weight = 0;
+};
+
+/// A concurrent cache of asynchronous results which evicts its entries
+/// in least recently used order and after a time to live.
+///
+/// A lookup which hits the cache resolves with a copy of the cached value
+/// on the thread which started it, without invoking the loader.
+/// Apart from the copy of the value, a hit only allocates the type erasures
+/// of the returned cti::continuable and of the callback it is started with.
+/// Concurrent misses of the same key are coalesced through
+/// a cti::single_flight such that the loader is invoked only once.
+/// ```cpp
+/// cti::async_cache<std::string, std::shared_ptr<user>> users(
+///     /*memory_budget*/ 1 << 20, std::chrono::minutes(5));
+///
+/// cti::continuable<std::shared_ptr<user>> get_user(std::string name) {
+///   return users.get(name, [name] {
+///     return database.query_user(name);
+///   });
+/// }
+/// ```
+///
+/// The cache is split into `Shards` independently locked shards which
+/// maintain their own LRU order and an equal part of the memory budget.
+/// The weight of an entry is calculated through the `Weigher`, which is
+/// invoked with the key and the value, and defaults to
+/// `sizeof(Key) + sizeof(Value)`.
+///
+/// An entry is never heavier than the budget of its shard, which is
+/// `memory_budget / Shards` rounded up and returned by shard_budget().
+/// Heavier entries are not cached and are counted as rejections.
+/// Caches of few but heavy entries should use fewer `Shards`.
+///
+/// \tparam Value The type of the cached value which is required to be
+///               copyable. Values which are expensive to copy should be
+///               wrapped into a `std::shared_ptr`.
+///
+/// \attention The async_cache object needs to outlive all lookups
+///            started through it.
+///
+/// \since 4.3.0
+///
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Weigher = detail::operations::default_weigher,
+          typename Clock = std::chrono::steady_clock, std::size_t Shards = 16>
+class async_cache {
+  static_assert(Shards > 0, "There needs to be at least one shard!");
+
+  using shard_t =
+      detail::operations::cache_shard<Key, Value, Hash, KeyEqual, Clock>;
+
+  Hash hash_;
+  Weigher weigher_;
+  std::size_t shard_budget_;
+  typename Clock::duration ttl_;
+  std::array<shard_t, Shards> shards_;
+  single_flight<Key, Value, Hash, KeyEqual, Shards> flights_;
+
+public:
+  /// Creates a cache which holds entries up to the given accumulated weight
+  /// and for the given time to live at most.
+  explicit async_cache(
+      std::size_t memory_budget,
+      typename Clock::duration ttl = Clock::duration::max(),
+      Weigher weigher = Weigher{}, Hash hash = Hash{})
+      : hash_(hash), weigher_(std::move(weigher)),
+        shard_budget_((memory_budget + Shards - 1) / Shards), ttl_(ttl),
+        flights_(std::move(hash)) {
+  }
+
+  async_cache(async_cache const&) = delete;
+  async_cache(async_cache&&) = delete;
+  async_cache& operator=(async_cache const&) = delete;
+  async_cache& operator=(async_cache&&) = delete;
+
+  /// Returns the count of independently locked shards of the cache
+  ///
+  /// \since 4.3.0
+  static constexpr std::size_t shard_count() noexcept {
+    return Shards;
+  }
+
+  /// Returns the part of the memory budget of a single shard,
+  /// which is the largest weight of an entry the cache accepts.
+  ///
+  /// \since 4.3.0
+  std::size_t shard_budget() const noexcept {
+    return shard_budget_;
+  }
+
+  /// Returns a cti::continuable which resolves with the cached value
+  /// of the given key, or with the result of the loader on a miss.
+  ///
+  /// The loader is invoked with no arguments and returns a
+  /// continuable_base resolving with `Value`. Its result is inserted into
+  /// the cache, exceptions and cancellations are not cached.
+  ///
+  /// The lookup is deferred until the returned continuable is started,
+  /// such that the hits and misses only count lookups which were started.
+  ///
+  /// \since 4.3.0
+  template <typename Loader>
+  continuable<Value> get(Key key, Loader&& loader) {
+    return make_continuable<Value>(
+        [this, key = std::move(key),
+         loader = std::forward<Loader>(loader)](auto&& promise) mutable {
+          auto cached = shard_of(key).lookup(key, Clock::now());
+          if (cached.is_value()) {
+            promise.set_value(std::move(cached).get_value());
+            return;
+          }
+
+          flights_
+              .get(key,
+                   [this, key, loader = std::move(loader)]() mutable {
+                     return detail::util::invoke(loader).then(
+                         [this, key](Value value) {
+                           insert(key, value);
+                           return value;
+                         });
+                   })
+              .next(std::forward<decltype(promise)>(promise));
+        });
+  }
+
+  /// Inserts or replaces the value of the given key
+  ///
+  /// Values which are heavier than shard_budget() are not cached,
+  /// while a previous value of the key is removed anyway.
+  ///
+  /// \since 4.3.0
+  template <typename V>
+  void insert(Key const& key, V&& value) {
+    std::size_t const weight = weigher_(key, value);
+    shard_of(key).insert(
+        key, std::forward<V>(value),
+        detail::operations::expiry_of<Clock>(Clock::now(), ttl_), weight,
+        shard_budget_);
+  }
+
+  /// Removes the entry of the given key and returns true if it was present
+  ///
+  /// \since 4.3.0
+  bool erase(Key const& key) {
+    return shard_of(key).erase(key);
+  }
+
+  /// Removes all entries from the cache, the counters are preserved
+  ///
+  /// \since 4.3.0
+  void clear() {
+    for (auto& shard : shards_) {
+      shard.clear();
+    }
+  }
+
+  /// Returns a snapshot of the counters accumulated over all shards
+  ///
+  /// \since 4.3.0
+  cache_stats stats() const {
+    cache_stats stats;
+    for (auto const& shard : shards_) {
+      shard.accumulate(stats);
+    }
+    return stats;
+  }
+
+private:
+  shard_t& shard_of(Key const& key) {
+    return shards_[hash_(key) % Shards];
+  }
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_ASYNC_CACHE_HPP_INCLUDED
@@ -0,0 +1,350 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_BLOCKING_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_BLOCKING_HPP_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-statistics.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/operations/shard-context.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+#include <continuable/operations/async.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// A snapshot of the state of a blocking_pool
+///
+/// \since 4.3.0
+struct blocking_pool_metrics {
+  /// The count of threads which are alive
+  std::size_t threads;
+  /// The count of threads which wait for work
+  std::size_t idle_threads;
+  /// The largest count of threads which were alive at the same time
+  std::size_t peak_threads;
+  /// The count of work which waits for a thread
+  std::size_t pending;
+  /// The count of work which was started
+  std::size_t started;
+  /// The accumulated time the started work waited for a thread
+  std::chrono::nanoseconds total_wait;
+  /// The longest time a started work waited for a thread
+  std::chrono::nanoseconds max_wait;
+};
+
+/// A pool of threads which runs blocking work, such as calls to blocking
+/// system APIs, outside of the executors which run the continuations.
+///
+/// The pool starts a new thread for every work which doesn't find an idle
+/// thread until the maximal count of threads is reached, afterwards the work
+/// waits for a thread. Threads which are idle for longer than the idle
+/// timeout are stopped again:
+/// ```cpp
+/// cti::blocking_pool pool(16, std::chrono::seconds(10));
+///
+/// pool.run([] { return ::fsync(fd); }, my_executor)
+///   .then([](int result) {
+///     // Resumed on my_executor
+///   });
+/// ```
+///
+/// Work which is pending while the blocking_pool is destroyed,
+/// or which is posted afterwards, is resolved as cancelled.
+///
+/// \since 4.3.0
+class blocking_pool {
+public:
+  using clock = std::chrono::steady_clock;
+
+  /// An executor which submits the work to the blocking_pool
+  class executor {
+  public:
+    explicit executor(blocking_pool* owner) noexcept : owner_(owner) {
+    }
+
+    template <typename Work>
+    void operator()(Work&& item) const {
+      owner_->post(std::forward<Work>(item));
+    }
+
+  private:
+    blocking_pool* owner_;
+  };
+
+  /// Creates a pool which starts up to the given count of threads
+  explicit blocking_pool(std::size_t max_threads = default_max_threads(),
+                         clock::duration idle_timeout = std::chrono::seconds(
+                             10))
+      : max_threads_(std::max(max_threads, std::size_t(1U))),
+        idle_timeout_(idle_timeout) {
+  }
+
+  ~blocking_pool() {
+    std::deque<pending_work> pending;
+    {
+      std::unique_lock<std::mutex> lock(lock_);
+      stopped_ = true;
+      pending.swap(queue_);
+      condition_.notify_all();
+
+      // Wait for the threads which still run work
+      stopped_condition_.wait(lock, [&] { return threads_ == 0U; });
+    }
+    join_exited();
+
+    for (auto& current : pending) {
+      std::move(current.item)(exception_arg_t{}, exception_t{});
+    }
+  }
+
+  blocking_pool(blocking_pool const&) = delete;
+  blocking_pool(blocking_pool&&) = delete;
+  blocking_pool& operator=(blocking_pool const&) = delete;
+  blocking_pool& operator=(blocking_pool&&) = delete;
+
+  /// Returns an executor which runs the work on the blocking_pool
+  executor get() noexcept {
+    return executor(this);
+  }
+
+  /// Returns a continuable_base which invokes the callable on the
+  /// blocking_pool and continues through the given executor.
+  template <typename Callable, typename Executor>
+  auto run(Callable&& callable, Executor&& resume) {
+    return async_on(std::forward<Callable>(callable), get())
+        .via(std::forward<Executor>(resume));
+  }
+
+  /// Returns a continuable_base which invokes the callable on the
+  /// blocking_pool and continues on the core of the shard::runtime
+  /// which run is called from.
+  ///
+  /// When run is called from outside of a shard::runtime,
+  /// the continuation is invoked on the thread of the blocking_pool.
+  template <typename Callable>
+  auto run(Callable&& callable) {
+    return run(std::forward<Callable>(callable),
+               detail::shard::resume_executor{});
+  }
+
+  /// Returns a snapshot of the metrics of the blocking_pool
+  blocking_pool_metrics metrics() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return {threads_, idle_threads_, peak_threads_, queue_.size(), started_,
+            total_wait_, max_wait_};
+  }
+
+  /// Returns a snapshot of the metrics of the single queue of the pool,
+  /// which is empty unless `CONTINUABLE_WITH_EXECUTOR_METRICS` is defined.
+  ///
+  /// The threads are started and stopped on demand, therefore
+  /// their counters are merged into a single worker.
+  executor_metrics snapshot() const {
+    executor_metrics metrics;
+    if (detail::metrics::enabled) {
+      std::lock_guard<std::mutex> guard(lock_);
+      metrics.queues.push_back(queue_recorder_.snapshot());
+      metrics.workers.push_back(worker_recorder_.snapshot());
+    }
+    return metrics;
+  }
+
+private:
+  struct pending_work {
+    clock::time_point submitted;
+    work item;
+  };
+
+  static std::size_t default_max_threads() noexcept {
+    std::size_t const threads = std::thread::hardware_concurrency();
+    return std::max(threads * 4U, std::size_t(16U));
+  }
+
+  void post(work item) {
+    join_exited();
+
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (!stopped_) {
+        queue_.push_back(pending_work{clock::now(), std::move(item)});
+        queue_recorder_.enqueued();
+
+        if (idle_threads_ >= queue_.size()) {
+          condition_.notify_one();
+        } else if (threads_ < max_threads_) {
+          ++threads_;
+          peak_threads_ = std::max(peak_threads_, threads_);
+          workers_.emplace_back();
+          auto current = std::prev(workers_.end());
+          *current = std::thread([this, current] { run_worker(current); });
+        }
+        return;
+      }
+    }
+
+    // Work which is posted by the running work while the pool is destroyed
+    // would never be picked up by a thread, therefore it is cancelled.
+    std::move(item)(exception_arg_t{}, exception_t{});
+  }
+
+  void run_worker(std::list<std::thread>::iterator self) {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+      if (queue_.empty() && !stopped_) {
+        ++idle_threads_;
+        bool woken;
+        {
+          detail::metrics::worker_recorder::idle_scope idle(worker_recorder_);
+          woken = condition_.wait_for(lock, idle_timeout_, [&] {
+            return stopped_ || !queue_.empty();
+          });
+        }
+        --idle_threads_;
+
+        if (!woken) {
+          break;
+        }
+      }
+      if (stopped_) {
+        break;
+      }
+
+      pending_work current = std::move(queue_.front());
+      queue_.pop_front();
+
+      auto const waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          clock::now() - current.submitted);
+      ++started_;
+      total_wait_ += waited;
+      max_wait_ = std::max(max_wait_, waited);
+      queue_recorder_.dequeued();
+      worker_recorder_.started(waited);
+
+      lock.unlock();
+      std::move(current.item)();
+      lock.lock();
+    }
+
+    // The thread is joined by the next post or the destructor
+    exited_.splice(exited_.end(), workers_, self);
+    --threads_;
+    if (stopped_ && (threads_ == 0U)) {
+      stopped_condition_.notify_all();
+    }
+  }
+
+  void join_exited() {
+    std::list<std::thread> exited;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      exited.swap(exited_);
+    }
+    for (auto& thread : exited) {
+      thread.join();
+    }
+  }
+
+  std::size_t const max_threads_;
+  clock::duration const idle_timeout_;
+
+  mutable std::mutex lock_;
+  std::condition_variable condition_;
+  std::condition_variable stopped_condition_;
+  std::deque<pending_work> queue_;
+  std::list<std::thread> workers_;
+  std::list<std::thread> exited_;
+  std::size_t threads_ = 0U;
+  std::size_t idle_threads_ = 0U;
+  std::size_t peak_threads_ = 0U;
+  std::size_t started_ = 0U;
+  std::chrono::nanoseconds total_wait_{0};
+  std::chrono::nanoseconds max_wait_{0};
+  bool stopped_ = false;
+
+  /// The recorders are written while the lock is held
+  detail::metrics::queue_recorder queue_recorder_;
+  detail::metrics::worker_recorder worker_recorder_;
+};
+
+/// Returns the blocking_pool which is used by cti::blocking
+///
+/// \since 4.3.0
+inline blocking_pool& default_blocking_pool() {
+  static blocking_pool pool;
+  return pool;
+}
+
+/// Returns a continuable_base which invokes the blocking callable on the
+/// default blocking_pool and continues through the given executor.
+///
+/// This keeps the executors which run the continuations free of blocking
+/// calls:
+/// ```cpp
+/// cti::blocking([host] { return resolve_host(host); }, my_executor)
+///   .then([](address resolved) {
+///     // Resumed on my_executor
+///   });
+/// ```
+///
+/// \since 4.3.0
+template <typename Callable, typename Executor>
+auto blocking(Callable&& callable, Executor&& resume) {
+  return default_blocking_pool().run(std::forward<Callable>(callable),
+                                     std::forward<Executor>(resume));
+}
+
+/// Returns a continuable_base which invokes the blocking callable on the
+/// default blocking_pool and continues on the core of the shard::runtime
+/// blocking is called from.
+///
+/// When blocking is called from outside of a shard::runtime,
+/// the continuation is invoked on the thread of the blocking_pool.
+///
+/// \since 4.3.0
+template <typename Callable>
+auto blocking(Callable&& callable) {
+  return default_blocking_pool().run(std::forward<Callable>(callable));
+}
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_BLOCKING_HPP_INCLUDED
@@ -0,0 +1,120 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_HEDGE_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_HEDGE_HPP_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <continuable/detail/operations/hedge.hpp>
+#include <continuable/detail/utility/traits.hpp>
+#include <continuable/operations/timer-queue.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// Hedges an asynchronous operation by starting a backup attempt when the
+/// previous attempt hasn't completed within the given delay.
+///
+/// The factory is invoked with no arguments for every attempt and returns a
+/// cti::continuable_base. The first attempt is started immediately, every
+/// further attempt is started when the delay elapsed without any attempt
+/// succeeding, or immediately when an attempt resolved with an exception.
+/// The returned continuable_base resolves with the first successful attempt,
+/// the attempts which are still running then are abandoned and their
+/// results are dropped. This cuts the tail latency of operations which are
+/// slow only occasionally for the price of a few additional requests:
+/// ```cpp
+/// cti::hedge(std::chrono::milliseconds(5), [] {
+///   return http_request("example.com");
+/// }).then([](std::string response) {
+///   // ...
+/// });
+/// ```
+///
+/// The delay is waited for through the timer, which is invoked with a
+/// `std::chrono::nanoseconds` delay and returns a continuable_base which
+/// resolves after the delay. At most one timer is pending per hedged
+/// operation and no thread is blocked while waiting.
+/// When the timer resolves with an exception or a cancellation, no further
+/// attempts are started.
+///
+/// When all attempts failed, the exception of the last failed attempt is
+/// propagated, the operation is cancelled when all attempts were cancelled.
+///
+/// \param delay The time after which the next attempt is started
+///
+/// \param timer The timer used to wait for the delay
+///
+/// \param factory The callable which starts a single attempt
+///
+/// \param max_attempts The count of attempts including the first one
+///
+/// \attention The abandoned attempts aren't cancelled, therefore the
+///            operation must be safe to be executed multiple times.
+///            The state of the operation is kept alive until the last
+///            attempt and the pending timer completed.
+///
+/// \since 4.3.0
+///
+template <typename Rep, typename Period, typename Timer, typename Factory,
+          std::enable_if_t<detail::traits::is_invocable<
+              detail::traits::unrefcv_t<Factory>&>::value>* = nullptr>
+auto hedge(std::chrono::duration<Rep, Period> delay, Timer&& timer,
+           Factory&& factory, std::size_t max_attempts = 2) {
+  return detail::operations::hedge(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(delay),
+      std::forward<Timer>(timer), std::forward<Factory>(factory),
+      max_attempts);
+}
+
+/// Hedges an asynchronous operation with the delay waited for on the
+/// cti::default_timer_queue.
+///
+/// See the overload above for details.
+///
+/// \since 4.3.0
+template <typename Rep, typename Period, typename Factory>
+auto hedge(std::chrono::duration<Rep, Period> delay, Factory&& factory,
+           std::size_t max_attempts = 2) {
+  return detail::operations::hedge(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(delay),
+      [](std::chrono::nanoseconds wait) {
+        return default_timer_queue().wait_for(wait);
+      },
+      std::forward<Factory>(factory), max_attempts);
+}
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_HEDGE_HPP_INCLUDED
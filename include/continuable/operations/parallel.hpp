@@ -0,0 +1,185 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_PARALLEL_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_PARALLEL_HPP_INCLUDED
+
+#include <cstddef>
+#include <utility>
+#include <continuable/detail/operations/parallel.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// Invokes the given function for every element of the given range
+/// through the given executor.
+///
+/// The range is split into chunks which are submitted to the executor
+/// as a single work each, instead of submitting a work per element:
+/// ```cpp
+/// std::vector<float> values(1 << 20);
+///
+/// cti::parallel_for(pool, values, 4096, [](float& value) {
+///   value *= 2.f;
+/// }).then([] {
+///   // All elements were processed
+/// });
+/// ```
+///
+/// A range is split into a few chunks per hardware thread
+/// such that the executor can balance chunks of uneven cost.
+///
+/// \param executor The executor every chunk is submitted to,
+///                 with the same requirements as an executor which is
+///                 passed to continuable_base::then.
+///
+/// \param range The random access range which is processed,
+///              it has to outlive the returned continuable_base.
+///
+/// \param grain The minimal count of elements a chunk covers,
+///              choose it large enough such that submitting a work
+///              to the executor is cheap compared to processing the chunk.
+///
+/// \param function The function which is invoked with every element,
+///                 it is invoked concurrently from multiple chunks.
+///
+/// \returns A continuable_base<> which resolves when all chunks were
+///          processed. If the function throws or a chunk is resolved
+///          with an exception by the executor, the remaining chunks are
+///          skipped and the first exception is forwarded.
+///          A chunk which is dropped by the executor cancels
+///          the continuable_base.
+///
+/// \since 4.3.0
+///
+template <typename Executor, typename Range, typename Function>
+auto parallel_for(Executor&& executor, Range&& range, std::size_t grain,
+                  Function&& function) {
+  return detail::operations::parallel::parallel_for(
+      std::forward<Executor>(executor), std::forward<Range>(range), grain,
+      std::forward<Function>(function));
+}
+
+/// Writes the result of the given function for every element of the input
+/// range to the element at the same position of the output range,
+/// the elements are processed through the given executor.
+///
+/// The output is assigned in place, therefore it has to provide at least
+/// as many elements as the input:
+/// ```cpp
+/// std::vector<int> input = get_input();
+/// std::vector<int> output(input.size());
+///
+/// cti::parallel_transform(pool, input, output, 4096, [](int value) {
+///   return value * value;
+/// });
+/// ```
+///
+/// The range is chunked in the same way as by cti::parallel_for.
+///
+/// \param executor The executor every chunk is submitted to.
+///
+/// \param input The random access range which is read from.
+///
+/// \param output The random access range which is assigned to.
+///
+/// \param grain The minimal count of elements a chunk covers.
+///
+/// \param function The function which is invoked with every element
+///                 of the input, it is invoked concurrently
+///                 from multiple chunks.
+///
+/// \returns A continuable_base<> which resolves when all elements
+///          were assigned, errors are handled as by cti::parallel_for.
+///
+/// \since 4.3.0
+///
+template <typename Executor, typename InputRange, typename OutputRange,
+          typename Function>
+auto parallel_transform(Executor&& executor, InputRange&& input,
+                        OutputRange&& output, std::size_t grain,
+                        Function&& function) {
+  return detail::operations::parallel::parallel_transform(
+      std::forward<Executor>(executor), std::forward<InputRange>(input),
+      std::forward<OutputRange>(output), grain,
+      std::forward<Function>(function));
+}
+
+/// Reduces the elements of the given range through the given operation,
+/// the elements are processed through the given executor.
+///
+/// Every chunk is folded on its own, afterwards the partial results of
+/// neighbouring chunks are combined in a binary tree as soon as both of them
+/// are available. Thus the partial results are never collected into
+/// a container and no serial fold is required after the last chunk:
+/// ```cpp
+/// std::vector<std::uint64_t> values = get_values();
+///
+/// cti::parallel_reduce(pool, values, std::uint64_t(0), std::plus<>{}, 4096)
+///   .then([](std::uint64_t sum) {
+///     // ...
+///   });
+/// ```
+///
+/// The left partial result is always passed as first argument to the
+/// operation and init is combined with the result of the whole range last,
+/// therefore the operation is required to be associative
+/// but not to be commutative.
+///
+/// \param executor The executor every chunk is submitted to.
+///
+/// \param range The random access range which is reduced, its elements
+///              have to be convertible to the type of init.
+///
+/// \param init The initial value which is the result of an empty range.
+///
+/// \param operation The associative operation which is invoked with two
+///                  partial results or a partial result and an element,
+///                  it is invoked concurrently from multiple chunks.
+///
+/// \param grain The minimal count of elements a chunk covers.
+///
+/// \returns A continuable_base<T> which resolves with the reduced value,
+///          errors are handled as by cti::parallel_for.
+///
+/// \since 4.3.0
+///
+template <typename Executor, typename Range, typename T, typename Operation>
+auto parallel_reduce(Executor&& executor, Range&& range, T&& init,
+                     Operation&& operation, std::size_t grain) {
+  return detail::operations::parallel::parallel_reduce(
+      std::forward<Executor>(executor), std::forward<Range>(range),
+      std::forward<T>(init), std::forward<Operation>(operation), grain);
+}
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_PARALLEL_HPP_INCLUDED
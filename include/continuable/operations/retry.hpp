@@ -0,0 +1,139 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_RETRY_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_RETRY_HPP_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <continuable/detail/operations/retry.hpp>
+#include <continuable/operations/timer-queue.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// Describes how often and how delayed an operation is retried
+/// by cti::retry.
+///
+/// The delay before the n-th retry is `initial_delay * multiplier^(n - 1)`
+/// limited to `max_delay`, from which a random part of up to
+/// `jitter * delay` is subtracted.
+///
+/// \since 4.3.0
+struct retry_policy {
+  /// The count of attempts including the first one
+  std::size_t max_attempts = 3;
+  /// The delay before the first retry
+  std::chrono::nanoseconds initial_delay = std::chrono::milliseconds(10);
+  /// The upper limit of the delay between two attempts
+  std::chrono::nanoseconds max_delay = std::chrono::seconds(1);
+  /// The factor the delay is multiplied with after each retry
+  double multiplier = 2.0;
+  /// The fraction of the delay which is randomized, in the range [0, 1]
+  double jitter = 0.5;
+  /// The time after the first attempt after which no retry is started
+  std::chrono::nanoseconds deadline = std::chrono::nanoseconds::max();
+};
+
+/// Retries an asynchronous operation until it succeeds, or until the
+/// attempts or the deadline of the policy are exhausted.
+///
+/// The factory is invoked with no arguments for every attempt and returns a
+/// cti::continuable_base. An attempt is retried when it resolves with an
+/// exception, cancellations are propagated immediately.
+/// When no attempts are left, the exception of the last attempt is
+/// propagated to the returned continuable_base.
+/// ```cpp
+/// cti::retry_policy policy;
+/// policy.max_attempts = 5;
+/// policy.deadline = std::chrono::seconds(2);
+///
+/// cti::retry(policy, [] {
+///   return http_request("example.com");
+/// }).then([](std::string response) {
+///   // ...
+/// });
+/// ```
+///
+/// The delays between attempts are waited for through the timer, which is
+/// invoked with a `std::chrono::nanoseconds` delay and returns a
+/// continuable_base which resolves after the delay. No thread is blocked
+/// while waiting:
+/// ```cpp
+/// asio::steady_timer timer(context);
+///
+/// cti::retry(policy,
+///            [&](std::chrono::nanoseconds delay) {
+///              timer.expires_after(delay);
+///              return timer.async_wait(cti::use_continuable);
+///            },
+///            [] { return http_request("example.com"); });
+/// ```
+/// When the timer resolves with an exception or a cancellation, the
+/// exception of the last attempt is propagated.
+///
+/// The state of the retry is allocated once and reused across all attempts.
+///
+/// \param policy The cti::retry_policy which limits the attempts
+///
+/// \param timer The timer used to wait between attempts
+///
+/// \param factory The callable which starts a single attempt
+///
+/// \since 4.3.0
+///
+template <typename Timer, typename Factory>
+auto retry(retry_policy policy, Timer&& timer, Factory&& factory) {
+  return detail::operations::retry(std::move(policy),
+                                   std::forward<Timer>(timer),
+                                   std::forward<Factory>(factory));
+}
+
+/// Retries an asynchronous operation with the delays waited for on the
+/// cti::default_timer_queue.
+///
+/// See the overload above for details.
+///
+/// \since 4.3.0
+template <typename Factory>
+auto retry(retry_policy policy, Factory&& factory) {
+  return detail::operations::retry(
+      std::move(policy),
+      [](std::chrono::nanoseconds delay) {
+        return default_timer_queue().wait_for(delay);
+      },
+      std::forward<Factory>(factory));
+}
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_RETRY_HPP_INCLUDED
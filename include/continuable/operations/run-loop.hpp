@@ -0,0 +1,296 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_RUN_LOOP_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_RUN_LOOP_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <continuable/continuable-statistics.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/operations/run-loop.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// A single threaded event loop which runs the work submitted to its
+/// executor from arbitrary threads on the thread which runs the loop.
+///
+/// The work is linked into a lock-free inbox and drained by the loop
+/// in batches. A loop without work sleeps until new work arrives:
+/// ```cpp
+/// cti::run_loop loop;
+///
+/// cti::async_on([] { return read_file(); }, pool)
+///   .then([](std::string content) {
+///     // Runs on the thread which runs the loop
+///   }, loop.get());
+///
+/// loop.run();
+/// ```
+///
+/// Work which is pending while the run_loop is destroyed
+/// is resolved as cancelled.
+///
+/// \since 4.3.0
+class run_loop {
+public:
+  using clock = std::chrono::steady_clock;
+
+  /// An executor which submits the work to the run_loop
+  class executor {
+  public:
+    explicit executor(run_loop* owner) noexcept : owner_(owner) {
+    }
+
+    template <typename Work>
+    void operator()(Work&& item) const {
+      owner_->post(std::forward<Work>(item));
+    }
+
+  private:
+    run_loop* owner_;
+  };
+
+  run_loop() = default;
+
+  ~run_loop() {
+    cancel(batch_);
+    while (detail::event_loop::node* pending = inbox_.take_all()) {
+      cancel(pending);
+    }
+  }
+
+  run_loop(run_loop const&) = delete;
+  run_loop(run_loop&&) = delete;
+  run_loop& operator=(run_loop const&) = delete;
+  run_loop& operator=(run_loop&&) = delete;
+
+  /// Returns an executor which runs the work on the run_loop
+  executor get() noexcept {
+    return executor(this);
+  }
+
+  /// Runs the work of the loop until stop is called,
+  /// returns the count of work which was run.
+  std::size_t run() {
+    return run_until(clock::time_point::max(), unlimited());
+  }
+
+  /// Runs a single work and waits for it if none is pending,
+  /// returns the count of work which was run.
+  std::size_t run_one() {
+    return run_until(clock::time_point::max(), 1U);
+  }
+
+  /// Runs the work of the loop until the duration elapsed or stop is called,
+  /// returns the count of work which was run.
+  template <typename Rep, typename Period>
+  std::size_t run_for(std::chrono::duration<Rep, Period> const& duration) {
+    return run_until(clock::now() +
+                         std::chrono::duration_cast<clock::duration>(duration),
+                     unlimited());
+  }
+
+  /// Runs the pending work without waiting for new work,
+  /// returns the count of work which was run.
+  std::size_t poll() {
+    detail::event_loop::running_scope running(this);
+    std::size_t count = 0U;
+    while (detail::event_loop::node* current = next()) {
+      invoke(current);
+      ++count;
+    }
+    return count;
+  }
+
+  /// Returns a snapshot of the metrics of the single queue and thread
+  /// of the loop, which is empty unless `CONTINUABLE_WITH_EXECUTOR_METRICS`
+  /// is defined.
+  executor_metrics snapshot() const {
+    executor_metrics metrics;
+    if (detail::metrics::enabled) {
+      metrics.queues.push_back(queue_recorder_.snapshot(enqueued()));
+      metrics.workers.push_back(worker_recorder_.snapshot());
+    }
+    return metrics;
+  }
+
+  /// Makes the current or the next call to a run method return
+  /// after the work it currently runs, can be called from any thread.
+  void stop() noexcept {
+    stopped_.store(true, std::memory_order_relaxed);
+    wake();
+  }
+
+private:
+  static constexpr std::size_t unlimited() noexcept {
+    return std::numeric_limits<std::size_t>::max();
+  }
+
+  void post(work item) {
+    if (detail::metrics::enabled) {
+      // Work which the loop posts to itself is counted without a
+      // read-modify-write on the counter shared by all other threads.
+      if (detail::event_loop::this_loop() == this) {
+        local_sent_.enqueued();
+      } else {
+        external_sent_.enqueued();
+      }
+    }
+    inbox_.push(new detail::event_loop::node(std::move(item)));
+    wake();
+  }
+
+  /// Returns the count of work which was posted to the loop
+  std::uint64_t enqueued() const noexcept {
+    return local_sent_.count() + external_sent_.count();
+  }
+
+  /// Signals the loop if it is sleeping
+  void wake() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) &&
+        sleeping_.exchange(false, std::memory_order_acq_rel)) {
+      wakeup_.signal();
+    }
+  }
+
+  std::size_t run_until(clock::time_point deadline, std::size_t limit) {
+    detail::event_loop::running_scope running(this);
+    std::size_t count = 0U;
+    while (count != limit) {
+      if (stopped_.load(std::memory_order_relaxed) &&
+          stopped_.exchange(false, std::memory_order_acquire)) {
+        break;
+      }
+
+      if (detail::event_loop::node* current = next()) {
+        invoke(current);
+        ++count;
+      } else if (!sleep_until(deadline)) {
+        break;
+      }
+    }
+    return count;
+  }
+
+  /// Returns the next node of the current batch,
+  /// takes a new batch out of the inbox when the current one was run.
+  detail::event_loop::node* next() noexcept {
+    if (!batch_) {
+      batch_ = inbox_.take_all();
+      if (!batch_) {
+        return nullptr;
+      }
+      if (detail::metrics::enabled) {
+        queue_recorder_.observed(enqueued());
+      }
+    }
+
+    detail::event_loop::node* current = batch_;
+    batch_ = current->next;
+    return current;
+  }
+
+  void invoke(detail::event_loop::node* current) {
+    queue_recorder_.dequeued();
+    worker_recorder_.started(*current);
+
+    work item = std::move(current->item);
+    delete current;
+    std::move(item)();
+  }
+
+  /// Sleeps until work arrives, returns false if the deadline was reached
+  bool sleep_until(clock::time_point deadline) {
+    // The count of rounds the loop yields before it sleeps
+    constexpr std::size_t spin_rounds = 64U;
+    for (std::size_t round = 0U; round != spin_rounds; ++round) {
+      if (inbox_.has_work() || stopped_.load(std::memory_order_relaxed)) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    if (clock::now() >= deadline) {
+      return false;
+    }
+
+    sleeping_.store(true, std::memory_order_seq_cst);
+    if (inbox_.has_work() || stopped_.load(std::memory_order_seq_cst)) {
+      sleeping_.store(false, std::memory_order_relaxed);
+      return true;
+    }
+
+    {
+      detail::metrics::worker_recorder::idle_scope idle(worker_recorder_);
+      wakeup_.wait_until(deadline);
+    }
+    sleeping_.store(false, std::memory_order_relaxed);
+    return clock::now() < deadline;
+  }
+
+  static void cancel(detail::event_loop::node* current) {
+    while (current) {
+      detail::event_loop::node* next = current->next;
+      std::move(current->item)(exception_arg_t{}, exception_t{});
+      delete current;
+      current = next;
+    }
+  }
+
+  detail::event_loop::inbox inbox_;
+
+  /// The state which is only accessed by the thread running the loop,
+  /// except for the wakeup.
+  detail::event_loop::node* batch_ = nullptr;
+  std::atomic<bool> sleeping_{false};
+  std::atomic<bool> stopped_{false};
+  detail::event_loop::wakeup wakeup_;
+
+  /// Counts the work the loop posts to itself,
+  /// only written by the thread running the loop.
+  detail::metrics::sender_recorder local_sent_;
+  /// Counts the work posted from all other threads
+  detail::metrics::shared_sender_recorder external_sent_;
+  detail::metrics::receiver_recorder queue_recorder_;
+  detail::metrics::worker_recorder worker_recorder_;
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_RUN_LOOP_HPP_INCLUDED
@@ -0,0 +1,308 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_SCHEDULER_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_SCHEDULER_HPP_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-statistics.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/operations/scheduler.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// The scheduling class of a chain which is submitted to
+/// a deadline_scheduler.
+///
+/// \since 4.3.0
+using priority = detail::scheduling::priority;
+
+/// Returns a transform which tags the remaining chain with the given
+/// scheduling class.
+///
+/// Every work the chain submits to a deadline_scheduler afterwards is
+/// scheduled with the class, including the work which is submitted from
+/// continuations that run on the deadline_scheduler:
+/// ```cpp
+/// http_request("example.com")
+///   .apply(cti::with_priority(cti::priority::interactive))
+///   .then(render, scheduler.get())
+///   .then(respond, scheduler.get());
+/// ```
+///
+/// \attention The tag is kept by the thread which continues the chain,
+///            a chain which is resumed from a thread outside of the
+///            deadline_scheduler, for instance by an asynchronous
+///            operation, has to be tagged again.
+///
+/// \since 4.3.0
+inline auto with_priority(priority level) {
+  return [level](auto&& continuable) {
+    return std::forward<decltype(continuable)>(continuable)
+        .via(detail::scheduling::context_executor{
+            detail::scheduling::context::of(level)});
+  };
+}
+
+/// Returns a transform which tags the remaining chain with the given
+/// deadline, the tag is inherited in the same way as by cti::with_priority.
+///
+/// \since 4.3.0
+inline auto with_deadline(std::chrono::steady_clock::time_point deadline) {
+  return [deadline](auto&& continuable) {
+    return std::forward<decltype(continuable)>(continuable)
+        .via(detail::scheduling::context_executor{
+            detail::scheduling::context::until(deadline)});
+  };
+}
+
+/// The time a deadline_scheduler permits the work of a scheduling class
+/// to wait until it is due.
+///
+/// \since 4.3.0
+struct priority_budgets {
+  std::chrono::steady_clock::duration interactive =
+      std::chrono::milliseconds(1);
+  std::chrono::steady_clock::duration normal = std::chrono::milliseconds(10);
+  std::chrono::steady_clock::duration batch = std::chrono::milliseconds(100);
+};
+
+/// A pool of threads which runs the work with the earliest deadline first.
+///
+/// Work which is submitted with a scheduling class is due after the
+/// budget of its class elapsed, work which is tagged with a deadline
+/// is due at the deadline. Since the work of the lower classes becomes
+/// due eventually, it is never starved by the work of higher classes:
+/// ```cpp
+/// cti::deadline_scheduler scheduler(4);
+///
+/// cti::async_on(compact_storage, scheduler.get(cti::priority::batch));
+///
+/// request.apply(cti::with_priority(cti::priority::interactive))
+///        .then(handle_request, scheduler.get());
+/// ```
+///
+/// Work which is pending while the deadline_scheduler is destroyed
+/// is resolved as cancelled.
+///
+/// \since 4.3.0
+class deadline_scheduler {
+public:
+  using clock = std::chrono::steady_clock;
+
+  /// An executor which submits the work to the deadline_scheduler,
+  /// which is usable with continuable_base::then.
+  class executor {
+  public:
+    executor(deadline_scheduler* owner,
+             detail::scheduling::context tagged) noexcept
+        : owner_(owner), tagged_(tagged) {
+    }
+
+    template <typename Work>
+    void operator()(Work&& item) const {
+      owner_->post(tagged_, std::forward<Work>(item));
+    }
+
+  private:
+    deadline_scheduler* owner_;
+    detail::scheduling::context tagged_;
+  };
+
+  /// Starts the given count of threads
+  explicit deadline_scheduler(std::size_t threads = default_threads(),
+                              priority_budgets budgets = {})
+      : budgets_(budgets) {
+    workers_.reserve(threads);
+    for (std::size_t i = 0U; i != threads; ++i) {
+      workers_.emplace_back(
+          std::make_unique<detail::metrics::worker_recorder>());
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0U; i != threads; ++i) {
+      threads_.emplace_back([this, i] { run(*workers_[i]); });
+    }
+  }
+
+  ~deadline_scheduler() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stopped_ = true;
+    }
+    condition_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+
+    // Cancelling the work may submit further work to the scheduler
+    while (true) {
+      std::vector<detail::scheduling::entry> pending;
+      {
+        std::lock_guard<std::mutex> guard(lock_);
+        pending.swap(queue_);
+      }
+      if (pending.empty()) {
+        break;
+      }
+      for (auto& current : pending) {
+        std::move(current.item)(exception_arg_t{}, exception_t{});
+      }
+    }
+  }
+
+  deadline_scheduler(deadline_scheduler const&) = delete;
+  deadline_scheduler(deadline_scheduler&&) = delete;
+  deadline_scheduler& operator=(deadline_scheduler const&) = delete;
+  deadline_scheduler& operator=(deadline_scheduler&&) = delete;
+
+  /// Returns an executor which schedules the work with the class or deadline
+  /// the current chain is tagged with, untagged work has the normal class.
+  executor get() noexcept {
+    return executor(this, detail::scheduling::context::none());
+  }
+  /// Returns an executor which schedules the work with the given class
+  executor get(priority level) noexcept {
+    return executor(this, detail::scheduling::context::of(level));
+  }
+  /// Returns an executor which schedules the work with the given deadline
+  executor get(clock::time_point deadline) noexcept {
+    return executor(this, detail::scheduling::context::until(deadline));
+  }
+
+  /// Returns a snapshot of the metrics of the single queue and the threads
+  /// of the scheduler, which is empty unless
+  /// `CONTINUABLE_WITH_EXECUTOR_METRICS` is defined.
+  executor_metrics snapshot() const {
+    executor_metrics metrics;
+    if (detail::metrics::enabled) {
+      metrics.queues.push_back(queue_recorder_.snapshot());
+      for (auto const& worker : workers_) {
+        metrics.workers.push_back(worker->snapshot());
+      }
+    }
+    return metrics;
+  }
+
+private:
+  using kind = detail::scheduling::context::kind;
+
+  static std::size_t default_threads() noexcept {
+    std::size_t const threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1U;
+  }
+
+  clock::duration budget_of(priority level) const noexcept {
+    switch (level) {
+      case priority::interactive:
+        return budgets_.interactive;
+      case priority::batch:
+        return budgets_.batch;
+      default:
+        return budgets_.normal;
+    }
+  }
+
+  void post(detail::scheduling::context tagged, work item) {
+    if (tagged.type == kind::none) {
+      tagged = detail::scheduling::current_context();
+      if (tagged.type == kind::none) {
+        tagged = detail::scheduling::context::of(priority::normal);
+      }
+    }
+
+    clock::time_point const deadline = (tagged.type == kind::deadline)
+                                           ? tagged.deadline
+                                           : clock::now() +
+                                                 budget_of(tagged.level);
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      queue_.emplace_back(deadline, sequence_++, tagged, std::move(item));
+      queue_recorder_.enqueued();
+      std::push_heap(queue_.begin(), queue_.end(),
+                     detail::scheduling::later_deadline{});
+    }
+    condition_.notify_one();
+  }
+
+  void run(detail::metrics::worker_recorder& recorder) {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+      if (!stopped_ && queue_.empty()) {
+        detail::metrics::worker_recorder::idle_scope idle(recorder);
+        condition_.wait(lock, [&] { return stopped_ || !queue_.empty(); });
+      }
+      if (stopped_) {
+        return;
+      }
+
+      std::pop_heap(queue_.begin(), queue_.end(),
+                    detail::scheduling::later_deadline{});
+      detail::scheduling::entry current = std::move(queue_.back());
+      queue_.pop_back();
+      queue_recorder_.dequeued();
+
+      lock.unlock();
+      recorder.started(current);
+      {
+        // The work submitted from the continuation inherits the tag
+        detail::scheduling::context_guard guard(current.tagged);
+        std::move(current.item)();
+      }
+      lock.lock();
+    }
+  }
+
+  priority_budgets budgets_;
+  std::mutex lock_;
+  std::condition_variable condition_;
+  std::vector<detail::scheduling::entry> queue_;
+  std::uint64_t sequence_ = 0U;
+  bool stopped_ = false;
+  /// The queue recorder is written while the lock is held
+  detail::metrics::queue_recorder queue_recorder_;
+  std::vector<std::unique_ptr<detail::metrics::worker_recorder>> workers_;
+  std::vector<std::thread> threads_;
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_SCHEDULER_HPP_INCLUDED
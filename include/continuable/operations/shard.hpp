@@ -0,0 +1,508 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_SHARD_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_SHARD_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-statistics.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/operations/shard.hpp>
+#include <continuable/detail/other/executor-metrics.hpp>
+#include <continuable/operations/async.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// Provides a share nothing runtime with a single thread per core.
+///
+/// \since 4.3.0
+namespace shard {
+/// Is returned by current_core when the current thread isn't a core
+/// of a runtime.
+///
+/// \since 4.3.0
+constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+/// Returns the runtime which owns the current thread,
+/// or a nullptr if the current thread isn't a core of a runtime.
+///
+/// \since 4.3.0
+inline runtime* current_runtime() noexcept {
+  return detail::shard::this_core().owner;
+}
+
+/// Returns the index of the core the current thread is running,
+/// or shard::npos if the current thread isn't a core of a runtime.
+///
+/// \since 4.3.0
+inline std::size_t current_core() noexcept {
+  auto const& current = detail::shard::this_core();
+  return current.owner ? current.index : npos;
+}
+
+/// A runtime which runs a single thread per core, every core owns its own
+/// queue of work.
+///
+/// Work which is submitted from one core to another is passed through
+/// a mailbox which is written by the submitting core and read by the
+/// receiving core only, therefore the cores never contend on a lock
+/// while passing work between each other.
+/// Work submitted from threads outside of the runtime is passed through
+/// a locked queue of the receiving core.
+///
+/// ```cpp
+/// cti::shard::runtime shards(4);
+///
+/// shards.submit_to(2, [] {
+///   // Runs on core 2
+///   return cti::shard::submit_to(3, [] {
+///     // Runs on core 3
+///     return 0;
+///   }).then([](int value) {
+///     // Runs on core 2 again
+///   });
+/// });
+/// ```
+///
+/// The threads are pinned to the processor with the same index
+/// on platforms which support it.
+/// Work which is pending while the runtime is destroyed is resolved
+/// as cancelled.
+///
+/// \since 4.3.0
+class runtime {
+public:
+  /// An executor which submits the work to a core of the runtime,
+  /// which is usable with continuable_base::then.
+  class executor {
+  public:
+    executor(runtime* owner, std::size_t index) noexcept
+        : owner_(owner), index_(index) {
+    }
+
+    template <typename Work>
+    void operator()(Work&& item) const {
+      if (index_ == npos) {
+        // There is no core to return to, continue on the current thread
+        std::forward<Work>(item)();
+      } else {
+        owner_->post(index_, std::forward<Work>(item));
+      }
+    }
+
+  private:
+    runtime* owner_;
+    std::size_t index_;
+  };
+
+  /// Starts the given count of cores
+  explicit runtime(std::size_t cores = default_cores())
+      : mailboxes_(new std::atomic<detail::shard::mailbox*>[cores * cores]) {
+    assert(cores > 0U && "A runtime requires at least one core!");
+
+    for (std::size_t i = 0U; i != cores * cores; ++i) {
+      mailboxes_[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    cores_.reserve(cores);
+    for (std::size_t i = 0U; i != cores; ++i) {
+      cores_.emplace_back(std::make_unique<detail::shard::core>(cores));
+    }
+    for (std::size_t i = 0U; i != cores; ++i) {
+      cores_[i]->thread = std::thread([this, i] { run(i); });
+    }
+  }
+
+  ~runtime() {
+    stopped_.store(true, std::memory_order_seq_cst);
+    for (auto& core : cores_) {
+      {
+        std::lock_guard<std::mutex> guard(core->lock);
+        core->woken = true;
+      }
+      core->condition.notify_one();
+    }
+    for (auto& core : cores_) {
+      core->thread.join();
+    }
+
+    // Cancelling the work may submit further work to the runtime
+    while (cancel_pending()) {
+    }
+
+    for (std::size_t i = 0U; i != size() * size(); ++i) {
+      delete mailboxes_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  runtime(runtime const&) = delete;
+  runtime(runtime&&) = delete;
+  runtime& operator=(runtime const&) = delete;
+  runtime& operator=(runtime&&) = delete;
+
+  /// Returns the count of cores
+  std::size_t size() const noexcept {
+    return cores_.size();
+  }
+
+  /// Returns an executor which submits the work to the given core
+  executor executor_of(std::size_t index) noexcept {
+    assert(index < size() && "The core doesn't exist!");
+    return executor(this, index);
+  }
+
+  /// Returns a continuable_base which invokes the callable on the given core,
+  /// and resolves on the core submit_to is called from.
+  ///
+  /// When submit_to is called from a thread outside of this runtime,
+  /// the continuable_base resolves on the given core directly.
+  template <typename Callable>
+  auto submit_to(std::size_t index, Callable&& callable) {
+    auto const& current = detail::shard::this_core();
+    std::size_t const home = (current.owner == this) ? current.index : npos;
+
+    return async_on(std::forward<Callable>(callable), executor_of(index))
+        .via(executor(this, home));
+  }
+
+  /// Returns a snapshot of the metrics of the queue and thread of every
+  /// core, which is empty unless `CONTINUABLE_WITH_EXECUTOR_METRICS`
+  /// is defined.
+  executor_metrics snapshot() const {
+    executor_metrics metrics;
+    if (detail::metrics::enabled) {
+      for (std::size_t index = 0U; index != size(); ++index) {
+        auto const& core = *cores_[index];
+        metrics.queues.push_back(core.queue.snapshot(enqueued_to(index)));
+        metrics.workers.push_back(core.worker.snapshot());
+      }
+    }
+    return metrics;
+  }
+
+private:
+  static std::size_t default_cores() noexcept {
+    std::size_t const cores = std::thread::hardware_concurrency();
+    return cores ? cores : 1U;
+  }
+
+  static void post_to(runtime* owner, std::size_t index, work submitted) {
+    owner->post(index, std::move(submitted));
+  }
+
+  void post(std::size_t index, work submitted) {
+    detail::shard::queued_work item(std::move(submitted));
+
+    auto const& current = detail::shard::this_core();
+    if (current.owner != this) {
+      auto& target = *cores_[index];
+      bool is_sleeping;
+      {
+        std::lock_guard<std::mutex> guard(target.lock);
+        target.external.push_back(std::move(item));
+        target.external_sent.enqueued();
+        target.has_external.store(true, std::memory_order_release);
+        is_sleeping = target.sleeping.load(std::memory_order_relaxed);
+        target.woken = target.woken || is_sleeping;
+      }
+      if (is_sleeping) {
+        target.condition.notify_one();
+      }
+      return;
+    }
+
+    auto& self = *cores_[current.index];
+    self.sent[index].enqueued();
+    if (index == current.index) {
+      self.local.push_back(std::move(item));
+      return;
+    }
+
+    auto& overflow = self.overflow[index];
+    if (overflow.empty() && mailbox_of(current.index, index).try_push(item)) {
+      wake(index);
+    } else {
+      overflow.push_back(std::move(item));
+    }
+  }
+
+  /// Returns the mailbox from the given core to the given core,
+  /// may only be called from the sending core.
+  detail::shard::mailbox& mailbox_of(std::size_t from, std::size_t to) {
+    auto& slot = mailboxes_[to * size() + from];
+    detail::shard::mailbox* mailbox = slot.load(std::memory_order_relaxed);
+    if (!mailbox) {
+      mailbox = new detail::shard::mailbox();
+      slot.store(mailbox, std::memory_order_release);
+    }
+    return *mailbox;
+  }
+
+  /// Returns the count of work which was submitted to the given core
+  /// by all cores and by the threads outside of the runtime.
+  std::uint64_t enqueued_to(std::size_t index) const noexcept {
+    std::uint64_t enqueued = cores_[index]->external_sent.count();
+    for (auto const& core : cores_) {
+      enqueued += core->sent[index].count();
+    }
+    return enqueued;
+  }
+
+  /// Wakes the given core up if it is sleeping
+  void wake(std::size_t index) {
+    auto& target = *cores_[index];
+
+    // Pairs with the store to sleeping before the core checks its mailboxes
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (target.sleeping.load(std::memory_order_seq_cst)) {
+      {
+        std::lock_guard<std::mutex> guard(target.lock);
+        target.woken = true;
+      }
+      target.condition.notify_one();
+    }
+  }
+
+  void run(std::size_t index) {
+    detail::shard::pin_current_thread(index);
+    detail::shard::this_core() = {this, index, &runtime::post_to};
+
+    // The count of rounds a core yields before it sleeps
+    constexpr std::size_t spin_rounds = 64U;
+
+    std::size_t idle = 0U;
+    while (true) {
+      if (drain(index)) {
+        idle = 0U;
+        continue;
+      }
+      if (stopped_.load(std::memory_order_acquire)) {
+        break;
+      }
+      if (++idle < spin_rounds || has_overflow(index)) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      idle = 0U;
+      sleep(index);
+    }
+
+    detail::shard::this_core() = {nullptr, 0U, nullptr};
+  }
+
+  /// Runs the work which is pending on the given core,
+  /// returns true if any work was done.
+  bool drain(std::size_t index) {
+    auto& self = *cores_[index];
+    bool progressed = false;
+
+    if (detail::metrics::enabled) {
+      self.queue.observed(enqueued_to(index));
+    }
+
+    // Pass the work which didn't fit into the mailboxes previously
+    for (std::size_t to = 0U; to != size(); ++to) {
+      auto& overflow = self.overflow[to];
+      if (overflow.empty()) {
+        continue;
+      }
+
+      auto& mailbox = mailbox_of(index, to);
+      bool pushed = false;
+      while (!overflow.empty() && mailbox.try_push(overflow.front())) {
+        overflow.pop_front();
+        pushed = true;
+      }
+      if (pushed) {
+        progressed = true;
+        wake(to);
+      }
+    }
+
+    // Only run the local work which was submitted before
+    for (std::size_t count = self.local.size(); count != 0U; --count) {
+      detail::shard::queued_work item = std::move(self.local.front());
+      self.local.pop_front();
+      invoke(self, item);
+      progressed = true;
+    }
+
+    detail::shard::queued_work item;
+    for (std::size_t from = 0U; from != size(); ++from) {
+      auto* mailbox = mailboxes_[index * size() + from].load(
+          std::memory_order_acquire);
+      if (!mailbox) {
+        continue;
+      }
+
+      for (std::size_t count = 0U;
+           count != detail::shard::batch_size && mailbox->try_pop(item);
+           ++count) {
+        invoke(self, item);
+        progressed = true;
+      }
+    }
+
+    if (self.has_external.load(std::memory_order_acquire)) {
+      std::deque<detail::shard::queued_work> external;
+      {
+        std::lock_guard<std::mutex> guard(self.lock);
+        external.swap(self.external);
+        self.has_external.store(false, std::memory_order_relaxed);
+      }
+      for (auto& current : external) {
+        invoke(self, current);
+      }
+      progressed = true;
+    }
+
+    return progressed;
+  }
+
+  static void invoke(detail::shard::core& self,
+                     detail::shard::queued_work& item) {
+    self.queue.dequeued();
+    self.worker.started(item);
+    std::move(item.item)();
+  }
+
+  bool has_overflow(std::size_t index) const noexcept {
+    for (auto const& overflow : cores_[index]->overflow) {
+      if (!overflow.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Returns true if work was submitted to the given core
+  bool has_work(std::size_t index) const noexcept {
+    auto const& self = *cores_[index];
+    if (!self.local.empty() ||
+        self.has_external.load(std::memory_order_relaxed)) {
+      return true;
+    }
+    for (std::size_t from = 0U; from != size(); ++from) {
+      auto* mailbox = mailboxes_[index * size() + from].load(
+          std::memory_order_acquire);
+      if (mailbox && mailbox->has_work()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void sleep(std::size_t index) {
+    auto& self = *cores_[index];
+
+    std::unique_lock<std::mutex> lock(self.lock);
+    self.sleeping.store(true, std::memory_order_seq_cst);
+    if (!has_work(index) && !stopped_.load(std::memory_order_seq_cst)) {
+      detail::metrics::worker_recorder::idle_scope idle(self.worker);
+      self.condition.wait(lock, [&] { return self.woken; });
+    }
+    self.woken = false;
+    self.sleeping.store(false, std::memory_order_relaxed);
+  }
+
+  /// Cancels the work which is left after the cores were stopped,
+  /// returns true if any work was cancelled.
+  bool cancel_pending() {
+    std::deque<detail::shard::queued_work> pending;
+    for (std::size_t index = 0U; index != size(); ++index) {
+      auto& self = *cores_[index];
+      std::move(self.local.begin(), self.local.end(),
+                std::back_inserter(pending));
+      self.local.clear();
+      for (auto& overflow : self.overflow) {
+        std::move(overflow.begin(), overflow.end(),
+                  std::back_inserter(pending));
+        overflow.clear();
+      }
+      {
+        std::lock_guard<std::mutex> guard(self.lock);
+        std::move(self.external.begin(), self.external.end(),
+                  std::back_inserter(pending));
+        self.external.clear();
+      }
+
+      detail::shard::queued_work item;
+      for (std::size_t from = 0U; from != size(); ++from) {
+        auto* mailbox = mailboxes_[index * size() + from].load(
+            std::memory_order_acquire);
+        while (mailbox && mailbox->try_pop(item)) {
+          pending.push_back(std::move(item));
+        }
+      }
+    }
+
+    for (auto& current : pending) {
+      std::move(current.item)(exception_arg_t{}, exception_t{});
+    }
+    return !pending.empty();
+  }
+
+  std::unique_ptr<std::atomic<detail::shard::mailbox*>[]> mailboxes_;
+  std::vector<std::unique_ptr<detail::shard::core>> cores_;
+  std::atomic<bool> stopped_{false};
+};
+
+/// Invokes the callable on the given core of the runtime which owns the
+/// current thread, the returned continuable_base resolves on the current core.
+///
+/// \attention May only be called from a core of a shard::runtime.
+///
+/// \since 4.3.0
+template <typename Callable>
+auto submit_to(std::size_t index, Callable&& callable) {
+  runtime* owner = current_runtime();
+  assert(owner && "submit_to was called from outside of a runtime!");
+  return owner->submit_to(index, std::forward<Callable>(callable));
+}
+} // namespace shard
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_SHARD_HPP_INCLUDED
@@ -0,0 +1,147 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_SINGLE_FLIGHT_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_SINGLE_FLIGHT_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/operations/single-flight.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// Coalesces concurrent asynchronous requests for the same key,
+/// such that only one request per key is in flight at any time.
+///
+/// All continuables returned by single_flight::get for the same key which are
+/// started while a request for the key is still in flight are resolved with
+/// the result of the request that was started first.
+/// The loader of subsequent requests is not invoked in this case.
+/// ```cpp
+/// cti::single_flight<std::string, std::string> flights;
+///
+/// cti::continuable<std::string> fetch(std::string key) {
+///   return flights.get(key, [key] {
+///     // Only invoked once for concurrent requests of the same key
+///     return http_request("example.com/" + key);
+///   });
+/// }
+/// ```
+///
+/// The in-flight table is split into `Shards` independently locked
+/// shards. The entry of a key is removed automatically as soon as its
+/// result was delivered, therefore results are not cached.
+///
+/// \tparam Key The key type which is hashed through `Hash` and compared
+///             through `KeyEqual`.
+///
+/// \tparam T The type of the asynchronous result, which is required to be
+///           copyable when it shall be delivered to multiple waiters.
+///
+/// \attention The single_flight object needs to outlive all requests
+///            started through it.
+///
+/// \since 4.3.0
+///
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>, std::size_t Shards = 16>
+class single_flight {
+  static_assert(Shards > 0, "There needs to be at least one shard!");
+
+  using shard_t =
+      detail::operations::flight_shard<Key, promise<T>, Hash, KeyEqual>;
+
+  Hash hash_;
+  std::array<shard_t, Shards> shards_;
+
+public:
+  single_flight() = default;
+  explicit single_flight(Hash hash) : hash_(std::move(hash)) {
+  }
+
+  single_flight(single_flight const&) = delete;
+  single_flight(single_flight&&) = delete;
+  single_flight& operator=(single_flight const&) = delete;
+  single_flight& operator=(single_flight&&) = delete;
+
+  /// Returns a continuable_base which resolves with the result of the
+  /// request for the given key.
+  ///
+  /// When the continuable_base is started and there is no request for the
+  /// key in flight, the loader is invoked and the continuable_base it
+  /// returns is started. Otherwise the continuable_base joins the request
+  /// which is already in flight.
+  ///
+  /// \param key The key to coalesce requests on
+  ///
+  /// \param loader A callable which is invoked with no arguments and returns
+  ///               a continuable_base resolving with `T`.
+  ///
+  /// \since 4.3.0
+  template <typename Loader>
+  auto get(Key key, Loader&& loader) {
+    return make_continuable<T>(
+        [this, key = std::move(key),
+         loader = std::forward<Loader>(loader)](auto&& promise) mutable {
+          shard_t& shard = shard_of(key);
+          auto const flight =
+              shard.join(key, std::forward<decltype(promise)>(promise));
+          if (flight) {
+            detail::operations::start_flight(shard, key, flight, loader);
+          }
+        });
+  }
+
+  /// Returns the count of keys which currently have a request in flight
+  ///
+  /// \since 4.3.0
+  std::size_t in_flight() const {
+    std::size_t count = 0;
+    for (auto const& shard : shards_) {
+      count += shard.size();
+    }
+    return count;
+  }
+
+private:
+  shard_t& shard_of(Key const& key) {
+    return shards_[hash_(key) % Shards];
+  }
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_SINGLE_FLIGHT_HPP_INCLUDED
@@ -0,0 +1,175 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_OPERATIONS_TIMER_QUEUE_HPP_INCLUDED
+#define CONTINUABLE_OPERATIONS_TIMER_QUEUE_HPP_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-types.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// A timer which resolves continuables after a given delay without
+/// blocking the caller.
+///
+/// All timers of a timer_queue are served by a single background thread,
+/// therefore the continuations attached to a timer are invoked on this thread
+/// and shouldn't block it.
+/// ```cpp
+/// cti::timer_queue timers;
+///
+/// timers.wait_for(std::chrono::milliseconds(100)).then([] {
+///   // Invoked on the timer thread after 100ms
+/// });
+/// ```
+///
+/// Timers which are pending while the timer_queue is destroyed are
+/// resolved as cancelled.
+///
+/// \since 4.3.0
+///
+class timer_queue {
+public:
+  using clock = std::chrono::steady_clock;
+
+  timer_queue() : thread_([this] { run(); }) {
+  }
+
+  ~timer_queue() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stopped_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+
+    for (auto& timer : timers_) {
+      std::move(timer.second).set_canceled();
+    }
+  }
+
+  timer_queue(timer_queue const&) = delete;
+  timer_queue(timer_queue&&) = delete;
+  timer_queue& operator=(timer_queue const&) = delete;
+  timer_queue& operator=(timer_queue&&) = delete;
+
+  /// Returns a continuable_base which resolves after the given delay,
+  /// the timer is started when the continuable_base is started.
+  ///
+  /// \since 4.3.0
+  template <typename Rep, typename Period>
+  auto wait_for(std::chrono::duration<Rep, Period> delay) {
+    auto const duration = std::chrono::duration_cast<clock::duration>(delay);
+    return make_continuable<void>([this, duration](auto&& promise) {
+      schedule(clock::now() + duration,
+               std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Returns a continuable_base which resolves at the given time point
+  ///
+  /// \since 4.3.0
+  auto wait_until(clock::time_point when) {
+    return make_continuable<void>([this, when](auto&& promise) {
+      schedule(when, std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Makes the timer_queue usable as timer for cti::retry when passed
+  /// through `std::ref`.
+  template <typename Rep, typename Period>
+  auto operator()(std::chrono::duration<Rep, Period> delay) {
+    return wait_for(delay);
+  }
+
+private:
+  template <typename Promise>
+  void schedule(clock::time_point when, Promise&& promise) {
+    bool is_first;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      is_first = timers_.empty() || (when < timers_.begin()->first);
+      timers_.emplace(when, std::forward<Promise>(promise));
+    }
+
+    if (is_first) {
+      condition_.notify_one();
+    }
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (!stopped_) {
+      if (timers_.empty()) {
+        condition_.wait(lock);
+        continue;
+      }
+
+      auto const first = timers_.begin();
+      if (clock::now() < first->first) {
+        condition_.wait_until(lock, first->first);
+        continue;
+      }
+
+      promise<> expired = std::move(first->second);
+      timers_.erase(first);
+
+      lock.unlock();
+      std::move(expired).set_value();
+      lock.lock();
+    }
+  }
+
+  std::mutex lock_;
+  std::condition_variable condition_;
+  std::multimap<clock::time_point, promise<>> timers_;
+  bool stopped_ = false;
+  std::thread thread_;
+};
+
+/// Returns a process wide timer_queue which is created on first use
+///
+/// \since 4.3.0
+inline timer_queue& default_timer_queue() {
+  static timer_queue timers;
+  return timers;
+}
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_OPERATIONS_TIMER_QUEUE_HPP_INCLUDED
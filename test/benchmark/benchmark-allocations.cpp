@@ -0,0 +1,129 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <benchmark-support.hpp>
+
+// The global allocation functions are replaced in order to count the
+// allocations of every thread. Counting per thread keeps the counters free
+// of contention and of allocations done by unrelated threads.
+namespace {
+thread_local bench::allocation_stats current{0U, 0U};
+
+// The bytes alive on the current thread, memory which is freed by another
+// thread than the allocating one lets the value drift.
+thread_local std::int64_t alive = 0;
+thread_local std::int64_t peak = 0;
+
+// Every allocation is prefixed by its size such that the bytes alive
+// can be tracked for unsized deallocations too.
+constexpr std::size_t header = alignof(std::max_align_t);
+
+void* allocate_nothrow(std::size_t size) noexcept {
+  ++current.count;
+  current.bytes += size;
+
+  void* memory = std::malloc(size + header);
+  if (!memory) {
+    return nullptr;
+  }
+
+  *static_cast<std::size_t*>(memory) = size;
+  alive += static_cast<std::int64_t>(size);
+  if (alive > peak) {
+    peak = alive;
+  }
+  return static_cast<char*>(memory) + header;
+}
+
+void* allocate(std::size_t size) {
+  if (void* memory = allocate_nothrow(size)) {
+    return memory;
+  }
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+  throw std::bad_alloc();
+#else
+  std::abort();
+#endif
+}
+
+void deallocate(void* memory) noexcept {
+  if (!memory) {
+    return;
+  }
+
+  void* const origin = static_cast<char*>(memory) - header;
+  alive -= static_cast<std::int64_t>(*static_cast<std::size_t*>(origin));
+  std::free(origin);
+}
+} // namespace
+
+bench::allocation_stats bench::allocations() noexcept {
+  return current;
+}
+
+std::uint64_t bench::peak_bytes() noexcept {
+  return static_cast<std::uint64_t>(peak > 0 ? peak : 0);
+}
+
+void bench::reset_peak_bytes() noexcept {
+  peak = alive;
+}
+
+std::uint64_t bench::alive_bytes() noexcept {
+  return static_cast<std::uint64_t>(alive > 0 ? alive : 0);
+}
+
+void* operator new(std::size_t size) {
+  return allocate(size);
+}
+void* operator new[](std::size_t size) {
+  return allocate(size);
+}
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+  return allocate_nothrow(size);
+}
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+  return allocate_nothrow(size);
+}
+void operator delete(void* memory) noexcept {
+  deallocate(memory);
+}
+void operator delete[](void* memory) noexcept {
+  deallocate(memory);
+}
+void operator delete(void* memory, std::size_t) noexcept {
+  deallocate(memory);
+}
+void operator delete[](void* memory, std::size_t) noexcept {
+  deallocate(memory);
+}
+void operator delete(void* memory, std::nothrow_t const&) noexcept {
+  deallocate(memory);
+}
+void operator delete[](void* memory, std::nothrow_t const&) noexcept {
+  deallocate(memory);
+}
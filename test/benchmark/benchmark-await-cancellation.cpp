@@ -0,0 +1,53 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+// Cancels awaiting coroutines through the direct cancellation, compare the
+// results with bm_co_await_canceled of continuable-benchmarks which resumes
+// the coroutine with an await_canceled_exception instead.
+//
+// The macro changes the behaviour of inline functions, therefore this
+// translation unit is built into its own continuable-benchmarks-await target.
+#define CONTINUABLE_WITH_DIRECT_AWAIT_CANCELLATION
+
+#include <benchmark-support.hpp>
+#include <continuable/detail/features.hpp>
+
+#if defined(CONTINUABLE_HAS_COROUTINE)
+namespace {
+cti::continuable<> await_canceled() {
+  co_await cti::make_cancelling_continuable<void>();
+  co_return;
+}
+} // namespace
+
+static void bm_co_await_canceled_direct(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    await_canceled().fail([](cti::exception_t exception) {
+      benchmark::DoNotOptimize(exception);
+    });
+  }
+}
+
+BENCHMARK(bm_co_await_canceled_direct);
+#endif // CONTINUABLE_HAS_COROUTINE
@@ -0,0 +1,178 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <cstddef>
+#include <benchmark-support.hpp>
+
+namespace {
+struct increment {
+  int operator()(int value) const noexcept {
+    return value + 1;
+  }
+};
+
+/// The same as increment, but requires a try block around its invocation
+struct increment_may_throw {
+  int operator()(int value) const {
+    return value + 1;
+  }
+};
+
+template <std::size_t Depth, typename Callback = increment>
+struct chain {
+  template <typename Continuable>
+  static auto apply(Continuable&& continuable) {
+    return chain<Depth - 1, Callback>::apply(
+        std::forward<Continuable>(continuable).then(Callback{}));
+  }
+};
+template <typename Callback>
+struct chain<0, Callback> {
+  template <typename Continuable>
+  static auto apply(Continuable&& continuable) {
+    return std::forward<Continuable>(continuable);
+  }
+};
+
+struct value_or_error {
+  int operator()(int value) const noexcept {
+    return value;
+  }
+  int operator()(cti::exception_arg_t, cti::exception_t) const noexcept {
+    return 0;
+  }
+};
+} // namespace
+
+/// A chain of Depth callbacks without any type erasure
+template <std::size_t Depth>
+static void bm_then_unerased(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    chain<Depth>::apply(bench::async_value(0)).then([](int value) {
+      benchmark::DoNotOptimize(value);
+    });
+  }
+}
+
+BENCHMARK_TEMPLATE(bm_then_unerased, 1);
+BENCHMARK_TEMPLATE(bm_then_unerased, 2);
+BENCHMARK_TEMPLATE(bm_then_unerased, 4);
+BENCHMARK_TEMPLATE(bm_then_unerased, 8);
+BENCHMARK_TEMPLATE(bm_then_unerased, 16);
+BENCHMARK_TEMPLATE(bm_then_unerased, 32);
+BENCHMARK_TEMPLATE(bm_then_unerased, 64);
+
+/// A chain of Depth callbacks which aren't declared as noexcept
+template <std::size_t Depth>
+static void bm_then_unerased_may_throw(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    chain<Depth, increment_may_throw>::apply(bench::async_value(0))
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK_TEMPLATE(bm_then_unerased_may_throw, 32);
+
+/// A chain of Depth callbacks on a ready continuable,
+/// which doesn't need to create any callback objects.
+template <std::size_t Depth>
+static void bm_then_unerased_ready(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    chain<Depth>::apply(cti::make_ready_continuable(0))
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK_TEMPLATE(bm_then_unerased_ready, 1);
+BENCHMARK_TEMPLATE(bm_then_unerased_ready, 8);
+BENCHMARK_TEMPLATE(bm_then_unerased_ready, 64);
+
+/// A chain of callbacks where the continuable is type erased after each step
+static void bm_then_erased(benchmark::State& state) {
+  auto const depth = state.range(0);
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::continuable<int> continuable = bench::async_value(0);
+    for (auto i = 0; i < depth; ++i) {
+      continuable = std::move(continuable).then(increment{});
+    }
+    std::move(continuable).then([](int value) {
+      benchmark::DoNotOptimize(value);
+    });
+  }
+}
+
+BENCHMARK(bm_then_erased)->ArgName("depth")->RangeMultiplier(2)->Range(1, 64);
+
+/// The propagation of an error through a then to a fail handler
+static void bm_fail(benchmark::State& state) {
+  cti::exception_t const error = bench::make_error();
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::make_exceptional_continuable<int>(error)
+        .then(increment{})
+        .fail([](cti::exception_t exception) {
+          benchmark::DoNotOptimize(exception);
+          return 0;
+        });
+  }
+}
+
+BENCHMARK(bm_fail);
+
+/// A next handler which receives values and errors alike
+static void bm_next(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    bench::async_value(0).next(value_or_error{}).then([](int value) {
+      benchmark::DoNotOptimize(value);
+    });
+  }
+}
+
+BENCHMARK(bm_next);
+
+/// A chain which hops to a queued executor on every step
+static void bm_executor_hops(benchmark::State& state) {
+  auto const hops = state.range(0);
+  bench::queue_executor executor;
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::continuable<int> continuable = bench::async_value(0);
+    for (auto i = 0; i < hops; ++i) {
+      continuable = std::move(continuable).then(increment{}, executor.get());
+    }
+    std::move(continuable).then([](int value) {
+      benchmark::DoNotOptimize(value);
+    });
+    executor.drain();
+  }
+}
+
+BENCHMARK(bm_executor_hops)->ArgName("hops")->Arg(1)->Arg(8);
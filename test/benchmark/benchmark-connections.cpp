@@ -0,0 +1,239 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#include <benchmark-support.hpp>
+
+namespace {
+auto make_vector(std::int64_t size) {
+  std::vector<cti::continuable<int>> continuables;
+  continuables.reserve(static_cast<std::size_t>(size));
+  for (std::int64_t i = 0; i < size; ++i) {
+    continuables.push_back(bench::async_value(static_cast<int>(i)));
+  }
+  return continuables;
+}
+} // namespace
+
+static void bm_when_all_tuple(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_all(bench::async_value(0), bench::async_value(1),
+                  bench::async_value(2))
+        .then([](int a, int b, int c) {
+          benchmark::DoNotOptimize(a + b + c);
+        });
+  }
+}
+
+BENCHMARK(bm_when_all_tuple);
+
+static void bm_when_any_tuple(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_any(bench::async_value(0), bench::async_value(1),
+                  bench::async_value(2))
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK(bm_when_any_tuple);
+
+static void bm_when_seq_tuple(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_seq(bench::async_value(0), bench::async_value(1),
+                  bench::async_value(2))
+        .then([](int a, int b, int c) {
+          benchmark::DoNotOptimize(a + b + c);
+        });
+  }
+}
+
+BENCHMARK(bm_when_seq_tuple);
+
+/// The vector is created inside the loop, which is included in the timing
+/// since creating the continuables is part of every realistic use.
+static void bm_when_all_vector(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_all(make_vector(state.range(0)))
+        .then([](std::vector<int> values) { benchmark::DoNotOptimize(values); });
+  }
+}
+
+BENCHMARK(bm_when_all_vector)->ArgName("size")->RangeMultiplier(8)->Range(1, 64);
+
+/// Fans out to many continuables, the contiguous when_all writes the results
+/// in place, while the tuple wraps the vector into the generic traversal.
+static void bm_when_all_fan_out(benchmark::State& state) {
+  bench::allocation_report report(state);
+  bench::peak_report peak(state);
+  for (auto _ : state) {
+    cti::when_all(make_vector(state.range(0)))
+        .then([](std::vector<int> values) { benchmark::DoNotOptimize(values); });
+  }
+}
+
+BENCHMARK(bm_when_all_fan_out)->ArgName("size")->Arg(10000);
+
+static void bm_when_all_fan_out_generic(benchmark::State& state) {
+  bench::allocation_report report(state);
+  bench::peak_report peak(state);
+  for (auto _ : state) {
+    cti::when_all(std::make_tuple(make_vector(state.range(0))))
+        .then([](std::tuple<std::vector<int>> values) {
+          benchmark::DoNotOptimize(values);
+        });
+  }
+}
+
+BENCHMARK(bm_when_all_fan_out_generic)->ArgName("size")->Arg(10000);
+
+static void bm_when_all_fan_out_into(benchmark::State& state) {
+  std::vector<int> results(static_cast<std::size_t>(state.range(0)));
+
+  bench::allocation_report report(state);
+  bench::peak_report peak(state);
+  for (auto _ : state) {
+    cti::when_all_into(make_vector(state.range(0)), results).then([&] {
+      benchmark::DoNotOptimize(results.data());
+    });
+  }
+}
+
+BENCHMARK(bm_when_all_fan_out_into)->ArgName("size")->Arg(10000);
+
+static void bm_when_any_vector(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_any(make_vector(state.range(0))).then([](int value) {
+      benchmark::DoNotOptimize(value);
+    });
+  }
+}
+
+BENCHMARK(bm_when_any_vector)->ArgName("size")->RangeMultiplier(8)->Range(1, 64);
+
+static void bm_when_seq_vector(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_seq(make_vector(state.range(0)))
+        .then([](std::vector<int> values) { benchmark::DoNotOptimize(values); });
+  }
+}
+
+BENCHMARK(bm_when_seq_vector)->ArgName("size")->RangeMultiplier(8)->Range(1, 64);
+
+/// Every step of the sequence resumes the asynchronous traversal from a
+/// queued executor, which keeps the stack flat for large sequences.
+/// The counters are normalized to a single step.
+static void bm_when_seq_steps(benchmark::State& state) {
+  auto const steps = static_cast<double>(state.range(0));
+  bench::queue_executor executor;
+
+  bench::allocation_stats const begin = bench::allocations();
+  for (auto _ : state) {
+    std::vector<cti::continuable<int>> continuables;
+    continuables.reserve(static_cast<std::size_t>(state.range(0)));
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      continuables.push_back(bench::async_value(static_cast<int>(i))
+                                 .then([](int value) { return value; },
+                                       executor.get()));
+    }
+
+    cti::when_seq(std::move(continuables))
+        .then([](std::vector<int> values) { benchmark::DoNotOptimize(values); });
+    executor.drain();
+  }
+  bench::allocation_stats const end = bench::allocations();
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["allocs_per_step"] =
+      benchmark::Counter(static_cast<double>(end.count - begin.count) / steps,
+                         benchmark::Counter::kAvgIterations);
+  state.counters["ns_per_step"] = benchmark::Counter(
+      steps, benchmark::Counter::kIsIterationInvariantRate |
+                 benchmark::Counter::kInvert);
+}
+
+BENCHMARK(bm_when_seq_steps)->ArgName("size")->Arg(10000);
+
+namespace {
+template <std::size_t Size>
+struct sequence_chain {
+  static auto make() {
+    return sequence_chain<Size - 1>::make() >>
+           bench::async_value(static_cast<int>(Size));
+  }
+};
+template <>
+struct sequence_chain<1> {
+  static auto make() {
+    return bench::async_value(1);
+  }
+};
+} // namespace
+
+/// Connects the continuables through a chain of operator>>
+template <std::size_t Size>
+static void bm_seq_operator_chain(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    sequence_chain<Size>::make().then([](auto... values) {
+      int sum = 0;
+      (void)std::initializer_list<int>{(sum += values, 0)...};
+      benchmark::DoNotOptimize(sum);
+    });
+  }
+}
+
+BENCHMARK_TEMPLATE(bm_seq_operator_chain, 4);
+BENCHMARK_TEMPLATE(bm_seq_operator_chain, 16);
+BENCHMARK_TEMPLATE(bm_seq_operator_chain, 64);
+
+template <std::size_t... I>
+auto make_sequence(std::index_sequence<I...>) {
+  return cti::when_seq(bench::async_value(static_cast<int>(I))...);
+}
+
+/// Connects the continuables through a single N-ary sequence
+template <std::size_t Size>
+static void bm_seq_flat(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    make_sequence(std::make_index_sequence<Size>{}).then([](auto... values) {
+      int sum = 0;
+      (void)std::initializer_list<int>{(sum += values, 0)...};
+      benchmark::DoNotOptimize(sum);
+    });
+  }
+}
+
+BENCHMARK_TEMPLATE(bm_seq_flat, 4);
+BENCHMARK_TEMPLATE(bm_seq_flat, 16);
+BENCHMARK_TEMPLATE(bm_seq_flat, 64);
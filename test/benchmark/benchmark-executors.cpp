@@ -0,0 +1,499 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <benchmark-support.hpp>
+#include <continuable/operations/blocking.hpp>
+#include <continuable/operations/run-loop.hpp>
+#include <continuable/operations/scheduler.hpp>
+#include <continuable/operations/shard.hpp>
+
+namespace {
+int const ping_pong_rounds = 1000;
+int const messages = 10000;
+
+/// Bounces a message between core 0 and core 1 of the runtime
+void shard_ping_pong(cti::shard::runtime& shards) {
+  shards
+      .submit_to(0,
+                 [] {
+                   auto round = std::make_shared<int>(0);
+                   return cti::loop([round] {
+                     return cti::shard::submit_to(1, [] {})
+                         .then([round]() -> cti::loop_result<> {
+                           if (++*round == ping_pong_rounds) {
+                             return cti::loop_break();
+                           }
+                           return cti::loop_continue();
+                         });
+                   });
+                 })
+      .apply(cti::transforms::wait());
+}
+
+/// Bounces a message between two workers of a shared queue
+void pool_ping_pong(bench::thread_pool& pool) {
+  auto executor = pool.get();
+  cti::async_on(
+      [executor] {
+        auto round = std::make_shared<int>(0);
+        return cti::loop([executor, round] {
+          return cti::async_on([] {}, executor)
+              .then(
+                  [round]() -> cti::loop_result<> {
+                    if (++*round == ping_pong_rounds) {
+                      return cti::loop_break();
+                    }
+                    return cti::loop_continue();
+                  },
+                  executor);
+        });
+      },
+      executor)
+      .apply(cti::transforms::wait());
+}
+
+/// Submits the messages from the first executor to the second one
+template <typename Sender, typename Receiver>
+void send_messages(Sender sender, Receiver receiver) {
+  std::promise<void> done;
+  std::atomic<int> received{0};
+
+  cti::async_on(
+      [&] {
+        for (int i = 0; i != messages; ++i) {
+          cti::async_on(
+              [&] {
+                if (received.fetch_add(1, std::memory_order_relaxed) + 1 ==
+                    messages) {
+                  done.set_value();
+                }
+              },
+              receiver)
+              .done();
+        }
+      },
+      sender)
+      .done();
+
+  done.get_future().wait();
+}
+} // namespace
+
+static void bm_shard_ping_pong(benchmark::State& state) {
+  cti::shard::runtime shards(2);
+
+  for (auto _ : state) {
+    shard_ping_pong(shards);
+  }
+  state.counters["ns_per_round_trip"] = benchmark::Counter(
+      ping_pong_rounds, benchmark::Counter::kIsIterationInvariantRate |
+                            benchmark::Counter::kInvert);
+}
+
+BENCHMARK(bm_shard_ping_pong)->UseRealTime();
+
+static void bm_pool_ping_pong(benchmark::State& state) {
+  bench::thread_pool pool(2);
+
+  for (auto _ : state) {
+    pool_ping_pong(pool);
+  }
+  state.counters["ns_per_round_trip"] = benchmark::Counter(
+      ping_pong_rounds, benchmark::Counter::kIsIterationInvariantRate |
+                            benchmark::Counter::kInvert);
+}
+
+BENCHMARK(bm_pool_ping_pong)->UseRealTime();
+
+static void bm_shard_throughput(benchmark::State& state) {
+  cti::shard::runtime shards(2);
+
+  for (auto _ : state) {
+    send_messages(shards.executor_of(0), shards.executor_of(1));
+  }
+  state.SetItemsProcessed(state.iterations() * messages);
+}
+
+BENCHMARK(bm_shard_throughput)->UseRealTime();
+
+static void bm_pool_throughput(benchmark::State& state) {
+  bench::thread_pool pool(2);
+
+  for (auto _ : state) {
+    send_messages(pool.get(), pool.get());
+  }
+  state.SetItemsProcessed(state.iterations() * messages);
+}
+
+BENCHMARK(bm_pool_throughput)->UseRealTime();
+
+namespace {
+int const batch_tasks = 200;
+int const interactive_tasks = 20;
+
+void spin_for(std::chrono::microseconds duration) {
+  auto const until = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < until) {
+  }
+}
+
+/// Collects the latency of the interactive requests
+class latency_report {
+public:
+  void record(std::chrono::steady_clock::time_point submitted) {
+    auto const latency = std::chrono::steady_clock::now() - submitted;
+    std::lock_guard<std::mutex> guard(lock_);
+    samples_.push_back(static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(latency)
+            .count()));
+  }
+
+  void report(benchmark::State& state) {
+    std::sort(samples_.begin(), samples_.end());
+    if (!samples_.empty()) {
+      state.counters["interactive_p99_us"] =
+          samples_[(samples_.size() * 99U) / 100U];
+    }
+  }
+
+private:
+  std::mutex lock_;
+  std::vector<double> samples_;
+};
+
+/// Submits batch work which saturates the executor, interleaved with
+/// interactive requests, and waits until all of them were run.
+template <typename Batch, typename Interactive>
+void mixed_workload(latency_report& latencies, Batch&& batch,
+                    Interactive&& interactive) {
+  std::promise<void> done;
+  std::atomic<int> remaining{batch_tasks + interactive_tasks};
+  auto complete = [&] {
+    if (remaining.fetch_sub(1) == 1) {
+      done.set_value();
+    }
+  };
+
+  for (int i = 0; i != batch_tasks; ++i) {
+    batch([&] {
+      spin_for(std::chrono::microseconds(20));
+      complete();
+    });
+
+    if (i % (batch_tasks / interactive_tasks) == 0) {
+      auto const submitted = std::chrono::steady_clock::now();
+      interactive([&, submitted] {
+        spin_for(std::chrono::microseconds(2));
+        latencies.record(submitted);
+        complete();
+      });
+    }
+  }
+
+  done.get_future().wait();
+}
+} // namespace
+
+static void bm_scheduler_mixed_fifo(benchmark::State& state) {
+  bench::thread_pool pool(1);
+  latency_report latencies;
+
+  for (auto _ : state) {
+    mixed_workload(
+        latencies,
+        [&](auto task) { cti::async_on(std::move(task), pool.get()).done(); },
+        [&](auto task) {
+          cti::make_ready_continuable().then(std::move(task), pool.get())
+              .done();
+        });
+  }
+  latencies.report(state);
+}
+
+BENCHMARK(bm_scheduler_mixed_fifo)->UseRealTime();
+
+static void bm_scheduler_mixed_deadline(benchmark::State& state) {
+  cti::deadline_scheduler scheduler(1);
+  latency_report latencies;
+
+  for (auto _ : state) {
+    mixed_workload(
+        latencies,
+        [&](auto task) {
+          cti::async_on(std::move(task),
+                        scheduler.get(cti::priority::batch))
+              .done();
+        },
+        [&](auto task) {
+          cti::make_ready_continuable()
+              .apply(cti::with_priority(cti::priority::interactive))
+              .then(std::move(task), scheduler.get())
+              .done();
+        });
+  }
+  latencies.report(state);
+}
+
+BENCHMARK(bm_scheduler_mixed_deadline)->UseRealTime();
+
+namespace {
+int const blocking_calls = 20;
+
+/// Issues blocking calls interleaved with short requests on the hot pool
+/// and waits until all of them were run.
+template <typename Blocking>
+void blocking_workload(latency_report& latencies, bench::thread_pool& hot,
+                       Blocking&& blocking) {
+  std::promise<void> done;
+  std::atomic<int> remaining{blocking_calls * 2};
+  auto complete = [&] {
+    if (remaining.fetch_sub(1) == 1) {
+      done.set_value();
+    }
+  };
+
+  for (int i = 0; i != blocking_calls; ++i) {
+    blocking([] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }).then(complete)
+        .done();
+
+    auto const submitted = std::chrono::steady_clock::now();
+    cti::async_on(
+        [&, submitted] {
+          latencies.record(submitted);
+          complete();
+        },
+        hot.get())
+        .done();
+  }
+
+  done.get_future().wait();
+}
+} // namespace
+
+static void bm_blocking_on_hot_pool(benchmark::State& state) {
+  bench::thread_pool hot(1);
+  latency_report latencies;
+
+  for (auto _ : state) {
+    blocking_workload(latencies, hot, [&](auto call) {
+      return cti::async_on(std::move(call), hot.get());
+    });
+  }
+  latencies.report(state);
+}
+
+BENCHMARK(bm_blocking_on_hot_pool)->UseRealTime();
+
+static void bm_blocking_offloaded(benchmark::State& state) {
+  bench::thread_pool hot(1);
+  cti::blocking_pool pool;
+  latency_report latencies;
+
+  for (auto _ : state) {
+    blocking_workload(latencies, hot, [&](auto call) {
+      return pool.run(std::move(call), hot.get());
+    });
+  }
+  latencies.report(state);
+
+  auto const metrics = pool.metrics();
+  state.counters["peak_threads"] = static_cast<double>(metrics.peak_threads);
+  state.counters["mean_wait_us"] =
+      metrics.started == 0U
+          ? 0.0
+          : static_cast<double>(metrics.total_wait.count()) /
+                (1000.0 * static_cast<double>(metrics.started));
+}
+
+BENCHMARK(bm_blocking_offloaded)->UseRealTime();
+
+namespace {
+int const loop_producers = 2;
+
+/// A single threaded loop which guards its queue by a mutex
+class mutex_loop {
+public:
+  struct executor {
+    mutex_loop* loop;
+
+    template <typename Work>
+    void operator()(Work&& work) const {
+      loop->push(std::forward<Work>(work));
+    }
+  };
+
+  executor get() noexcept {
+    return executor{this};
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+      condition_.wait(lock, [&] { return stopped_ || !queue_.empty(); });
+      if (stopped_) {
+        stopped_ = false;
+        return;
+      }
+
+      cti::work work = std::move(queue_.front());
+      queue_.pop_front();
+
+      lock.unlock();
+      std::move(work)();
+      lock.lock();
+    }
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stopped_ = true;
+    }
+    condition_.notify_one();
+  }
+
+private:
+  void push(cti::work work) {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      queue_.push_back(std::move(work));
+    }
+    condition_.notify_one();
+  }
+
+  std::mutex lock_;
+  std::condition_variable condition_;
+  std::deque<cti::work> queue_;
+  bool stopped_ = false;
+};
+
+/// Sends completions from other threads to the loop until all arrived
+template <typename Loop>
+void loop_throughput(Loop& loop, bench::thread_pool& producers) {
+  int received = 0;
+
+  for (int producer = 0; producer != loop_producers; ++producer) {
+    cti::async_on(
+        [&] {
+          for (int i = 0; i != messages / loop_producers; ++i) {
+            cti::async_on(
+                [&] {
+                  if (++received == messages) {
+                    loop.stop();
+                  }
+                },
+                loop.get())
+                .done();
+          }
+        },
+        producers.get())
+        .done();
+  }
+
+  loop.run();
+}
+
+/// Bounces a message between the loop and a thread of the pool
+template <typename Loop>
+void loop_ping_pong(Loop& loop, bench::thread_pool& remote) {
+  auto round = std::make_shared<int>(0);
+  cti::loop([&, round] {
+    return cti::async_on([] {}, remote.get())
+        .then(
+            [round]() -> cti::loop_result<> {
+              if (++*round == ping_pong_rounds) {
+                return cti::loop_break();
+              }
+              return cti::loop_continue();
+            },
+            loop.get());
+  }).then([&] { loop.stop(); });
+
+  loop.run();
+}
+} // namespace
+
+static void bm_run_loop_throughput(benchmark::State& state) {
+  bench::thread_pool producers(loop_producers);
+  cti::run_loop loop;
+
+  for (auto _ : state) {
+    loop_throughput(loop, producers);
+  }
+  state.SetItemsProcessed(state.iterations() * messages);
+}
+
+BENCHMARK(bm_run_loop_throughput)->UseRealTime();
+
+static void bm_mutex_loop_throughput(benchmark::State& state) {
+  bench::thread_pool producers(loop_producers);
+  mutex_loop loop;
+
+  for (auto _ : state) {
+    loop_throughput(loop, producers);
+  }
+  state.SetItemsProcessed(state.iterations() * messages);
+}
+
+BENCHMARK(bm_mutex_loop_throughput)->UseRealTime();
+
+static void bm_run_loop_ping_pong(benchmark::State& state) {
+  bench::thread_pool remote(1);
+  cti::run_loop loop;
+
+  for (auto _ : state) {
+    loop_ping_pong(loop, remote);
+  }
+  state.counters["ns_per_round_trip"] = benchmark::Counter(
+      ping_pong_rounds, benchmark::Counter::kIsIterationInvariantRate |
+                            benchmark::Counter::kInvert);
+}
+
+BENCHMARK(bm_run_loop_ping_pong)->UseRealTime();
+
+static void bm_mutex_loop_ping_pong(benchmark::State& state) {
+  bench::thread_pool remote(1);
+  mutex_loop loop;
+
+  for (auto _ : state) {
+    loop_ping_pong(loop, remote);
+  }
+  state.counters["ns_per_round_trip"] = benchmark::Counter(
+      ping_pong_rounds, benchmark::Counter::kIsIterationInvariantRate |
+                            benchmark::Counter::kInvert);
+}
+
+BENCHMARK(bm_mutex_loop_ping_pong)->UseRealTime();
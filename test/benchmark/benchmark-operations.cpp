@@ -0,0 +1,450 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include <benchmark-support.hpp>
+
+static void bm_loop(benchmark::State& state) {
+  auto const iterations = static_cast<int>(state.range(0));
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    int counter = 0;
+    cti::loop([&] {
+      return bench::async_value(++counter)
+          .then([&](int value) -> cti::loop_result<int> {
+            if (value == iterations) {
+              return cti::loop_break(value);
+            }
+            return cti::loop_continue();
+          });
+    }).then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK(bm_loop)->ArgName("iterations")->RangeMultiplier(8)->Range(1, 64);
+
+static void bm_range_loop(benchmark::State& state) {
+  auto const iterations = static_cast<int>(state.range(0));
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::range_loop(
+        [](int step) {
+          return bench::async_value(step).then(
+              [](int value) { benchmark::DoNotOptimize(value); });
+        },
+        0, iterations)
+        .then([] { benchmark::ClobberMemory(); });
+  }
+}
+
+BENCHMARK(bm_range_loop)
+    ->ArgName("iterations")
+    ->RangeMultiplier(8)
+    ->Range(1, 64);
+
+/// Resolves multiple waiters through a single split promise
+static void bm_split(benchmark::State& state) {
+  auto const waiters = state.range(0);
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::promise<int> merged;
+    for (auto i = 0; i < waiters; ++i) {
+      cti::make_continuable<int>([&](auto&& promise) {
+        if (merged) {
+          merged = cti::split(std::move(merged),
+                              std::forward<decltype(promise)>(promise));
+        } else {
+          merged = std::forward<decltype(promise)>(promise);
+        }
+      }).then([](int value) { benchmark::DoNotOptimize(value); });
+    }
+
+    merged.set_value(1);
+  }
+}
+
+BENCHMARK(bm_split)->ArgName("waiters")->Arg(1)->Arg(8);
+
+/// Lookups which hit the cache, which shouldn't allocate
+/// apart from the copy of the cached value
+static void bm_async_cache_hit(benchmark::State& state) {
+  cti::async_cache<int, int> cache(1 << 16);
+  for (int key = 0; key < 256; ++key) {
+    cache.insert(key, key);
+  }
+
+  int key = 0;
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cache.get(key, [] { return bench::async_value(0); })
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+    key = (key + 1) % 256;
+  }
+}
+
+BENCHMARK(bm_async_cache_hit);
+
+namespace {
+/// A stand-in for a C library which stores a single pending callback
+struct c_request {
+  void (*callback)(void*, int, int);
+  void* user_data;
+  int value;
+};
+
+c_request pending_c_request;
+
+void c_async_call(int value, void (*callback)(void*, int, int),
+                  void* user_data) {
+  pending_c_request = c_request{callback, user_data, value};
+}
+
+void c_complete() {
+  c_request const request = pending_c_request;
+  request.callback(request.user_data, 0, request.value);
+}
+} // namespace
+
+/// Bridges a C callback through a heap allocated promise per call
+static void bm_promisify_c_trampoline(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::make_continuable<int, int>([](auto&& promise) {
+      using promise_t = std::decay_t<decltype(promise)>;
+      c_async_call(
+          1,
+          [](void* user_data, int error, int value) {
+            std::unique_ptr<promise_t> promise(
+                static_cast<promise_t*>(user_data));
+            std::move(*promise).set_value(error, value);
+          },
+          new promise_t(std::forward<decltype(promise)>(promise)));
+    }).then([](int error, int value) {
+      benchmark::DoNotOptimize(error);
+      benchmark::DoNotOptimize(value);
+    });
+    c_complete();
+  }
+}
+
+BENCHMARK(bm_promisify_c_trampoline);
+
+/// Bridges a C callback through a recycled slot of promisify_c
+static void bm_promisify_c(benchmark::State& state) {
+  cti::promisify_c<int, int> promisify(1);
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    promisify
+        .from([](void (*callback)(void*, int, int),
+                 void* user_data) { c_async_call(1, callback, user_data); })
+        .then([](int error, int value) {
+          benchmark::DoNotOptimize(error);
+          benchmark::DoNotOptimize(value);
+        });
+    c_complete();
+  }
+}
+
+BENCHMARK(bm_promisify_c);
+
+/// Processes every element through its own work and a when_all
+static void bm_parallel_async_on_when_all(benchmark::State& state) {
+  bench::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> values(std::size_t(1) << 14, 1.f);
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    std::vector<cti::continuable<>> elements;
+    elements.reserve(values.size());
+    for (float& value : values) {
+      elements.push_back(cti::async_on(
+          [&value] { value = value * 1.5f + 1.f; }, pool.get()));
+    }
+    cti::when_all(std::move(elements)).apply(cti::transforms::wait());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(values.size()));
+}
+
+BENCHMARK(bm_parallel_async_on_when_all)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+
+static void bm_parallel_for(benchmark::State& state) {
+  bench::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> values(std::size_t(1) << state.range(1), 1.f);
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::parallel_for(pool.get(), values, 4096,
+                      [](float& value) { value = value * 1.5f + 1.f; })
+        .apply(cti::transforms::wait());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(values.size()));
+}
+
+BENCHMARK(bm_parallel_for)
+    ->ArgNames({"threads", "log2_size"})
+    ->ArgsProduct({{1, 2, 4, 8}, {14, 20}})
+    ->UseRealTime();
+
+static void bm_parallel_transform(benchmark::State& state) {
+  bench::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  std::vector<double> input(std::size_t(1) << 20);
+  std::iota(input.begin(), input.end(), 0.);
+  std::vector<double> output(input.size());
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::parallel_transform(pool.get(), input, output, 4096,
+                            [](double value) { return value * value + 1.; })
+        .apply(cti::transforms::wait());
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(input.size()));
+}
+
+BENCHMARK(bm_parallel_transform)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+namespace {
+/// The affine map x -> a * x + b, the composition of affine maps is
+/// associative but not commutative.
+struct affine {
+  std::uint32_t a;
+  std::uint32_t b;
+};
+
+affine compose(affine const& first, affine const& second) {
+  return {second.a * first.a, second.a * first.b + second.b};
+}
+
+std::size_t const reduce_chunk = 4096;
+} // namespace
+
+/// Sums chunks through async_on and when_all followed by a serial fold
+static void bm_parallel_reduce_when_all_fold(benchmark::State& state) {
+  bench::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::uint64_t> values(std::size_t(1) << 20);
+  std::iota(values.begin(), values.end(), std::uint64_t(0));
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    std::vector<cti::continuable<std::uint64_t>> chunks;
+    for (std::size_t begin = 0; begin < values.size(); begin += reduce_chunk) {
+      chunks.push_back(cti::async_on(
+          [&values, begin] {
+            return std::accumulate(values.begin() + begin,
+                                   values.begin() + begin + reduce_chunk,
+                                   std::uint64_t(0));
+          },
+          pool.get()));
+    }
+    auto sum = cti::when_all(std::move(chunks))
+                   .then([](std::vector<std::uint64_t> partials) {
+                     return std::accumulate(partials.begin(), partials.end(),
+                                            std::uint64_t(0));
+                   })
+                   .apply(cti::transforms::wait());
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(values.size()));
+}
+
+BENCHMARK(bm_parallel_reduce_when_all_fold)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+/// Reduces through a commutative operation
+static void bm_parallel_reduce_sum(benchmark::State& state) {
+  bench::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::uint64_t> values(std::size_t(1) << 20);
+  std::iota(values.begin(), values.end(), std::uint64_t(0));
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    auto sum = cti::parallel_reduce(pool.get(), values, std::uint64_t(0),
+                                    std::plus<>{}, reduce_chunk)
+                   .apply(cti::transforms::wait());
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(values.size()));
+}
+
+BENCHMARK(bm_parallel_reduce_sum)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+/// Reduces through an associative but not commutative operation
+static void bm_parallel_reduce_affine(benchmark::State& state) {
+  bench::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  std::vector<affine> values(std::size_t(1) << 20);
+  for (std::size_t i = 0; i != values.size(); ++i) {
+    values[i] = {static_cast<std::uint32_t>(i | 1U),
+                 static_cast<std::uint32_t>(i)};
+  }
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    auto composed = cti::parallel_reduce(pool.get(), values, affine{1U, 0U},
+                                         compose, reduce_chunk)
+                        .apply(cti::transforms::wait());
+    benchmark::DoNotOptimize(composed);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(values.size()));
+}
+
+BENCHMARK(bm_parallel_reduce_affine)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+namespace {
+int const hedged_requests = 200;
+
+/// A simulated backend which answers 95% of the requests after 1ms and
+/// the remaining ones after 20ms, the latencies are waited for on a
+/// cti::timer_queue.
+class simulated_backend {
+public:
+  cti::continuable<int> request() {
+    attempts_.fetch_add(1, std::memory_order_relaxed);
+    return timers_.wait_for(latency()).then([] { return 1; });
+  }
+
+  cti::timer_queue& timers() noexcept {
+    return timers_;
+  }
+
+  std::int64_t attempts() const noexcept {
+    return attempts_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::chrono::milliseconds latency() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return (std::uniform_int_distribution<int>(0, 99)(random_) < 5)
+               ? std::chrono::milliseconds(20)
+               : std::chrono::milliseconds(1);
+  }
+
+  std::mutex lock_;
+  std::minstd_rand random_{42};
+  std::atomic<std::int64_t> attempts_{0};
+  cti::timer_queue timers_;
+};
+
+/// Starts concurrent requests through the given callable and reports the
+/// latency percentiles and the attempts per request.
+template <typename Request>
+void run_latency_distribution(benchmark::State& state,
+                              simulated_backend& backend, Request&& request) {
+  std::mutex lock;
+  std::vector<double> latencies;
+
+  for (auto _ : state) {
+    std::promise<void> done;
+    std::atomic<int> remaining{hedged_requests};
+
+    for (int i = 0; i != hedged_requests; ++i) {
+      auto const started = std::chrono::steady_clock::now();
+      request().then([&, started](int) {
+        auto const latency = std::chrono::steady_clock::now() - started;
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          latencies.push_back(
+              std::chrono::duration<double, std::milli>(latency).count());
+        }
+        if (remaining.fetch_sub(1) == 1) {
+          done.set_value();
+        }
+      });
+    }
+
+    done.get_future().wait();
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  state.counters["p50_ms"] = latencies[latencies.size() / 2U];
+  state.counters["p99_ms"] = latencies[(latencies.size() * 99U) / 100U];
+  state.counters["attempts"] = static_cast<double>(backend.attempts()) /
+                               static_cast<double>(latencies.size());
+  state.SetItemsProcessed(static_cast<std::int64_t>(latencies.size()));
+}
+} // namespace
+
+static void bm_latency_unhedged(benchmark::State& state) {
+  simulated_backend backend;
+  run_latency_distribution(state, backend,
+                           [&] { return backend.request(); });
+}
+
+BENCHMARK(bm_latency_unhedged)->Iterations(20)->UseRealTime();
+
+static void bm_latency_hedged(benchmark::State& state) {
+  simulated_backend backend;
+  run_latency_distribution(state, backend, [&] {
+    return cti::hedge(std::chrono::milliseconds(2), std::ref(backend.timers()),
+                      [&] { return backend.request(); });
+  });
+}
+
+BENCHMARK(bm_latency_hedged)->Iterations(20)->UseRealTime();
@@ -0,0 +1,104 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <string>
+#include <utility>
+#include <benchmark-support.hpp>
+
+namespace {
+template <typename Result>
+struct result_factory;
+template <>
+struct result_factory<cti::result<>> {
+  static cti::result<> make() {
+    return cti::make_result();
+  }
+};
+template <>
+struct result_factory<cti::result<int>> {
+  static cti::result<int> make() {
+    return cti::make_result(1);
+  }
+};
+template <>
+struct result_factory<cti::result<int, int>> {
+  static cti::result<int, int> make() {
+    return cti::make_result(1, 2);
+  }
+};
+template <>
+struct result_factory<cti::result<std::string>> {
+  static cti::result<std::string> make() {
+    return cti::make_result(std::string("result"));
+  }
+};
+} // namespace
+
+/// Moves a result back and forth like it happens when it is passed
+/// through the frames of connections and transforms.
+template <typename Result>
+static void bm_result_move(benchmark::State& state) {
+  Result current = result_factory<Result>::make();
+  for (auto _ : state) {
+    for (int i = 0; i < 16; ++i) {
+      Result moved(std::move(current));
+      benchmark::DoNotOptimize(&moved);
+      current = std::move(moved);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 32);
+}
+
+BENCHMARK_TEMPLATE(bm_result_move, cti::result<>);
+BENCHMARK_TEMPLATE(bm_result_move, cti::result<int>);
+BENCHMARK_TEMPLATE(bm_result_move, cti::result<int, int>);
+BENCHMARK_TEMPLATE(bm_result_move, cti::result<std::string>);
+
+static void bm_when_all_small_void(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_all(cti::make_ready_continuable(), cti::make_ready_continuable(),
+                  cti::make_ready_continuable(), cti::make_ready_continuable(),
+                  cti::make_ready_continuable(), cti::make_ready_continuable(),
+                  cti::make_ready_continuable(), cti::make_ready_continuable())
+        .then([] { benchmark::ClobberMemory(); });
+  }
+}
+
+BENCHMARK(bm_when_all_small_void);
+
+static void bm_when_all_small_int(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::when_all(cti::make_ready_continuable(0), cti::make_ready_continuable(1),
+                  cti::make_ready_continuable(2), cti::make_ready_continuable(3),
+                  cti::make_ready_continuable(4), cti::make_ready_continuable(5),
+                  cti::make_ready_continuable(6), cti::make_ready_continuable(7))
+        .then([](int a, int b, int c, int d, int e, int f, int g, int h) {
+          benchmark::DoNotOptimize(a + b + c + d + e + f + g + h);
+        });
+  }
+}
+
+BENCHMARK(bm_when_all_small_int);
@@ -0,0 +1,228 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_BENCHMARK_SUPPORT_HPP_INCLUDED
+#define CONTINUABLE_BENCHMARK_SUPPORT_HPP_INCLUDED
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <continuable/continuable.hpp>
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+#include <exception>
+#include <stdexcept>
+#else
+#include <system_error>
+#endif
+
+namespace bench {
+/// The count and size of the heap allocations done by the current thread
+struct allocation_stats {
+  std::uint64_t count;
+  std::uint64_t bytes;
+};
+
+/// Returns the allocations done by the current thread so far,
+/// which are counted by the replaced global operator new.
+allocation_stats allocations() noexcept;
+
+/// Returns the highest count of bytes which were alive at once on the
+/// current thread since the last call to reset_peak_bytes().
+std::uint64_t peak_bytes() noexcept;
+
+/// Starts a new peak measurement at the bytes which are alive now.
+void reset_peak_bytes() noexcept;
+
+/// Returns the count of bytes which are alive on the current thread.
+std::uint64_t alive_bytes() noexcept;
+
+/// Reports the allocations done by the benchmark loop per iteration
+/// through the `allocs` and `bytes` counters when leaving the scope.
+///
+/// Construct it directly before the benchmark loop.
+class allocation_report {
+public:
+  explicit allocation_report(benchmark::State& state)
+      : state_(state), begin_(allocations()) {
+  }
+  ~allocation_report() {
+    allocation_stats const end = allocations();
+    state_.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(end.count - begin_.count),
+                           benchmark::Counter::kAvgIterations);
+    state_.counters["bytes"] =
+        benchmark::Counter(static_cast<double>(end.bytes - begin_.bytes),
+                           benchmark::Counter::kAvgIterations);
+  }
+
+  allocation_report(allocation_report const&) = delete;
+  allocation_report& operator=(allocation_report const&) = delete;
+
+private:
+  benchmark::State& state_;
+  allocation_stats begin_;
+};
+
+/// Reports the highest count of bytes which were alive at once during
+/// the benchmark loop through the `peak` counter when leaving the scope.
+///
+/// Construct it directly before the benchmark loop.
+class peak_report {
+public:
+  explicit peak_report(benchmark::State& state)
+      : state_(state), begin_(alive_bytes()) {
+    reset_peak_bytes();
+  }
+  ~peak_report() {
+    state_.counters["peak"] = static_cast<double>(peak_bytes() - begin_);
+  }
+
+  peak_report(peak_report const&) = delete;
+  peak_report& operator=(peak_report const&) = delete;
+
+private:
+  benchmark::State& state_;
+  std::uint64_t begin_;
+};
+
+/// An executor which queues the work until it is drained explicitly,
+/// which resembles a single threaded event loop.
+class queue_executor {
+public:
+  struct executor {
+    std::deque<cti::work>* queue;
+
+    template <typename Work>
+    void operator()(Work&& work) const {
+      queue->emplace_back(std::forward<Work>(work));
+    }
+  };
+
+  executor get() noexcept {
+    return executor{&queue_};
+  }
+
+  void drain() {
+    while (!queue_.empty()) {
+      cti::work work = std::move(queue_.front());
+      queue_.pop_front();
+      std::move(work)();
+    }
+  }
+
+private:
+  std::deque<cti::work> queue_;
+};
+
+/// A fixed size pool of threads which share a single queue of work.
+class thread_pool {
+public:
+  struct executor {
+    thread_pool* pool;
+
+    template <typename Work>
+    void operator()(Work&& work) const {
+      pool->push(std::forward<Work>(work));
+    }
+  };
+
+  explicit thread_pool(std::size_t threads) {
+    for (std::size_t i = 0; i != threads; ++i) {
+      threads_.emplace_back([this] { run(); });
+    }
+  }
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stopped_ = true;
+    }
+    condition_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  thread_pool(thread_pool const&) = delete;
+  thread_pool& operator=(thread_pool const&) = delete;
+
+  executor get() noexcept {
+    return executor{this};
+  }
+
+private:
+  void push(cti::work work) {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      queue_.push_back(std::move(work));
+    }
+    condition_.notify_one();
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+      condition_.wait(lock, [&] { return stopped_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+
+      cti::work work = std::move(queue_.front());
+      queue_.pop_front();
+
+      lock.unlock();
+      std::move(work)();
+      lock.lock();
+    }
+  }
+
+  std::mutex lock_;
+  std::condition_variable condition_;
+  std::deque<cti::work> queue_;
+  bool stopped_ = false;
+  std::vector<std::thread> threads_;
+};
+
+/// Returns a continuable which resolves asynchronously from the
+/// perspective of the library, but on the current thread.
+inline auto async_value(int value) {
+  return cti::make_continuable<int>(
+      [value](auto&& promise) { promise.set_value(value); });
+}
+
+inline cti::exception_t make_error() {
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+  return std::make_exception_ptr(std::runtime_error("benchmark"));
+#else
+  return std::make_error_condition(std::errc::io_error);
+#endif
+}
+} // namespace bench
+
+#endif // CONTINUABLE_BENCHMARK_SUPPORT_HPP_INCLUDED
@@ -0,0 +1,107 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <benchmark-support.hpp>
+#include <continuable/detail/features.hpp>
+
+static void bm_wait(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        bench::async_value(1).apply(cti::transforms::wait()));
+  }
+}
+
+BENCHMARK(bm_wait);
+
+static void bm_to_future(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        bench::async_value(1).apply(cti::transforms::to_future()).get());
+  }
+}
+
+BENCHMARK(bm_to_future);
+
+namespace {
+template <typename Callback>
+void async_supply(int value, Callback&& callback) {
+  std::forward<Callback>(callback)(cti::exception_t{}, value);
+}
+} // namespace
+
+static void bm_promisify(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    cti::promisify<int>::from(
+        [](auto&&... args) {
+          async_supply(std::forward<decltype(args)>(args)...);
+        },
+        1)
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK(bm_promisify);
+
+#if defined(CONTINUABLE_HAS_COROUTINE)
+namespace {
+cti::continuable<int> await_chain(int depth) {
+  int sum = 0;
+  for (int i = 0; i < depth; ++i) {
+    sum += co_await bench::async_value(i);
+  }
+  co_return sum;
+}
+} // namespace
+
+static void bm_co_await(benchmark::State& state) {
+  auto const depth = static_cast<int>(state.range(0));
+
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    await_chain(depth).then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK(bm_co_await)->ArgName("depth")->Arg(1)->Arg(8);
+
+namespace {
+cti::continuable<> await_canceled() {
+  co_await cti::make_cancelling_continuable<void>();
+  co_return;
+}
+} // namespace
+
+static void bm_co_await_canceled(benchmark::State& state) {
+  bench::allocation_report report(state);
+  for (auto _ : state) {
+    await_canceled().fail([](cti::exception_t exception) {
+      benchmark::DoNotOptimize(exception);
+    });
+  }
+}
+
+BENCHMARK(bm_co_await_canceled);
+#endif // CONTINUABLE_HAS_COROUTINE
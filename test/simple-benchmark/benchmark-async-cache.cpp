@@ -0,0 +1,114 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <continuable/continuable.hpp>
+
+namespace {
+using cache_t = cti::async_cache<int, std::shared_ptr<int const>>;
+
+constexpr int key_space = 1 << 14;
+
+auto load(int key) {
+  return cti::make_ready_continuable(std::make_shared<int const>(key));
+}
+
+std::vector<int> uniform_keys(std::size_t count, int keys) {
+  std::mt19937 engine(36354);
+  std::uniform_int_distribution<int> distribution(0, keys - 1);
+
+  std::vector<int> sequence;
+  sequence.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    sequence.push_back(distribution(engine));
+  }
+  return sequence;
+}
+
+cache_t& shared_cache() {
+  static cache_t cache(1 << 24);
+  return cache;
+}
+} // namespace
+
+/// Lookups which always hit the cache
+static void bm_async_cache_hit(benchmark::State& state) {
+  cache_t& cache = shared_cache();
+  if (state.thread_index() == 0) {
+    for (int key = 0; key < key_space; ++key) {
+      cache.insert(key, std::make_shared<int const>(key));
+    }
+  }
+
+  auto const keys = uniform_keys(1 << 12, key_space);
+  std::size_t position = static_cast<std::size_t>(state.thread_index()) * 131;
+
+  for (auto _ : state) {
+    int const key = keys[position++ % keys.size()];
+    cache.get(key, [key] { return load(key); })
+        .then([](std::shared_ptr<int const> value) {
+          benchmark::DoNotOptimize(value);
+        });
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_async_cache_hit)
+    ->Threads(1)
+    ->Threads(8)
+    ->Threads(16)
+    ->Threads(32)
+    ->Threads(64)
+    ->UseRealTime();
+
+/// Lookups with a budget which only holds a quarter of the key space
+static void bm_async_cache_mixed(benchmark::State& state) {
+  static cache_t cache(key_space / 4 * (sizeof(int) + sizeof(void*) * 2));
+
+  auto const keys = uniform_keys(1 << 16, key_space);
+  std::size_t position = static_cast<std::size_t>(state.thread_index()) * 131;
+
+  for (auto _ : state) {
+    int const key = keys[position++ % keys.size()];
+    cache.get(key, [key] { return load(key); })
+        .then([](std::shared_ptr<int const> value) {
+          benchmark::DoNotOptimize(value);
+        });
+  }
+
+  if (state.thread_index() == 0) {
+    auto const stats = cache.stats();
+    state.counters["hit_ratio"] =
+        static_cast<double>(stats.hits) /
+        static_cast<double>(stats.hits + stats.misses);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_async_cache_mixed)
+    ->Threads(1)
+    ->Threads(8)
+    ->Threads(16)
+    ->Threads(32)
+    ->Threads(64)
+    ->UseRealTime();
+
+/// The baseline which wraps manually cached values into ready continuables
+static void bm_manual_ready_continuable(benchmark::State& state) {
+  auto const value = std::make_shared<int const>(0);
+
+  for (auto _ : state) {
+    cti::continuable<std::shared_ptr<int const>> c =
+        cti::make_ready_continuable(value);
+    std::move(c).then([](std::shared_ptr<int const> value) {
+      benchmark::DoNotOptimize(value);
+    });
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_manual_ready_continuable)->Threads(1)->Threads(8)->UseRealTime();
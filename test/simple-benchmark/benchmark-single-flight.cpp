@@ -0,0 +1,131 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <continuable/continuable.hpp>
+
+namespace {
+/// Returns a sequence of keys in [0, keys) which follows a zipf distribution
+std::vector<int> zipf_keys(std::size_t count, int keys, double skew) {
+  std::vector<double> weights;
+  weights.reserve(keys);
+  for (int rank = 1; rank <= keys; ++rank) {
+    weights.push_back(1.0 / std::pow(rank, skew));
+  }
+
+  std::mt19937 engine(36354);
+  std::discrete_distribution<int> distribution(weights.begin(), weights.end());
+
+  std::vector<int> sequence;
+  sequence.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    sequence.push_back(distribution(engine));
+  }
+  return sequence;
+}
+
+/// A backend stand-in which keeps all requests pending until flushed
+struct pending_backend {
+  std::vector<cti::promise<int>> requests;
+  std::size_t calls = 0;
+
+  auto request(int key) {
+    ++calls;
+    return cti::make_continuable<int>([this, key](auto&& promise) {
+      (void)key;
+      requests.emplace_back(std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  void flush() {
+    for (auto& request : requests) {
+      std::move(request).set_value(0);
+    }
+    requests.clear();
+  }
+};
+
+constexpr std::size_t batch_size = 256;
+} // namespace
+
+/// Issues batches of concurrent lookups with zipf distributed keys,
+/// all lookups of a batch are in flight at the same time.
+static void bm_single_flight_zipf(benchmark::State& state) {
+  auto const keys = zipf_keys(1 << 16, static_cast<int>(state.range(0)), 1.0);
+
+  cti::single_flight<int, int> flights;
+  pending_backend backend;
+  std::size_t lookups = 0;
+  std::size_t position = 0;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch_size; ++i) {
+      int const key = keys[position++ % keys.size()];
+      flights.get(key, [&backend, key] { return backend.request(key); })
+          .then([](int value) { benchmark::DoNotOptimize(value); });
+    }
+    backend.flush();
+    lookups += batch_size;
+  }
+
+  state.counters["backend_calls_per_lookup"] =
+      static_cast<double>(backend.calls) / static_cast<double>(lookups);
+  state.SetItemsProcessed(static_cast<std::int64_t>(lookups));
+}
+
+BENCHMARK(bm_single_flight_zipf)->Arg(64)->Arg(1024)->Arg(16384);
+
+/// The same workload as above without any request coalescing
+static void bm_direct_zipf(benchmark::State& state) {
+  auto const keys = zipf_keys(1 << 16, static_cast<int>(state.range(0)), 1.0);
+
+  pending_backend backend;
+  std::size_t lookups = 0;
+  std::size_t position = 0;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch_size; ++i) {
+      int const key = keys[position++ % keys.size()];
+      backend.request(key).then(
+          [](int value) { benchmark::DoNotOptimize(value); });
+    }
+    backend.flush();
+    lookups += batch_size;
+  }
+
+  state.counters["backend_calls_per_lookup"] =
+      static_cast<double>(backend.calls) / static_cast<double>(lookups);
+  state.SetItemsProcessed(static_cast<std::int64_t>(lookups));
+}
+
+BENCHMARK(bm_direct_zipf)->Arg(64)->Arg(1024)->Arg(16384);
+
+/// Measures the overhead of a single uncontended lookup
+static void bm_single_flight_overhead(benchmark::State& state) {
+  cti::single_flight<int, int> flights;
+
+  int key = 0;
+  for (auto _ : state) {
+    flights.get(++key, [] { return cti::make_ready_continuable(0); })
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK(bm_single_flight_overhead);
+
+/// Concurrent lookups of a small key set from multiple threads
+static void bm_single_flight_threads(benchmark::State& state) {
+  static cti::single_flight<int, int> flights;
+  auto const keys = zipf_keys(1 << 12, 1024, 1.0);
+
+  std::size_t position = static_cast<std::size_t>(state.thread_index()) * 97;
+  for (auto _ : state) {
+    int const key = keys[position++ % keys.size()];
+    flights.get(key, [] { return cti::make_ready_continuable(0); })
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+}
+
+BENCHMARK(bm_single_flight_threads)->ThreadRange(1, 16)->UseRealTime();
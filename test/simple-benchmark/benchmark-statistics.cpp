@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstddef>
+#include <benchmark/benchmark.h>
+
+#define CONTINUABLE_WITH_STAGE_STATISTICS
+#include <continuable/continuable.hpp>
+
+namespace {
+constexpr std::size_t stage_count = 8;
+
+/// An executor which runs the work immediately but isn't
+/// recognized as inline, such that the queue wait is measured as well.
+struct immediate_executor {
+  template <typename Work>
+  void operator()(Work&& work) const {
+    std::forward<Work>(work)();
+  }
+};
+
+template <typename Continuable>
+auto add_stage(Continuable&& continuable, bool labeled) {
+  auto chained = std::forward<Continuable>(continuable).then([](int value) {
+    benchmark::DoNotOptimize(value);
+    return value + 1;
+  });
+  return labeled ? std::move(chained).apply(cti::label("benchmark"))
+                 : std::move(chained);
+}
+
+template <typename Continuable>
+auto add_executor_stage(Continuable&& continuable, bool labeled) {
+  auto chained = std::forward<Continuable>(continuable).then(
+      [](int value) {
+        benchmark::DoNotOptimize(value);
+        return value + 1;
+      },
+      immediate_executor{});
+  return labeled ? std::move(chained).apply(cti::label("benchmark-executor"))
+                 : std::move(chained);
+}
+
+template <typename Continuable, typename Stage>
+auto add_stages(Continuable&& continuable, Stage stage, bool labeled) {
+  auto c1 = stage(std::forward<Continuable>(continuable), labeled);
+  auto c2 = stage(std::move(c1), labeled);
+  auto c3 = stage(std::move(c2), labeled);
+  auto c4 = stage(std::move(c3), labeled);
+  auto c5 = stage(std::move(c4), labeled);
+  auto c6 = stage(std::move(c5), labeled);
+  auto c7 = stage(std::move(c6), labeled);
+  return stage(std::move(c7), labeled);
+}
+} // namespace
+
+/// Chains of inline stages, the difference between the labeled and the
+/// unlabeled run is the overhead of recording the run time per stage.
+static void bm_inline_stages(benchmark::State& state) {
+  bool const labeled = state.range(0) != 0;
+  for (auto _ : state) {
+    add_stages(
+        cti::make_ready_continuable(0),
+        [](auto&& c, bool l) {
+          return add_stage(std::forward<decltype(c)>(c), l);
+        },
+        labeled)
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+  state.SetItemsProcessed(state.iterations() * stage_count);
+}
+
+BENCHMARK(bm_inline_stages)->ArgName("labeled")->Arg(0)->Arg(1);
+
+/// Chains of stages which are submitted to an executor, the difference
+/// between the labeled and the unlabeled run is the overhead of recording
+/// the run time and the queue wait per stage.
+static void bm_executor_stages(benchmark::State& state) {
+  bool const labeled = state.range(0) != 0;
+  for (auto _ : state) {
+    add_stages(
+        cti::make_ready_continuable(0),
+        [](auto&& c, bool l) {
+          return add_executor_stage(std::forward<decltype(c)>(c), l);
+        },
+        labeled)
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+  state.SetItemsProcessed(state.iterations() * stage_count);
+}
+
+BENCHMARK(bm_executor_stages)->ArgName("labeled")->Arg(0)->Arg(1);
+
+/// Concurrent recording into the per-thread histograms
+static void bm_concurrent_stages(benchmark::State& state) {
+  for (auto _ : state) {
+    add_stages(
+        cti::make_ready_continuable(0),
+        [](auto&& c, bool l) {
+          return add_stage(std::forward<decltype(c)>(c), l);
+        },
+        true)
+        .then([](int value) { benchmark::DoNotOptimize(value); });
+  }
+  state.SetItemsProcessed(state.iterations() * stage_count);
+}
+
+BENCHMARK(bm_concurrent_stages)->Threads(1)->Threads(4)->Threads(8);
+
+/// The cost of reading the steady_clock for comparison
+static void bm_clock_now(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+  }
+}
+
+BENCHMARK(bm_clock_now);
+
+/// The cost of reading the clock stages are timed with, which is read once
+/// per boundary: a labeled stage reuses the end of the labeled stage it
+/// directly follows as its start or as its submission to an executor.
+static void bm_stage_clock_now(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cti::detail::statistics::now());
+  }
+}
+
+BENCHMARK(bm_stage_clock_now);
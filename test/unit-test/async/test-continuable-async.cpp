@@ -195,6 +195,59 @@ TYPED_TEST(single_dimension_tests, token_remap_ignore) {
   ASSERT_TRUE(value.is_value());
 }
 
+TYPED_TEST(single_dimension_tests, token_error_code_value) {
+  asio::io_context io(1);
+
+  result<asio_error_code_t, std::size_t> value;
+  asio::async_initiate<decltype(use_continuable_ec) const&,
+                       void(asio_error_code_t, std::size_t)>(
+      [](auto&& handler) {
+        std::forward<decltype(handler)>(handler)(
+            asio_error_code_t(asio::error::connection_reset), 0U);
+      },
+      use_continuable_ec)
+      .next([&](auto&&... args) {
+        value = result<asio_error_code_t, std::size_t>::from(
+            std::forward<decltype(args)>(args)...);
+      });
+
+  ASSERT_TRUE(value.is_value());
+  EXPECT_EQ(get<0>(value), asio::error::connection_reset);
+}
+
+TYPED_TEST(single_dimension_tests, token_error_code_canceled) {
+  asio::io_context io(1);
+  asio::steady_timer timer(io, 50ms);
+
+  result<asio_error_code_t> value;
+  timer.async_wait(use_continuable_ec).next([&](auto&&... args) {
+    value = result<asio_error_code_t>::from(
+        std::forward<decltype(args)>(args)...);
+  });
+
+  timer.cancel();
+  io.run();
+
+  ASSERT_TRUE(value.is_exception());
+  ASSERT_FALSE(bool(value.get_exception()));
+}
+
+TYPED_TEST(single_dimension_tests, token_error_code_success) {
+  asio::io_context io(1);
+  asio::steady_timer timer(io, 1ms);
+
+  result<asio_error_code_t> value;
+  timer.async_wait(use_continuable_ec).next([&](auto&&... args) {
+    value = result<asio_error_code_t>::from(
+        std::forward<decltype(args)>(args)...);
+  });
+
+  io.run();
+
+  ASSERT_TRUE(value.is_value());
+  EXPECT_FALSE(bool(value.get_value()));
+}
+
 TYPED_TEST(single_dimension_tests, wait_test_issue_46) {
   bool handled = false;
   make_exceptional_continuable<void>(supply_test_exception())
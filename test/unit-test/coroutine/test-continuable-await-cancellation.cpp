@@ -0,0 +1,129 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <gtest/gtest.h>
+
+#define CONTINUABLE_WITH_DIRECT_AWAIT_CANCELLATION
+#include <continuable/continuable.hpp>
+
+#if defined(CONTINUABLE_HAS_COROUTINE) && defined(CONTINUABLE_HAS_EXCEPTIONS)
+
+#  include <exception>
+#  include <stdexcept>
+
+namespace {
+/// Sets the given flag when the coroutine frame is destroyed
+struct frame_guard {
+  bool& destroyed;
+
+  ~frame_guard() {
+    destroyed = true;
+  }
+};
+
+cti::continuable<> canceled_coroutine(bool& destroyed, bool& caught) {
+  frame_guard guard{destroyed};
+
+  try {
+    co_await cti::make_cancelling_continuable<void>();
+  } catch (...) {
+    // Cancellations aren't thrown
+    caught = true;
+  }
+
+  EXPECT_TRUE(false);
+  co_return;
+}
+
+cti::continuable<int> canceled_async_coroutine(cti::promise<>& resolver,
+                                               bool& destroyed) {
+  frame_guard guard{destroyed};
+
+  co_await cti::make_continuable<void>([&](cti::promise<> promise) {
+    resolver = std::move(promise);
+  });
+
+  EXPECT_TRUE(false);
+  co_return 0;
+}
+
+cti::continuable<> failing_coroutine(bool& caught) {
+  try {
+    co_await cti::make_exceptional_continuable<void>(
+        std::make_exception_ptr(std::runtime_error("error")));
+  } catch (std::runtime_error const&) {
+    caught = true;
+  }
+  co_return;
+}
+
+bool is_canceled(cti::exception_t const& exception) {
+  return !bool(exception);
+}
+} // namespace
+
+TEST(await_cancellation_test, ready_cancellation_destroys_the_frame) {
+  bool destroyed = false;
+  bool caught = false;
+  bool canceled = false;
+
+  canceled_coroutine(destroyed, caught)
+      .then([] { EXPECT_TRUE(false); })
+      .fail([&](cti::exception_t exception) {
+        EXPECT_TRUE(destroyed);
+        canceled = is_canceled(exception);
+      });
+
+  EXPECT_TRUE(canceled);
+  EXPECT_FALSE(caught);
+}
+
+TEST(await_cancellation_test, async_cancellation_destroys_the_frame) {
+  cti::promise<> resolver;
+  bool destroyed = false;
+  bool canceled = false;
+
+  canceled_async_coroutine(resolver, destroyed)
+      .then([](int) { EXPECT_TRUE(false); })
+      .fail([&](cti::exception_t exception) {
+        canceled = is_canceled(exception);
+      });
+
+  ASSERT_FALSE(destroyed);
+  resolver.set_canceled();
+
+  EXPECT_TRUE(destroyed);
+  EXPECT_TRUE(canceled);
+}
+
+TEST(await_cancellation_test, errors_are_still_thrown) {
+  bool caught = false;
+  bool resolved = false;
+
+  failing_coroutine(caught).then([&] { resolved = true; });
+
+  EXPECT_TRUE(caught);
+  EXPECT_TRUE(resolved);
+}
+
+#endif // defined(CONTINUABLE_HAS_COROUTINE) && ...
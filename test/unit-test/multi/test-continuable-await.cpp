@@ -171,4 +171,60 @@ TYPED_TEST(single_dimension_tests, are_awaitable_with_cancellation_from_coro) {
 
 #  endif // CONTINUABLE_WITH_NO_EXCEPTIONS
 
+#  ifdef CONTINUABLE_WITH_NO_EXCEPTIONS
+
+/// Sets the given flag when the coroutine frame is destroyed
+struct frame_guard {
+  bool& destroyed;
+
+  ~frame_guard() {
+    destroyed = true;
+  }
+};
+
+template <typename S, typename C>
+cti::continuable<> resolve_coro_forwarded(S&& supplier, C&& continuable,
+                                          bool& destroyed) {
+  frame_guard guard{destroyed};
+
+  // Pseudo wait
+  co_await supplier();
+
+  co_await std::forward<C>(continuable);
+
+  // The coroutine isn't resumed on cancellation
+  EXPECT_TRUE(false);
+  co_return;
+}
+
+TYPED_TEST(single_dimension_tests, are_awaitable_with_cancellation_noexcept) {
+  auto const& supply = [&](auto&&... args) {
+    // Supplies the current tested continuable
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  bool destroyed = false;
+  ASSERT_ASYNC_CANCELLATION(resolve_coro_forwarded(
+      supply, cti::make_cancelling_continuable<void>(), destroyed))
+  ASSERT_TRUE(destroyed);
+}
+
+TYPED_TEST(single_dimension_tests, are_awaitable_with_errors_noexcept) {
+  auto const& supply = [&](auto&&... args) {
+    // Supplies the current tested continuable
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  bool destroyed = false;
+  ASSERT_ASYNC_EXCEPTION_RESULT(
+      resolve_coro_forwarded(
+          supply,
+          cti::make_exceptional_continuable<void>(supply_test_exception()),
+          destroyed),
+      get_test_exception_proto())
+  ASSERT_TRUE(destroyed);
+}
+
+#  endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
 #endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
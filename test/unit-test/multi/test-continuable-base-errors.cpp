@@ -89,6 +89,33 @@ TYPED_TEST(single_dimension_tests, are_yielding_errors_from_handlers) {
   ASSERT_ASYNC_EXCEPTION_RESULT(std::move(continuation),
                                 get_test_exception_proto());
 }
+
+TYPED_TEST(single_dimension_tests, are_yielding_errors_after_noexcept_handlers) {
+  auto continuation = this->supply()
+                          .then([]() noexcept { return 1; })
+                          .then([](int value) {
+                            // Throw an error from inside the handler
+                            if (value == 1) {
+                              throw test_exception();
+                            }
+                          })
+                          .then([]() noexcept {});
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(std::move(continuation),
+                                get_test_exception_proto());
+}
+
+TYPED_TEST(single_dimension_tests, are_yielding_errors_from_fail_handlers) {
+  auto continuation =
+      this->supply_exception(supply_test_exception())
+          .fail([](cti::exception_t) { throw test_exception(); })
+          .fail([](cti::exception_t exception) noexcept {
+            return cti::rethrow(std::move(exception));
+          });
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(std::move(continuation),
+                                get_test_exception_proto());
+}
 #endif
 
 TYPED_TEST(single_dimension_tests, are_result_error_accepting) {
@@ -33,3 +33,75 @@ TYPED_TEST(single_dimension_tests, is_logical_all_connectable) {
     EXPECT_ASYNC_RESULT(std::move(composed));
   }
 }
+
+TYPED_TEST(single_dimension_tests, is_all_connectable_contiguous) {
+  std::vector<decltype(this->supply(0))> continuables;
+  continuables.push_back(this->supply(0));
+  continuables.push_back(this->supply(1));
+  continuables.push_back(this->supply(2));
+
+  auto chain = cti::when_all(std::move(continuables));
+  EXPECT_ASYNC_RESULT(std::move(chain), std::vector<int>{0, 1, 2});
+}
+
+TYPED_TEST(single_dimension_tests, is_all_connectable_contiguous_empty) {
+  std::vector<decltype(this->supply(0))> continuables;
+
+  auto chain = cti::when_all(std::move(continuables));
+  EXPECT_ASYNC_RESULT(std::move(chain), std::vector<int>{});
+}
+
+TYPED_TEST(single_dimension_tests, is_all_connectable_contiguous_errors) {
+  std::vector<cti::continuable<int>> continuables;
+  continuables.push_back(this->supply(0));
+  continuables.push_back(
+      this->supply_exception(supply_test_exception(), identity<int>{}));
+  continuables.push_back(this->supply(2));
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(cti::when_all(std::move(continuables)),
+                                get_test_exception_proto());
+}
+
+TYPED_TEST(single_dimension_tests, is_all_connectable_into_storage) {
+  std::vector<cti::continuable<int>> continuables;
+  continuables.push_back(this->supply(0));
+  continuables.push_back(this->supply(1));
+  continuables.push_back(this->supply(2));
+
+  std::vector<int> results(3U);
+  ASSERT_ASYNC_COMPLETION(cti::when_all_into(std::move(continuables), results));
+  EXPECT_EQ(results, (std::vector<int>{0, 1, 2}));
+}
+
+TYPED_TEST(single_dimension_tests, is_all_connectable_into_storage_too_small) {
+  std::vector<cti::continuable<int>> continuables;
+  continuables.push_back(this->supply(0));
+  continuables.push_back(this->supply(1));
+  continuables.push_back(this->supply(2));
+
+  std::vector<int> results(2U);
+  ASSERT_ASYNC_EXCEPTION_COMPLETION(
+      cti::when_all_into(std::move(continuables), results));
+}
+
+TYPED_TEST(single_dimension_tests,
+           is_all_connectable_into_storage_deferring_errors) {
+  cti::promise<int> pending;
+  std::vector<cti::continuable<int>> continuables;
+  continuables.push_back(cti::make_continuable<int>([&](auto&& promise) {
+    pending = std::forward<decltype(promise)>(promise);
+  }));
+  continuables.push_back(
+      this->supply_exception(supply_test_exception(), identity<int>{}));
+
+  bool failed = false;
+  std::vector<int> results(2U);
+  cti::when_all_into(std::move(continuables), results)
+      .fail([&](cti::exception_t) { failed = true; });
+
+  // The storage is written by the pending continuable,
+  // therefore the error is forwarded after it was resolved.
+  EXPECT_FALSE(failed);
+  pending.set_value(1);
+  EXPECT_TRUE(failed);
+}
@@ -21,6 +21,7 @@
   SOFTWARE.
 **/
 
+#include <vector>
 #include <test-continuable.hpp>
 
 TYPED_TEST(single_dimension_tests, is_logical_seq_connectable_composed) {
@@ -35,3 +36,70 @@ TYPED_TEST(single_dimension_tests, is_logical_seq_connectable_chars) {
   auto chain = this->supply('a') >> this->supply('b') >> this->supply('c');
   EXPECT_ASYNC_RESULT(std::move(chain), 'a', 'b', 'c');
 }
+
+TYPED_TEST(single_dimension_tests, is_logical_seq_connectable_mixed) {
+  auto chain = (this->supply(1) >> this->supply(2)).then([](int a, int b) {
+    return a + b;
+  }) >> (this->supply(4) && this->supply(5)) >> this->supply();
+
+  EXPECT_ASYNC_RESULT(std::move(chain), 3, 4, 5);
+}
+
+TYPED_TEST(single_dimension_tests, is_logical_seq_aborted_on_error) {
+  bool started = false;
+  bool continued = false;
+  auto chain = this->supply().then([&] { started = true; }) >>
+               this->supply_exception(supply_test_exception()) >>
+               this->supply().then([&] { continued = true; });
+
+  ASSERT_ASYNC_EXCEPTION_COMPLETION(std::move(chain));
+  ASSERT_TRUE(started);
+  ASSERT_FALSE(continued);
+}
+
+TYPED_TEST(single_dimension_tests, is_logical_seq_resumed_later) {
+  cti::promise<int> pending;
+  bool resolved = false;
+
+  (this->supply(1) >> cti::make_continuable<int>([&](auto&& promise) {
+     pending = std::forward<decltype(promise)>(promise);
+   }) >> this->supply(3))
+      .then([&](int a, int b, int c) {
+        EXPECT_EQ(a, 1);
+        EXPECT_EQ(b, 2);
+        EXPECT_EQ(c, 3);
+        resolved = true;
+      });
+
+  ASSERT_FALSE(resolved);
+  pending.set_value(2);
+  ASSERT_TRUE(resolved);
+}
+
+TYPED_TEST(single_dimension_tests, is_logical_seq_discarded_in_order) {
+  std::vector<int> order;
+  cti::promise<> pending;
+
+  {
+    // The chain is invoked on destruction without being finalized
+    auto chain = this->supply().then([&] { order.push_back(1); }) >>
+                 cti::make_continuable<void>([&](auto&& promise) {
+                   order.push_back(2);
+                   pending = std::forward<decltype(promise)>(promise);
+                 }) >>
+                 this->supply().then([&] { order.push_back(3); });
+  }
+
+  ASSERT_EQ(order, (std::vector<int>{1, 2}));
+  pending.set_value();
+  ASSERT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TYPED_TEST(single_dimension_tests, is_logical_seq_connectable_long) {
+  // Sequences of this length keep their frame on the heap
+  auto chain = cti::when_seq(this->supply(0), this->supply(1), this->supply(2),
+                             this->supply(3), this->supply(4), this->supply(5),
+                             this->supply(6), this->supply(7), this->supply(8),
+                             this->supply(9));
+  EXPECT_ASYNC_RESULT(std::move(chain), 0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+}
@@ -0,0 +1,270 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <test-continuable.hpp>
+
+using namespace cti;
+
+static int const CANARY = 48213;
+
+namespace {
+/// Queues the chunks until they are drained explicitly
+struct chunk_queue {
+  std::deque<work> chunks;
+
+  auto executor() {
+    return [this](auto&& chunk) {
+      chunks.emplace_back(std::forward<decltype(chunk)>(chunk));
+    };
+  }
+
+  void drain() {
+    while (!chunks.empty()) {
+      work chunk = std::move(chunks.front());
+      chunks.pop_front();
+      std::move(chunk)();
+    }
+  }
+};
+} // namespace
+
+TYPED_TEST(single_dimension_tests, operations_parallel_for_visits_all) {
+  chunk_queue queue;
+  std::vector<int> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+
+  auto continuable = parallel_for(queue.executor(), values, 100,
+                                  [](int& value) { value *= 2; });
+
+  bool resolved = false;
+  std::move(continuable).then([&] { resolved = true; });
+
+  // The grain is the lower bound of the chunk size
+  ASSERT_FALSE(queue.chunks.empty());
+  ASSERT_LE(queue.chunks.size(), 10U);
+  ASSERT_FALSE(resolved);
+
+  queue.drain();
+  ASSERT_TRUE(resolved);
+
+  for (std::size_t i = 0; i != values.size(); ++i) {
+    ASSERT_EQ(values[i], static_cast<int>(i * 2));
+  }
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_for_empty_range) {
+  std::vector<int> values;
+  bool submitted = false;
+  auto executor = [&](auto&& chunk) {
+    submitted = true;
+    std::move(chunk)();
+  };
+
+  ASSERT_ASYNC_COMPLETION(parallel_for(executor, values, 1, [](int&) {
+    FAIL(); //
+  }));
+  ASSERT_FALSE(submitted);
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_for_array) {
+  int values[] = {1, 2, 3, 4, 5};
+  auto executor = [](auto&& chunk) {
+    std::move(chunk)(); //
+  };
+
+  ASSERT_ASYNC_COMPLETION(
+      parallel_for(executor, values, 1, [](int& value) { value = -value; }));
+
+  ASSERT_EQ(values[0], -1);
+  ASSERT_EQ(values[4], -5);
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_transform) {
+  chunk_queue queue;
+  std::vector<int> input(777);
+  std::iota(input.begin(), input.end(), 0);
+  std::vector<long> output(input.size());
+
+  bool resolved = false;
+  parallel_transform(queue.executor(), input, output, 50,
+                     [](int value) { return static_cast<long>(value) * 3; })
+      .then([&] { resolved = true; });
+
+  ASSERT_FALSE(resolved);
+  queue.drain();
+  ASSERT_TRUE(resolved);
+
+  for (std::size_t i = 0; i != input.size(); ++i) {
+    ASSERT_EQ(output[i], static_cast<long>(i) * 3);
+  }
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_for_executor_error) {
+  std::vector<int> values(100);
+  auto executor = [](auto&& chunk) {
+    std::move(chunk)(exception_arg_t{}, supply_test_exception());
+  };
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(
+      parallel_for(executor, values, 10, [](int&) {
+        FAIL(); //
+      }),
+      get_test_exception_proto());
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_for_dropped_chunk) {
+  chunk_queue queue;
+  std::vector<int> values(100);
+
+  bool canceled = false;
+  parallel_for(queue.executor(), values, 10, [](int&) {})
+      .fail([&](exception_t exception) {
+        ASSERT_FALSE(bool(exception));
+        canceled = true;
+      });
+
+  ASSERT_GE(queue.chunks.size(), 2U);
+  queue.chunks.pop_back();
+  queue.drain();
+  ASSERT_TRUE(canceled);
+}
+
+#if !defined(CONTINUABLE_WITH_NO_EXCEPTIONS)
+TYPED_TEST(single_dimension_tests, operations_parallel_for_exception) {
+  chunk_queue queue;
+  std::vector<int> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+
+  bool failed = false;
+  parallel_for(queue.executor(), values, 100,
+               [](int& value) {
+                 if (value == 0) {
+                   throw test_exception{};
+                 }
+                 value = -1;
+               })
+      .fail([&](exception_t) { failed = true; });
+
+  queue.drain();
+  ASSERT_TRUE(failed);
+
+  // The chunks after the failed one are skipped
+  ASSERT_EQ(values.back(), 999);
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_for_throwing_executor) {
+  chunk_queue queue;
+  std::vector<int> values(100);
+
+  // The executor throws after it accepted two chunks
+  auto executor = [&](auto&& chunk) {
+    if (queue.chunks.size() == 2U) {
+      throw test_exception{};
+    }
+    queue.chunks.emplace_back(std::forward<decltype(chunk)>(chunk));
+  };
+
+  bool failed = false;
+  parallel_for(executor, values, 10, [](int&) {})
+      .fail([&](exception_t exception) {
+        ASSERT_TRUE(bool(exception));
+        failed = true;
+      });
+
+  ASSERT_EQ(queue.chunks.size(), 2U);
+  ASSERT_FALSE(failed);
+  queue.drain();
+  ASSERT_TRUE(failed);
+}
+#endif // !defined(CONTINUABLE_WITH_NO_EXCEPTIONS)
+
+TYPED_TEST(single_dimension_tests, operations_parallel_reduce_sum) {
+  chunk_queue queue;
+  std::vector<int> values(10000);
+  std::iota(values.begin(), values.end(), 1);
+
+  long long sum = 0;
+  parallel_reduce(queue.executor(), values, 0LL, std::plus<>{}, 100)
+      .then([&](long long result) { sum = result; });
+
+  queue.drain();
+  ASSERT_EQ(sum, 10000LL * 10001LL / 2LL);
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_reduce_ordered) {
+  chunk_queue queue;
+  std::string const alphabet = "abcdefghijklmnopqrstuvwxyz";
+  std::vector<std::string> letters;
+  for (char letter : alphabet) {
+    letters.emplace_back(1U, letter);
+  }
+
+  std::string result;
+  parallel_reduce(queue.executor(), letters, std::string(">"),
+                  [](std::string left, std::string const& right) {
+                    return std::move(left) += right;
+                  },
+                  2)
+      .then([&](std::string reduced) { result = std::move(reduced); });
+
+  // Complete the chunks in reverse order, the operation isn't commutative
+  ASSERT_GE(queue.chunks.size(), 2U);
+  while (!queue.chunks.empty()) {
+    work chunk = std::move(queue.chunks.back());
+    queue.chunks.pop_back();
+    std::move(chunk)();
+  }
+
+  ASSERT_EQ(result, ">" + alphabet);
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_reduce_empty_range) {
+  std::vector<int> values;
+  auto executor = [](auto&& chunk) {
+    std::move(chunk)(); //
+  };
+
+  ASSERT_ASYNC_RESULT(parallel_reduce(executor, values, CANARY,
+                                      [](int, int) -> int {
+                                        ADD_FAILURE();
+                                        return 0;
+                                      },
+                                      1),
+                      CANARY);
+}
+
+TYPED_TEST(single_dimension_tests, operations_parallel_reduce_executor_error) {
+  std::vector<int> values(100, 1);
+  auto executor = [](auto&& chunk) {
+    std::move(chunk)(exception_arg_t{}, supply_test_exception());
+  };
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(
+      parallel_reduce(executor, values, 0, std::plus<>{}, 10),
+      get_test_exception_proto());
+}
@@ -0,0 +1,199 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <test-continuable.hpp>
+
+using namespace cti;
+
+namespace {
+/// A manually advanced clock to test the expiration of entries
+struct manual_clock {
+  using duration = std::chrono::milliseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<manual_clock>;
+  static constexpr bool is_steady = true;
+
+  static time_point current;
+
+  static time_point now() noexcept {
+    return current;
+  }
+};
+
+manual_clock::time_point manual_clock::current;
+
+struct unit_weigher {
+  template <typename Key, typename Value>
+  std::size_t operator()(Key const&, Value const&) const noexcept {
+    return 1;
+  }
+};
+
+/// Weighs an entry by its value
+struct value_weigher {
+  template <typename Key>
+  std::size_t operator()(Key const&, int value) const noexcept {
+    return static_cast<std::size_t>(value);
+  }
+};
+
+template <typename Clock = std::chrono::steady_clock>
+using int_cache = async_cache<int, int, std::hash<int>, std::equal_to<int>,
+                              unit_weigher, Clock, 1>;
+} // namespace
+
+TEST(async_cache_tests, hits_are_served_from_the_cache) {
+  int_cache<> cache(16);
+
+  int calls = 0;
+  auto loader = [&] {
+    ++calls;
+    return make_ready_continuable(36354);
+  };
+
+  EXPECT_ASYNC_RESULT(cache.get(0, loader), 36354);
+  EXPECT_ASYNC_RESULT(cache.get(0, loader), 36354);
+  EXPECT_EQ(calls, 1);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.size, 1U);
+}
+
+TEST(async_cache_tests, lookups_are_deferred_until_started) {
+  int_cache<> cache(16);
+  cache.insert(0, 36354);
+
+  auto c = cache.get(0, [] { return make_ready_continuable(0); });
+  EXPECT_EQ(cache.stats().hits, 0U);
+
+  auto dropped = cache.get(1, [] { return make_ready_continuable(0); });
+  dropped.freeze();
+
+  EXPECT_ASYNC_RESULT(std::move(c), 36354);
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.misses, 0U);
+}
+
+TEST(async_cache_tests, concurrent_misses_are_coalesced) {
+  int_cache<> cache(16);
+  std::vector<promise<int>> requests;
+
+  auto loader = [&] {
+    return make_continuable<int>([&](auto&& promise) {
+      requests.emplace_back(std::forward<decltype(promise)>(promise));
+    });
+  };
+
+  int resolved = 0;
+  cache.get(0, loader).then([&](int value) { resolved += value; });
+  cache.get(0, loader).then([&](int value) { resolved += value; });
+
+  ASSERT_EQ(requests.size(), 1U);
+  std::move(requests.front()).set_value(1);
+  EXPECT_EQ(resolved, 2);
+  EXPECT_EQ(cache.stats().size, 1U);
+}
+
+TEST(async_cache_tests, least_recently_used_entries_are_evicted) {
+  int_cache<> cache(2);
+  cache.insert(0, 0);
+  cache.insert(1, 1);
+
+  // Touch the entry 0 such that 1 becomes the least recently used one
+  ASSERT_ASYNC_COMPLETION(cache.get(0, [] { return make_ready_continuable(0); }));
+  cache.insert(2, 2);
+
+  int calls = 0;
+  auto loader = [&] {
+    ++calls;
+    return make_ready_continuable(-1);
+  };
+
+  EXPECT_ASYNC_RESULT(cache.get(0, loader), 0);
+  EXPECT_ASYNC_RESULT(cache.get(2, loader), 2);
+  EXPECT_ASYNC_RESULT(cache.get(1, loader), -1);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(cache.stats().evictions, 2U);
+}
+
+TEST(async_cache_tests, entries_expire_after_their_ttl) {
+  int_cache<manual_clock> cache(16, std::chrono::milliseconds(100));
+  cache.insert(0, 1);
+
+  auto loader = [] { return make_ready_continuable(2); };
+
+  manual_clock::current += std::chrono::milliseconds(99);
+  EXPECT_ASYNC_RESULT(cache.get(0, loader), 1);
+
+  manual_clock::current += std::chrono::milliseconds(1);
+  EXPECT_ASYNC_RESULT(cache.get(0, loader), 2);
+}
+
+TEST(async_cache_tests, exceptions_are_not_cached) {
+  int_cache<> cache(16);
+
+  ASSERT_ASYNC_EXCEPTION_COMPLETION(cache.get(0, [] {
+    return make_exceptional_continuable<int>(supply_test_exception());
+  }));
+  EXPECT_EQ(cache.stats().size, 0U);
+  EXPECT_ASYNC_RESULT(cache.get(0, [] { return make_ready_continuable(1); }),
+                      1);
+}
+
+TEST(async_cache_tests, entries_respect_the_memory_budget) {
+  std::size_t const budget = 32 * (sizeof(int) + sizeof(std::string));
+  async_cache<int, std::string> cache(budget);
+  for (int i = 0; i < 256; ++i) {
+    cache.insert(i, std::to_string(i));
+  }
+
+  auto stats = cache.stats();
+  EXPECT_GT(stats.size, 0U);
+  EXPECT_LE(stats.weight, budget);
+  EXPECT_EQ(stats.size + stats.evictions, 256U);
+}
+
+TEST(async_cache_tests, entries_heavier_than_a_shard_are_rejected) {
+  // Every one of the 16 shards accepts a sixteenth of the budget
+  async_cache<int, int, std::hash<int>, std::equal_to<int>, value_weigher>
+      cache(64);
+  ASSERT_EQ(decltype(cache)::shard_count(), 16U);
+  ASSERT_EQ(cache.shard_budget(), 4U);
+
+  cache.insert(0, 4);
+  cache.insert(1, 5);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.size, 1U);
+  EXPECT_EQ(stats.weight, 4U);
+  EXPECT_EQ(stats.rejections, 1U);
+}
@@ -0,0 +1,321 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <test-continuable.hpp>
+#include <continuable/operations/blocking.hpp>
+#include <continuable/operations/shard.hpp>
+
+using namespace cti;
+
+namespace {
+/// Blocks the current thread until the continuable resolved
+template <typename... T, typename Continuable>
+result<T...> wait_for_result(Continuable&& continuable) {
+  std::mutex lock;
+  std::condition_variable condition;
+  bool ready = false;
+  result<T...> captured;
+
+  std::forward<Continuable>(continuable).next([&](auto&&... args) {
+    std::lock_guard<std::mutex> guard(lock);
+    captured = make_result(std::forward<decltype(args)>(args)...);
+    ready = true;
+    condition.notify_one();
+  });
+
+  std::unique_lock<std::mutex> guard(lock);
+  condition.wait(guard, [&] { return ready; });
+  return captured;
+}
+
+/// Blocks every thread which waits on it until it is opened
+class gate {
+public:
+  void open() {
+    std::lock_guard<std::mutex> guard(lock_);
+    opened_ = true;
+    condition_.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> guard(lock_);
+    condition_.wait(guard, [&] { return opened_; });
+  }
+
+private:
+  std::mutex lock_;
+  std::condition_variable condition_;
+  bool opened_ = false;
+};
+
+/// Waits until the predicate over the metrics of the pool is satisfied
+template <typename Predicate>
+bool wait_for_metrics(blocking_pool const& pool, Predicate&& predicate) {
+  auto const until = std::chrono::steady_clock::now() +
+                     std::chrono::seconds(10);
+  while (!predicate(pool.metrics())) {
+    if (std::chrono::steady_clock::now() > until) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+/// An executor which collects the work until it is drained
+class work_queue {
+public:
+  auto executor() {
+    return [this](work item) {
+      std::lock_guard<std::mutex> guard(lock_);
+      queue_.push_back(std::move(item));
+    };
+  }
+
+  std::size_t drain() {
+    std::deque<work> queue;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      queue.swap(queue_);
+    }
+    for (auto& item : queue) {
+      std::move(item)();
+    }
+    return queue.size();
+  }
+
+private:
+  std::mutex lock_;
+  std::deque<work> queue_;
+};
+} // namespace
+
+TEST(blocking_tests, runs_on_a_thread_of_the_pool) {
+  blocking_pool pool(2);
+
+  auto const caller = std::this_thread::get_id();
+  auto current = wait_for_result<bool>(
+      pool.run([caller] { return std::this_thread::get_id() != caller; }));
+  ASSERT_TRUE(current.is_value());
+  ASSERT_TRUE(current.get_value());
+}
+
+TEST(blocking_tests, grows_up_to_the_maximal_count_of_threads) {
+  blocking_pool pool(3);
+  gate blocker;
+  std::atomic<std::size_t> finished(0);
+
+  for (std::size_t i = 0; i != 5; ++i) {
+    pool.run([&] { blocker.wait(); }).then([&] { ++finished; });
+  }
+
+  ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+    return m.started == 3U;
+  }));
+
+  auto metrics = pool.metrics();
+  ASSERT_EQ(metrics.threads, 3U);
+  ASSERT_EQ(metrics.peak_threads, 3U);
+  ASSERT_EQ(metrics.pending, 2U);
+
+  blocker.open();
+  ASSERT_TRUE(wait_for_metrics(pool, [&](blocking_pool_metrics const& m) {
+    return m.started == 5U && finished.load() == 5U;
+  }));
+  ASSERT_EQ(pool.metrics().peak_threads, 3U);
+}
+
+TEST(blocking_tests, reuses_idle_threads) {
+  blocking_pool pool(8);
+
+  for (std::size_t i = 0; i != 10; ++i) {
+    ASSERT_TRUE(wait_for_result<>(pool.run([] {})).is_value());
+    ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+      return m.idle_threads == m.threads;
+    }));
+  }
+  ASSERT_EQ(pool.metrics().peak_threads, 1U);
+}
+
+TEST(blocking_tests, shrinks_when_idle) {
+  blocking_pool pool(4, std::chrono::milliseconds(10));
+  gate blocker;
+
+  for (std::size_t i = 0; i != 4; ++i) {
+    pool.run([&] { blocker.wait(); });
+  }
+  ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+    return m.threads == 4U;
+  }));
+
+  blocker.open();
+  ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+    return m.threads == 0U;
+  }));
+
+  // The pool starts new threads after it shrank
+  ASSERT_TRUE(wait_for_result<>(pool.run([] {})).is_value());
+  ASSERT_EQ(pool.metrics().peak_threads, 4U);
+}
+
+TEST(blocking_tests, measures_the_wait_time) {
+  blocking_pool pool(1);
+  gate blocker;
+
+  pool.run([&] { blocker.wait(); });
+  pool.run([] {});
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  blocker.open();
+  ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+    return m.started == 2U;
+  }));
+
+  auto metrics = pool.metrics();
+  ASSERT_GE(metrics.max_wait, std::chrono::milliseconds(10));
+  ASSERT_GE(metrics.total_wait, metrics.max_wait);
+}
+
+TEST(blocking_tests, resumes_on_the_given_executor) {
+  blocking_pool pool(1);
+  work_queue resume;
+  std::atomic<bool> resolved(false);
+
+  pool.run([] { return 7; }, resume.executor()).then([&](int value) {
+    EXPECT_EQ(value, 7);
+    resolved = true;
+  });
+
+  ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+    return m.started == 1U;
+  }));
+  while (resume.drain() == 0U) {
+    std::this_thread::yield();
+  }
+  ASSERT_TRUE(resolved.load());
+}
+
+TEST(blocking_tests, resumes_on_the_calling_core) {
+  blocking_pool pool(2);
+  shard::runtime shards(2);
+
+  auto cores = wait_for_result<std::size_t, std::size_t>(
+      shards.submit_to(1, [&] {
+        return pool.run([] { return shard::current_core(); })
+            .then([](std::size_t blocking) {
+              return std::make_tuple(blocking, shard::current_core());
+            });
+      }));
+
+  ASSERT_TRUE(cores.is_value());
+  ASSERT_EQ(std::get<0>(cores.get_value()), shard::npos);
+  ASSERT_EQ(std::get<1>(cores.get_value()), 1U);
+}
+
+TEST(blocking_tests, forwards_exceptions) {
+  blocking_pool pool(1);
+
+  auto current = wait_for_result<int>(pool.run([]() -> result<int> {
+    return make_result(exception_arg_t{}, supply_test_exception());
+  }));
+  ASSERT_TRUE(current.is_exception());
+  ASSERT_TRUE(bool(current.get_exception()));
+}
+
+TEST(blocking_tests, cancels_pending_work_on_destruction) {
+  gate blocker;
+  result<> first;
+  result<> second;
+  std::thread opener;
+
+  {
+    blocking_pool pool(1);
+    pool.run([&] { blocker.wait(); }).next([&](auto&&... args) {
+      first = make_result(std::forward<decltype(args)>(args)...);
+    });
+    pool.run([] {}).next([&](auto&&... args) {
+      second = make_result(std::forward<decltype(args)>(args)...);
+    });
+
+    ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+      return m.started == 1U;
+    }));
+
+    // Unblock the running work while the pool is destroyed
+    opener = std::thread([&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      blocker.open();
+    });
+  }
+  opener.join();
+
+  ASSERT_TRUE(first.is_value());
+  ASSERT_TRUE(second.is_exception());
+  ASSERT_FALSE(bool(second.get_exception()));
+}
+
+TEST(blocking_tests, cancels_work_posted_on_destruction) {
+  gate blocker;
+  result<> posted;
+  std::thread opener;
+
+  {
+    blocking_pool pool(2);
+    pool.run([&] {
+      blocker.wait();
+      // The pool is stopped already, so this work is never run
+      pool.run([] {}).next([&](auto&&... args) {
+        posted = make_result(std::forward<decltype(args)>(args)...);
+      });
+    });
+
+    ASSERT_TRUE(wait_for_metrics(pool, [](blocking_pool_metrics const& m) {
+      return m.started == 1U;
+    }));
+
+    opener = std::thread([&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      blocker.open();
+    });
+  }
+  opener.join();
+
+  ASSERT_TRUE(posted.is_exception());
+  ASSERT_FALSE(bool(posted.get_exception()));
+}
+
+TEST(blocking_tests, default_pool) {
+  auto current = wait_for_result<int>(blocking([] { return 42; }));
+  ASSERT_TRUE(current.is_value());
+  ASSERT_EQ(current.get_value(), 42);
+}
@@ -0,0 +1,273 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <test-continuable.hpp>
+
+using namespace cti;
+using namespace std::chrono_literals;
+
+namespace {
+/// A local stand-in for a backend whose requests are resolved by the test
+struct manual_backend {
+  std::deque<promise<int>> requests;
+
+  continuable<int> request() {
+    return make_continuable<int>([this](auto&& promise) {
+      requests.emplace_back(std::forward<decltype(promise)>(promise));
+    });
+  }
+};
+
+/// A timer whose delays are elapsed by the test
+struct manual_timer {
+  std::deque<promise<>>* timers;
+
+  auto operator()(std::chrono::nanoseconds) const {
+    return make_continuable<void>([timers = timers](auto&& promise) {
+      timers->emplace_back(std::forward<decltype(promise)>(promise));
+    });
+  }
+};
+
+/// Records the outcome of a hedged operation
+struct outcome {
+  bool resolved = false;
+  result<int> value;
+
+  auto callback() {
+    return [this](auto&&... args) {
+      resolved = true;
+      value = make_result(std::forward<decltype(args)>(args)...);
+    };
+  }
+};
+} // namespace
+
+TEST(hedge_tests, fast_attempts_are_not_hedged) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+  outcome result;
+
+  hedge(10ms, manual_timer{&timers}, [&] { return backend.request(); })
+      .next(result.callback());
+
+  ASSERT_EQ(backend.requests.size(), 1U);
+  ASSERT_EQ(timers.size(), 1U);
+
+  backend.requests[0].set_value(1);
+  ASSERT_TRUE(result.resolved);
+  ASSERT_TRUE(result.value.is_value());
+  EXPECT_EQ(result.value.get_value(), 1);
+
+  // The elapsed delay doesn't start a backup attempt anymore
+  timers[0].set_value();
+  EXPECT_EQ(backend.requests.size(), 1U);
+}
+
+TEST(hedge_tests, slow_attempts_are_hedged) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+  outcome result;
+
+  hedge(10ms, manual_timer{&timers}, [&] { return backend.request(); })
+      .next(result.callback());
+
+  timers[0].set_value();
+  ASSERT_EQ(backend.requests.size(), 2U);
+  EXPECT_EQ(timers.size(), 1U);
+
+  backend.requests[1].set_value(2);
+  ASSERT_TRUE(result.resolved);
+  EXPECT_EQ(result.value.get_value(), 2);
+
+  // The result of the abandoned attempt is dropped
+  backend.requests[0].set_value(1);
+  EXPECT_EQ(result.value.get_value(), 2);
+}
+
+TEST(hedge_tests, attempts_are_limited) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+  outcome result;
+
+  hedge(10ms, manual_timer{&timers}, [&] { return backend.request(); }, 3)
+      .next(result.callback());
+
+  timers[0].set_value();
+  ASSERT_EQ(timers.size(), 2U);
+  timers[1].set_value();
+  EXPECT_EQ(backend.requests.size(), 3U);
+  EXPECT_EQ(timers.size(), 2U);
+
+  backend.requests[0].set_value(1);
+  ASSERT_TRUE(result.resolved);
+  EXPECT_EQ(result.value.get_value(), 1);
+}
+
+TEST(hedge_tests, failed_attempts_are_hedged_immediately) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+  outcome result;
+
+  hedge(10ms, manual_timer{&timers}, [&] { return backend.request(); })
+      .next(result.callback());
+
+  backend.requests[0].set_exception(supply_test_exception());
+  ASSERT_EQ(backend.requests.size(), 2U);
+  EXPECT_FALSE(result.resolved);
+
+  backend.requests[1].set_value(2);
+  ASSERT_TRUE(result.resolved);
+  EXPECT_EQ(result.value.get_value(), 2);
+
+  // The pending timer doesn't start a third attempt
+  timers[0].set_value();
+  EXPECT_EQ(backend.requests.size(), 2U);
+}
+
+TEST(hedge_tests, the_last_error_is_propagated) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+  outcome result;
+
+  hedge(10ms, manual_timer{&timers}, [&] { return backend.request(); })
+      .next(result.callback());
+
+  timers[0].set_value();
+  backend.requests[1].set_exception(supply_test_exception());
+  EXPECT_FALSE(result.resolved);
+
+  backend.requests[0].set_exception(supply_test_exception());
+  ASSERT_TRUE(result.resolved);
+  ASSERT_TRUE(result.value.is_exception());
+  EXPECT_TRUE(bool(result.value.get_exception()));
+}
+
+TEST(hedge_tests, cancellations_wait_for_the_delay) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+  outcome result;
+
+  hedge(10ms, manual_timer{&timers}, [&] { return backend.request(); })
+      .next(result.callback());
+
+  backend.requests[0].set_canceled();
+  EXPECT_EQ(backend.requests.size(), 1U);
+  EXPECT_FALSE(result.resolved);
+
+  timers[0].set_value();
+  ASSERT_EQ(backend.requests.size(), 2U);
+  backend.requests[1].set_canceled();
+
+  ASSERT_TRUE(result.resolved);
+  ASSERT_TRUE(result.value.is_exception());
+  EXPECT_FALSE(bool(result.value.get_exception()));
+}
+
+TEST(hedge_tests, timer_cancellations_stop_hedging) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+  outcome result;
+
+  hedge(10ms, manual_timer{&timers}, [&] { return backend.request(); })
+      .next(result.callback());
+
+  timers[0].set_canceled();
+  backend.requests[0].set_exception(supply_test_exception());
+
+  EXPECT_EQ(backend.requests.size(), 1U);
+  ASSERT_TRUE(result.resolved);
+  ASSERT_TRUE(result.value.is_exception());
+  EXPECT_TRUE(bool(result.value.get_exception()));
+}
+
+TEST(hedge_tests, single_attempts_arm_no_timer) {
+  manual_backend backend;
+  std::deque<promise<>> timers;
+
+  ASSERT_ASYNC_INCOMPLETION(hedge(10ms, manual_timer{&timers},
+                                  [&] { return backend.request(); }, 1));
+  EXPECT_EQ(backend.requests.size(), 1U);
+  EXPECT_TRUE(timers.empty());
+}
+
+#if !defined(CONTINUABLE_WITH_NO_EXCEPTIONS)
+TEST(hedge_tests, throwing_factories_are_hedged) {
+  int requests = 0;
+  std::deque<promise<>> timers;
+
+  EXPECT_ASYNC_RESULT(hedge(10ms, manual_timer{&timers},
+                            [&]() -> continuable<int> {
+                              if (++requests == 1) {
+                                throw test_exception{};
+                              }
+                              return make_ready_continuable(requests);
+                            }),
+                      2);
+}
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
+TEST(hedge_tests, delays_are_waited_for_on_the_timer_queue) {
+  manual_backend backend;
+  std::atomic<int> requests(0);
+  std::promise<int> result;
+
+  // The first request never completes, the backup is started
+  // on the timer thread.
+  hedge(1ms,
+        [&]() -> continuable<int> {
+          if (++requests == 1) {
+            return backend.request();
+          }
+          return make_ready_continuable(2);
+        })
+      .then([&](int value) { result.set_value(value); });
+
+  EXPECT_EQ(result.get_future().get(), 2);
+  EXPECT_EQ(requests.load(), 2);
+}
+
+TEST(hedge_tests, attempts_are_limited_on_the_timer_queue) {
+  std::atomic<int> requests(0);
+  std::promise<int> result;
+
+  // Only the last attempt completes
+  hedge(
+      1ms,
+      [&]() -> continuable<int> {
+        if (++requests < 3) {
+          return make_continuable<int>([](auto&&) {});
+        }
+        return make_ready_continuable(3);
+      },
+      3)
+      .then([&](int value) { result.set_value(value); });
+
+  EXPECT_EQ(result.get_future().get(), 3);
+  EXPECT_EQ(requests.load(), 3);
+}
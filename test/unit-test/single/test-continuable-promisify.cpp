@@ -21,6 +21,12 @@
   SOFTWARE.
 **/
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include <test-continuable.hpp>
 
 template <typename T, typename Callback>
@@ -66,3 +72,208 @@ TEST(promisify_tests, promisify_with) {
   value = 36354;
   ASSERT_ASYNC_EXCEPTION_COMPLETION(std::move(c));
 }
+
+TEST(promisify_tests, promisify_from_error_value) {
+  auto c = cti::promisify<std::error_code, int>::from_error_value(
+      [&](auto&& callback) {
+        std::forward<decltype(callback)>(callback)(
+            std::make_error_code(std::errc::connection_reset), 36354);
+      });
+
+  bool resolved = false;
+  std::move(c).then([&](std::error_code ec, int value) {
+    EXPECT_EQ(ec, std::errc::connection_reset);
+    EXPECT_EQ(value, 36354);
+    resolved = true;
+  });
+  ASSERT_TRUE(resolved);
+}
+
+namespace {
+/// A stand-in for a C library which calls its callbacks asynchronously
+struct c_library_request {
+  void (*callback)(void*, int, int);
+  void* user_data;
+  int value;
+};
+
+std::vector<c_library_request>& c_library_queue() {
+  static std::vector<c_library_request> queue;
+  return queue;
+}
+
+void c_library_double_async(int value, void (*callback)(void*, int, int),
+                            void* user_data) {
+  c_library_queue().push_back({callback, user_data, value});
+}
+
+void c_library_run() {
+  std::vector<c_library_request> queue;
+  queue.swap(c_library_queue());
+  for (c_library_request const& request : queue) {
+    int const error = request.value < 0 ? -1 : 0;
+    request.callback(request.user_data, error, request.value * 2);
+  }
+}
+
+template <typename Promisify>
+auto c_library_double(Promisify& promisify, int value) {
+  return promisify.from(
+      [value](void (*callback)(void*, int, int), void* user_data) {
+        c_library_double_async(value, callback, user_data);
+      });
+}
+} // namespace
+
+TEST(promisify_tests, promisify_c_from) {
+  cti::promisify_c<int, int> promisify;
+
+  bool resolved = false;
+  c_library_double(promisify, 21).then([&](int error, int value) {
+    EXPECT_EQ(error, 0);
+    EXPECT_EQ(value, 42);
+    resolved = true;
+  });
+
+  ASSERT_FALSE(resolved);
+  c_library_run();
+  ASSERT_TRUE(resolved);
+}
+
+TEST(promisify_tests, promisify_c_with) {
+  cti::promisify_c<int, int> promisify;
+
+  auto resolver = [](auto&& promise, int error, int value) {
+    if (error) {
+      promise.set_exception(supply_test_exception());
+    } else {
+      promise.set_value(value);
+    }
+  };
+  auto callable = [](int value, void (*callback)(void*, int, int),
+                     void* user_data) {
+    c_library_double_async(value, callback, user_data);
+  };
+
+  int result = 0;
+  promisify.with<int>(resolver, callable, 21).then([&](int value) {
+    result = value;
+  });
+
+  bool failed = false;
+  promisify.with<int>(resolver, callable, -1)
+      .then([](int) { FAIL(); })
+      .fail([&](cti::exception_t) { failed = true; });
+
+  c_library_run();
+  ASSERT_EQ(result, 42);
+  ASSERT_TRUE(failed);
+}
+
+TEST(promisify_tests, promisify_c_reuses_slots) {
+  cti::promisify_c<int, int> promisify(2);
+  ASSERT_EQ(promisify.available(), 2U);
+
+  std::vector<void*> user_data;
+  for (int round = 0; round != 3; ++round) {
+    int sum = 0;
+    for (int i = 0; i != 2; ++i) {
+      c_library_double(promisify, i).then([&](int, int value) {
+        sum += value;
+      });
+    }
+    ASSERT_EQ(promisify.available(), 0U);
+
+    if (round == 0) {
+      for (c_library_request const& request : c_library_queue()) {
+        user_data.push_back(request.user_data);
+      }
+    } else {
+      for (std::size_t i = 0; i != user_data.size(); ++i) {
+        EXPECT_NE(std::find(user_data.begin(), user_data.end(),
+                            c_library_queue()[i].user_data),
+                  user_data.end());
+      }
+    }
+
+    c_library_run();
+    ASSERT_EQ(sum, 2);
+    ASSERT_EQ(promisify.available(), 2U);
+  }
+}
+
+TEST(promisify_tests, promisify_c_releases_outstanding_promises) {
+  auto value = std::make_shared<int>(0);
+  std::weak_ptr<int> observer = value;
+
+  {
+    cti::promisify_c<int, int> promisify;
+    c_library_double(promisify, 1).then([value = std::move(value)](int, int) {
+      // Is never called
+      FAIL();
+    });
+    ASSERT_FALSE(observer.expired());
+
+    c_library_queue().clear();
+  }
+
+  ASSERT_TRUE(observer.expired());
+}
+
+#if !defined(CONTINUABLE_WITH_NO_EXCEPTIONS)
+TEST(promisify_tests, promisify_c_rejects_throwing_calls) {
+  cti::promisify_c<int, int> promisify(1);
+
+  auto callable = [](void (*)(void*, int, int), void*) {
+    throw test_exception{};
+  };
+
+  bool failed = false;
+  promisify.from(callable)
+      .then([](int, int) { FAIL(); })
+      .fail([&](cti::exception_t) { failed = true; });
+  ASSERT_TRUE(failed);
+  ASSERT_EQ(promisify.available(), 1U);
+
+  failed = false;
+  promisify
+      .with<int>(
+          [](auto&& promise, int, int value) { promise.set_value(value); },
+          callable)
+      .then([](int) { FAIL(); })
+      .fail([&](cti::exception_t) { failed = true; });
+  ASSERT_TRUE(failed);
+  ASSERT_EQ(promisify.available(), 1U);
+}
+
+TEST(promisify_tests, promisify_c_resolves_once_when_throwing_after_callback) {
+  cti::promisify_c<int, int> promisify(1);
+  constexpr int rounds = 1000;
+
+  // Slots which are released by the callback are acquired by the calls of
+  // the other thread, while the throwing call still inspects its slot.
+  auto run = [&](std::atomic<int>& resolutions) {
+    for (int round = 0; round != rounds; ++round) {
+      promisify
+          .from([](void (*callback)(void*, int, int), void* user_data) {
+            callback(user_data, 0, 1);
+            throw test_exception{};
+          })
+          .then([&](int, int) { ++resolutions; })
+          .fail([](cti::exception_t) {
+            // The exception of another call is never delivered here
+            FAIL();
+          });
+    }
+  };
+
+  std::atomic<int> first(0);
+  std::atomic<int> second(0);
+  std::thread other([&] { run(second); });
+  run(first);
+  other.join();
+
+  EXPECT_EQ(first.load(), rounds);
+  EXPECT_EQ(second.load(), rounds);
+}
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
@@ -23,6 +23,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-result.hpp>
 #include <continuable/detail/core/types.hpp>
@@ -259,3 +260,62 @@ TEST(result_single_test, test_leak_regression) {
 
   ASSERT_TRUE(destroyed);
 }
+
+TEST(result_single_test, void_result_keeps_its_state_when_moved) {
+#if defined(CONTINUABLE_DETAIL_HAS_EXCEPTION_NICHE)
+  static_assert(sizeof(result<>) == sizeof(exception_t),
+                "result<> is expected to be as large as its exception!");
+#endif
+
+  result<> empty;
+  result<> moved_empty(std::move(empty));
+  EXPECT_TRUE(moved_empty.is_empty());
+
+  result<> value = make_result();
+  result<> moved_value(std::move(value));
+  EXPECT_TRUE(moved_value.is_value());
+  EXPECT_TRUE(value.is_empty());
+
+  result<> canceled = cti::cancellation_result{};
+  result<> moved_canceled(std::move(canceled));
+  EXPECT_TRUE(moved_canceled.is_exception());
+  EXPECT_FALSE(bool(moved_canceled.get_exception()));
+
+  result<> exceptional(supply_test_exception());
+  moved_value = std::move(exceptional);
+  ASSERT_TRUE(moved_value.is_exception());
+  EXPECT_TRUE(bool(moved_value.get_exception()));
+  EXPECT_TRUE(exceptional.is_empty());
+
+  moved_value.set_value();
+  EXPECT_TRUE(moved_value.is_value());
+}
+
+TEST(result_single_test, relocated_results_are_destroyed_once) {
+  bool destroyed = false;
+  {
+    std::shared_ptr<int> ptr(new int(CANARY), [&](int* val) {
+      destroyed = true;
+      delete val;
+    });
+
+    std::vector<result<int, std::shared_ptr<int>>> results;
+    results.emplace_back(make_result(CANARY, std::move(ptr)));
+    for (int i = 0; i < 32; ++i) {
+      // Forces the relocation of the stored results
+      results.emplace_back(make_result(i, std::shared_ptr<int>{}));
+    }
+
+    result<int> trivial = make_result(CANARY);
+    result<int> relocated(std::move(trivial));
+    ASSERT_TRUE(relocated.is_value());
+    EXPECT_EQ(relocated.get_value(), CANARY);
+    EXPECT_TRUE(trivial.is_empty());
+
+    ASSERT_TRUE(results.front().is_value());
+    EXPECT_EQ(*cti::get<1>(results.front()), CANARY);
+    EXPECT_FALSE(destroyed);
+  }
+
+  EXPECT_TRUE(destroyed);
+}
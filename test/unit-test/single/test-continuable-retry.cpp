@@ -0,0 +1,154 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <vector>
+#include <test-continuable.hpp>
+
+using namespace cti;
+using namespace std::chrono_literals;
+
+namespace {
+/// A local stand-in for a service which fails a given count of requests
+struct flaky_service {
+  int failures;
+  int requests = 0;
+
+  continuable<int> request() {
+    ++requests;
+    if (requests <= failures) {
+      return make_exceptional_continuable<int>(supply_test_exception());
+    }
+    return make_ready_continuable(requests);
+  }
+};
+
+/// A timer which records all delays and elapses immediately
+struct recording_timer {
+  std::vector<std::chrono::nanoseconds>* delays;
+
+  auto operator()(std::chrono::nanoseconds delay) const {
+    delays->push_back(delay);
+    return make_ready_continuable();
+  }
+};
+} // namespace
+
+TEST(retry_tests, retries_until_success) {
+  flaky_service service{2};
+  std::vector<std::chrono::nanoseconds> delays;
+
+  retry_policy policy;
+  policy.max_attempts = 5;
+
+  EXPECT_ASYNC_RESULT(retry(policy, recording_timer{&delays},
+                            [&] { return service.request(); }),
+                      3);
+  EXPECT_EQ(service.requests, 3);
+  ASSERT_EQ(delays.size(), 2U);
+}
+
+TEST(retry_tests, delays_are_exponential_and_jittered) {
+  flaky_service service{4};
+  std::vector<std::chrono::nanoseconds> delays;
+
+  retry_policy policy;
+  policy.max_attempts = 5;
+  policy.initial_delay = 10ms;
+  policy.max_delay = 30ms;
+  policy.jitter = 0.5;
+
+  ASSERT_ASYNC_COMPLETION(retry(policy, recording_timer{&delays},
+                                [&] { return service.request(); }));
+
+  ASSERT_EQ(delays.size(), 4U);
+  std::chrono::nanoseconds const expected[] = {10ms, 20ms, 30ms, 30ms};
+  for (std::size_t i = 0; i < delays.size(); ++i) {
+    EXPECT_GE(delays[i], expected[i] / 2);
+    EXPECT_LE(delays[i], expected[i]);
+  }
+}
+
+TEST(retry_tests, gives_up_after_max_attempts) {
+  flaky_service service{10};
+  std::vector<std::chrono::nanoseconds> delays;
+
+  retry_policy policy;
+  policy.max_attempts = 3;
+
+  ASSERT_ASYNC_EXCEPTION_COMPLETION(retry(policy, recording_timer{&delays},
+                                          [&] { return service.request(); }));
+  EXPECT_EQ(service.requests, 3);
+}
+
+TEST(retry_tests, gives_up_after_the_deadline) {
+  flaky_service service{10};
+  std::vector<std::chrono::nanoseconds> delays;
+
+  retry_policy policy;
+  policy.max_attempts = 10;
+  policy.initial_delay = 1s;
+  policy.deadline = 100ms;
+
+  ASSERT_ASYNC_EXCEPTION_COMPLETION(retry(policy, recording_timer{&delays},
+                                          [&] { return service.request(); }));
+  EXPECT_EQ(service.requests, 1);
+  EXPECT_TRUE(delays.empty());
+}
+
+TEST(retry_tests, cancellations_are_not_retried) {
+  int requests = 0;
+  std::vector<std::chrono::nanoseconds> delays;
+
+  ASSERT_ASYNC_CANCELLATION(retry(retry_policy{}, recording_timer{&delays}, [&] {
+    ++requests;
+    return make_cancelling_continuable<int>();
+  }));
+  EXPECT_EQ(requests, 1);
+}
+
+TEST(retry_tests, timer_cancellations_propagate_the_last_error) {
+  flaky_service service{10};
+
+  ASSERT_ASYNC_EXCEPTION_COMPLETION(retry(
+      retry_policy{},
+      [](std::chrono::nanoseconds) { return make_cancelling_continuable<void>(); },
+      [&] { return service.request(); }));
+  EXPECT_EQ(service.requests, 1);
+}
+
+TEST(retry_tests, delays_are_waited_for_on_the_timer_queue) {
+  flaky_service service{2};
+  timer_queue timers;
+
+  retry_policy policy;
+  policy.initial_delay = 1ms;
+
+  std::promise<int> result;
+  retry(policy, std::ref(timers), [&] { return service.request(); })
+      .then([&](int value) { result.set_value(value); });
+
+  EXPECT_EQ(result.get_future().get(), 3);
+}
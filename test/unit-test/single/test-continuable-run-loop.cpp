@@ -0,0 +1,181 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <test-continuable.hpp>
+#include <continuable/operations/run-loop.hpp>
+
+using namespace cti;
+
+TEST(run_loop_tests, poll_runs_the_pending_work) {
+  run_loop loop;
+  ASSERT_EQ(loop.poll(), 0U);
+
+  std::vector<int> order;
+  for (int i = 0; i != 3; ++i) {
+    async_on([&order, i] { order.push_back(i); }, loop.get()).done();
+  }
+  ASSERT_TRUE(order.empty());
+
+  ASSERT_EQ(loop.poll(), 3U);
+  ASSERT_EQ(order, (std::vector<int>{0, 1, 2}));
+  ASSERT_EQ(loop.poll(), 0U);
+}
+
+TEST(run_loop_tests, run_one_runs_a_single_work) {
+  run_loop loop;
+  int called = 0;
+
+  async_on([&] { ++called; }, loop.get()).done();
+  async_on([&] { ++called; }, loop.get()).done();
+
+  ASSERT_EQ(loop.run_one(), 1U);
+  ASSERT_EQ(called, 1);
+  ASSERT_EQ(loop.run_one(), 1U);
+  ASSERT_EQ(called, 2);
+}
+
+TEST(run_loop_tests, run_one_waits_for_work_of_other_threads) {
+  run_loop loop;
+  std::thread::id called;
+
+  std::thread producer([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    async_on([&] { called = std::this_thread::get_id(); }, loop.get())
+        .done();
+  });
+
+  ASSERT_EQ(loop.run_one(), 1U);
+  ASSERT_EQ(called, std::this_thread::get_id());
+  producer.join();
+}
+
+TEST(run_loop_tests, run_for_returns_when_idle) {
+  run_loop loop;
+
+  auto const started = std::chrono::steady_clock::now();
+  ASSERT_EQ(loop.run_for(std::chrono::milliseconds(10)), 0U);
+  ASSERT_GE(std::chrono::steady_clock::now() - started,
+            std::chrono::milliseconds(10));
+}
+
+TEST(run_loop_tests, stop_ends_run) {
+  run_loop loop;
+
+  std::thread stopper([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    loop.stop();
+  });
+
+  ASSERT_EQ(loop.run(), 0U);
+  stopper.join();
+
+  // The stop request was consumed by run
+  async_on([] {}, loop.get()).done();
+  ASSERT_EQ(loop.run_for(std::chrono::milliseconds(1)), 1U);
+}
+
+TEST(run_loop_tests, runs_the_work_of_many_producers_in_order) {
+  std::size_t const producers = 4;
+  std::size_t const count = 5000;
+
+  run_loop loop;
+  std::vector<std::size_t> last(producers, 0U);
+  std::size_t received = 0U;
+  bool ordered = true;
+
+  std::vector<std::thread> threads;
+  for (std::size_t producer = 0; producer != producers; ++producer) {
+    threads.emplace_back([&, producer] {
+      for (std::size_t i = 1; i <= count; ++i) {
+        async_on(
+            [&, producer, i] {
+              ordered = ordered && (last[producer] + 1U == i);
+              last[producer] = i;
+              if (++received == producers * count) {
+                loop.stop();
+              }
+            },
+            loop.get())
+            .done();
+      }
+    });
+  }
+
+  ASSERT_EQ(loop.run(), producers * count);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_TRUE(ordered);
+}
+
+TEST(run_loop_tests, resumes_continuations_on_the_loop) {
+  run_loop loop;
+  std::thread::id resumed;
+
+  std::thread worker;
+  make_continuable<int>([&](auto&& promise) {
+    worker = std::thread([promise = std::forward<decltype(promise)>(
+                              promise)]() mutable { promise.set_value(1); });
+  })
+      .then(
+          [&](int value) {
+            EXPECT_EQ(value, 1);
+            resumed = std::this_thread::get_id();
+          },
+          loop.get())
+      .done();
+
+  ASSERT_EQ(loop.run_one(), 1U);
+  ASSERT_EQ(resumed, std::this_thread::get_id());
+  worker.join();
+}
+
+TEST(run_loop_tests, cancels_pending_work_on_destruction) {
+  result<> pending;
+
+  {
+    run_loop loop;
+    async_on([] {}, loop.get()).next([&](auto&&... args) {
+      pending = make_result(std::forward<decltype(args)>(args)...);
+    });
+  }
+
+  ASSERT_TRUE(pending.is_exception());
+  ASSERT_FALSE(bool(pending.get_exception()));
+}
+
+TEST(run_loop_tests, snapshot_is_empty_without_metrics) {
+  run_loop loop;
+  async_on([] {}, loop.get()).done();
+  loop.poll();
+
+  auto metrics = loop.snapshot();
+  ASSERT_TRUE(metrics.queues.empty());
+  ASSERT_TRUE(metrics.workers.empty());
+}
@@ -0,0 +1,162 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <test-continuable.hpp>
+#include <continuable/operations/scheduler.hpp>
+
+using namespace cti;
+
+namespace {
+/// Records the order in which the work was run by the scheduler
+class recorder {
+public:
+  void record(int value) {
+    std::lock_guard<std::mutex> guard(lock_);
+    order_.push_back(value);
+    condition_.notify_all();
+  }
+
+  std::vector<int> wait_for(std::size_t count) {
+    std::unique_lock<std::mutex> guard(lock_);
+    condition_.wait(guard, [&] { return order_.size() >= count; });
+    return order_;
+  }
+
+private:
+  std::mutex lock_;
+  std::condition_variable condition_;
+  std::vector<int> order_;
+};
+
+/// Blocks the single thread of the scheduler until it is released
+std::promise<void> occupy(deadline_scheduler& scheduler) {
+  std::promise<void> gate;
+  auto released = gate.get_future().share();
+  async_on([released] { released.wait(); }, scheduler.get()).done();
+  return gate;
+}
+} // namespace
+
+TEST(deadline_scheduler_tests, runs_earliest_deadline_first) {
+  deadline_scheduler scheduler(1);
+  recorder order;
+  auto gate = occupy(scheduler);
+
+  auto const now = std::chrono::steady_clock::now();
+  for (int i : {3, 1, 2}) {
+    async_on([&order, i] { order.record(i); },
+             scheduler.get(now + std::chrono::seconds(i)))
+        .done();
+  }
+
+  gate.set_value();
+  ASSERT_EQ(order.wait_for(3), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(deadline_scheduler_tests, runs_higher_classes_first) {
+  deadline_scheduler scheduler(1);
+  recorder order;
+  auto gate = occupy(scheduler);
+
+  async_on([&] { order.record(3); }, scheduler.get(priority::batch)).done();
+  async_on([&] { order.record(2); }, scheduler.get(priority::normal)).done();
+  async_on([&] { order.record(1); }, scheduler.get(priority::interactive))
+      .done();
+
+  gate.set_value();
+  ASSERT_EQ(order.wait_for(3), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(deadline_scheduler_tests, with_priority_is_inherited_by_the_chain) {
+  deadline_scheduler scheduler(1);
+  recorder order;
+  auto gate = occupy(scheduler);
+
+  async_on([&] { order.record(3); }, scheduler.get(priority::normal)).done();
+  make_ready_continuable()
+      .apply(with_priority(priority::interactive))
+      .then([&] { order.record(1); }, scheduler.get())
+      .then([&] { order.record(2); }, scheduler.get())
+      .done();
+
+  gate.set_value();
+  ASSERT_EQ(order.wait_for(3), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(deadline_scheduler_tests, with_deadline_is_inherited_by_the_chain) {
+  deadline_scheduler scheduler(1);
+  recorder order;
+  auto gate = occupy(scheduler);
+
+  auto const now = std::chrono::steady_clock::now();
+  async_on([&] { order.record(3); },
+           scheduler.get(now + std::chrono::seconds(2)))
+      .done();
+  make_ready_continuable()
+      .apply(with_deadline(now + std::chrono::seconds(1)))
+      .then([&] { order.record(1); }, scheduler.get())
+      .then([&] { order.record(2); }, scheduler.get())
+      .done();
+
+  gate.set_value();
+  ASSERT_EQ(order.wait_for(3), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(deadline_scheduler_tests, lower_classes_are_not_starved) {
+  priority_budgets budgets;
+  budgets.interactive = std::chrono::milliseconds(10);
+  budgets.batch = std::chrono::milliseconds(20);
+
+  deadline_scheduler scheduler(1, budgets);
+  recorder order;
+  auto gate = occupy(scheduler);
+
+  async_on([&] { order.record(1); }, scheduler.get(priority::batch)).done();
+
+  // The batch work is due before the interactive work submitted now
+  std::this_thread::sleep_for(std::chrono::milliseconds(15));
+  async_on([&] { order.record(2); }, scheduler.get(priority::interactive))
+      .done();
+
+  gate.set_value();
+  ASSERT_EQ(order.wait_for(2), (std::vector<int>{1, 2}));
+}
+
+TEST(deadline_scheduler_tests, pending_work_is_cancelled_on_destruction) {
+  bool canceled = false;
+  {
+    // Without threads the work is never run
+    deadline_scheduler scheduler(0);
+    async_on([] { FAIL(); }, scheduler.get()).fail([&](exception_t exception) {
+      EXPECT_FALSE(bool(exception));
+      canceled = true;
+    });
+  }
+  ASSERT_TRUE(canceled);
+}
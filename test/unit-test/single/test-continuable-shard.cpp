@@ -0,0 +1,154 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <test-continuable.hpp>
+#include <continuable/operations/shard.hpp>
+
+using namespace cti;
+
+namespace {
+/// Blocks the current thread until the continuable resolved
+template <typename... T, typename Continuable>
+result<T...> wait_for_result(Continuable&& continuable) {
+  std::mutex lock;
+  std::condition_variable condition;
+  bool ready = false;
+  result<T...> captured;
+
+  std::forward<Continuable>(continuable).next([&](auto&&... args) {
+    std::lock_guard<std::mutex> guard(lock);
+    captured = make_result(std::forward<decltype(args)>(args)...);
+    ready = true;
+    condition.notify_one();
+  });
+
+  std::unique_lock<std::mutex> guard(lock);
+  condition.wait(guard, [&] { return ready; });
+  return captured;
+}
+} // namespace
+
+TEST(shard_tests, current_core_outside_of_runtime) {
+  ASSERT_EQ(shard::current_runtime(), nullptr);
+  ASSERT_EQ(shard::current_core(), shard::npos);
+}
+
+TEST(shard_tests, submit_to_runs_on_the_core) {
+  shard::runtime shards(3);
+  ASSERT_EQ(shards.size(), 3U);
+
+  for (std::size_t core = 0; core != shards.size(); ++core) {
+    auto current = wait_for_result<std::size_t>(
+        shards.submit_to(core, [] { return shard::current_core(); }));
+    ASSERT_TRUE(current.is_value());
+    ASSERT_EQ(current.get_value(), core);
+  }
+}
+
+TEST(shard_tests, submit_to_resolves_on_the_calling_core) {
+  shard::runtime shards(2);
+
+  auto cores = wait_for_result<std::size_t, std::size_t>(
+      shards.submit_to(0, [] {
+        return shard::submit_to(1, [] { return shard::current_core(); })
+            .then([](std::size_t remote) {
+              return std::make_tuple(remote, shard::current_core());
+            });
+      }));
+
+  ASSERT_TRUE(cores.is_value());
+  ASSERT_EQ(std::get<0>(cores.get_value()), 1U);
+  ASSERT_EQ(std::get<1>(cores.get_value()), 0U);
+}
+
+TEST(shard_tests, submit_to_forwards_exceptions) {
+  shard::runtime shards(2);
+  std::atomic<std::size_t> failed_on{shard::npos};
+
+  auto handled = wait_for_result<>(shards.submit_to(0, [&] {
+    return shard::submit_to(1,
+                            [] {
+                              return make_result(exception_arg_t{},
+                                                 supply_test_exception());
+                            })
+        .fail([&](exception_t) { failed_on = shard::current_core(); });
+  }));
+
+  ASSERT_TRUE(handled.is_value());
+  ASSERT_EQ(failed_on.load(), 0U);
+}
+
+TEST(shard_tests, executor_of_is_usable_with_then) {
+  shard::runtime shards(2);
+
+  auto current = wait_for_result<std::size_t>(
+      make_ready_continuable().then([] { return shard::current_core(); },
+                                    shards.executor_of(1)));
+  ASSERT_TRUE(current.is_value());
+  ASSERT_EQ(current.get_value(), 1U);
+}
+
+TEST(shard_tests, ping_pong_between_cores) {
+  shard::runtime shards(2);
+  int const rounds = 1000;
+
+  // Only accessed from core 0
+  int round = 0;
+
+  auto counted = wait_for_result<int>(shards.submit_to(0, [&] {
+    return loop([&] {
+      return shard::submit_to(1, [current = round] { return current + 1; })
+          .then([&](int next) -> loop_result<int> {
+            EXPECT_EQ(shard::current_core(), 0U);
+            round = next;
+            if (round == rounds) {
+              return loop_break(round);
+            }
+            return loop_continue();
+          });
+    });
+  }));
+
+  ASSERT_TRUE(counted.is_value());
+  ASSERT_EQ(counted.get_value(), rounds);
+}
+
+TEST(shard_tests, pending_work_is_cancelled_on_destruction) {
+  std::atomic<int> resolved{0};
+  int const submissions = 1000;
+
+  {
+    shard::runtime shards(2);
+    for (int i = 0; i != submissions; ++i) {
+      shards.submit_to(i % 2, [] {}).next([&](auto&&...) { ++resolved; });
+    }
+  }
+
+  ASSERT_EQ(resolved.load(), submissions);
+}
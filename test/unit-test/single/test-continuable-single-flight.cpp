@@ -0,0 +1,149 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <test-continuable.hpp>
+
+using namespace cti;
+
+namespace {
+/// A backend stand-in which records each request and resolves them manually
+struct pending_backend {
+  std::vector<promise<int>> requests;
+
+  auto request() {
+    return make_continuable<int>([this](auto&& promise) {
+      requests.emplace_back(std::forward<decltype(promise)>(promise));
+    });
+  }
+};
+} // namespace
+
+TEST(single_flight_tests, concurrent_requests_are_coalesced) {
+  single_flight<std::string, int> flights;
+  pending_backend backend;
+
+  int first = 0;
+  int second = 0;
+  flights.get("key", [&] { return backend.request(); }).then([&](int value) {
+    first = value;
+  });
+  flights.get("key", [&] { return backend.request(); }).then([&](int value) {
+    second = value;
+  });
+
+  ASSERT_EQ(backend.requests.size(), 1U);
+  ASSERT_EQ(flights.in_flight(), 1U);
+
+  std::move(backend.requests.front()).set_value(36354);
+
+  EXPECT_EQ(first, 36354);
+  EXPECT_EQ(second, 36354);
+  EXPECT_EQ(flights.in_flight(), 0U);
+}
+
+TEST(single_flight_tests, different_keys_are_not_coalesced) {
+  single_flight<int, int> flights;
+  pending_backend backend;
+
+  flights.get(1, [&] { return backend.request(); }).done();
+  flights.get(2, [&] { return backend.request(); }).done();
+
+  ASSERT_EQ(backend.requests.size(), 2U);
+  EXPECT_EQ(flights.in_flight(), 2U);
+
+  for (auto& request : backend.requests) {
+    std::move(request).set_value(0);
+  }
+  EXPECT_EQ(flights.in_flight(), 0U);
+}
+
+TEST(single_flight_tests, entries_are_removed_on_delivery) {
+  single_flight<int, int> flights;
+
+  int calls = 0;
+  auto loader = [&] {
+    ++calls;
+    return make_ready_continuable(calls);
+  };
+
+  EXPECT_ASYNC_RESULT(flights.get(0, loader), 1);
+  EXPECT_ASYNC_RESULT(flights.get(0, loader), 2);
+  EXPECT_EQ(flights.in_flight(), 0U);
+}
+
+TEST(single_flight_tests, exceptions_are_delivered_to_all_waiters) {
+  single_flight<int, int> flights;
+  pending_backend backend;
+
+  int failures = 0;
+  for (int i = 0; i < 3; ++i) {
+    flights.get(0, [&] { return backend.request(); })
+        .then([](int) {
+          FAIL();
+        })
+        .fail([&](exception_t) {
+          ++failures;
+        });
+  }
+
+  ASSERT_EQ(backend.requests.size(), 1U);
+  std::move(backend.requests.front()).set_exception(supply_test_exception());
+
+  EXPECT_EQ(failures, 3);
+  EXPECT_EQ(flights.in_flight(), 0U);
+}
+
+TEST(single_flight_tests, requests_are_lazy) {
+  single_flight<int, int> flights;
+  pending_backend backend;
+
+  auto c = flights.get(0, [&] { return backend.request(); });
+  EXPECT_TRUE(backend.requests.empty());
+  EXPECT_EQ(flights.in_flight(), 0U);
+
+  std::move(c).done();
+  EXPECT_EQ(backend.requests.size(), 1U);
+  std::move(backend.requests.front()).set_value(0);
+}
+
+TEST(single_flight_tests, flights_are_left_once) {
+  using shard_t = detail::operations::flight_shard<int, promise<int>,
+                                                   std::hash<int>,
+                                                   std::equal_to<int>>;
+  shard_t shard;
+
+  std::size_t const first = shard.join(0, promise<int>{});
+  ASSERT_NE(first, 0U);
+  EXPECT_EQ(shard.leave(0, first).size(), 1U);
+
+  // Leaving again neither fails nor steals the waiters of a new flight
+  std::size_t const second = shard.join(0, promise<int>{});
+  EXPECT_NE(second, first);
+  EXPECT_TRUE(shard.leave(0, first).empty());
+  EXPECT_EQ(shard.size(), 1U);
+}
@@ -24,6 +24,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
 #include <set>
@@ -384,6 +385,146 @@ TEST(async_complete_invalidation, check_whether_frame_released) {
   EXPECT_EQ(value.use_count(), 1L);
 }
 
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+
+  std::size_t* allocations;
+
+  explicit counting_allocator(std::size_t* allocations)
+      : allocations(allocations) {
+  }
+  template <typename O>
+  counting_allocator(counting_allocator<O> const& other) noexcept
+      : allocations(other.allocations) {
+  }
+
+  T* allocate(std::size_t n) {
+    ++*allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) noexcept {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  template <typename O>
+  bool operator==(counting_allocator<O> const& other) const noexcept {
+    return allocations == other.allocations;
+  }
+  template <typename O>
+  bool operator!=(counting_allocator<O> const& other) const noexcept {
+    return allocations != other.allocations;
+  }
+};
+
+TEST(async_traverse_allocator, frame_is_allocated_through_allocator) {
+  std::size_t allocations = 0;
+  counting_allocator<char> allocator(&allocations);
+
+  {
+    auto result = traverse_pack_async(
+        std::allocator_arg, allocator, async_increasing_int_visitor<4U>{}, 0U,
+        std::vector<std::size_t>{1U, 2U}, make_tuple(3U));
+    EXPECT_EQ(result->counter(), 5U);
+  }
+
+  {
+    auto result = traverse_pack_async(
+        std::allocator_arg, allocator,
+        async_traverse_in_place_tag<async_unique_visitor<4>>{},
+        not_accepted_tag{}, of(0), of(1), of(2), of(3));
+    EXPECT_EQ(result->counter(), 5U);
+  }
+
+  EXPECT_EQ(allocations, 2U);
+}
+
+template <typename Next>
+struct stored_next_visitor
+    : async_counter_base<stored_next_visitor<Next>> {
+  Next* next;
+
+  explicit stored_next_visitor(Next* next) : next(next) {
+  }
+
+  bool operator()(async_traverse_visit_tag, std::size_t i) const {
+    return i != 1U;
+  }
+
+  template <typename N>
+  void operator()(async_traverse_detach_tag, std::size_t i, N&& resume) {
+    EXPECT_EQ(i, 1U);
+    ++this->counter();
+    *next = std::forward<N>(resume);
+  }
+
+  template <typename T>
+  void operator()(async_traverse_complete_tag, T&& /*pack*/) {
+    ++this->counter();
+  }
+};
+
+// Checks that the resume callable owns the frame when it is stored
+TEST(async_traverse_ownership, resume_callable_keeps_frame_alive) {
+  using visitor_t = stored_next_visitor<std::function<void()>>;
+
+  std::function<void()> next;
+  std::weak_ptr<visitor_t> frame =
+      traverse_pack_async(visitor_t(&next), 0U, 1U, 2U);
+
+  EXPECT_FALSE(frame.expired());
+  EXPECT_EQ(frame.lock()->counter(), 1U);
+
+  next();
+  EXPECT_EQ(frame.lock()->counter(), 2U);
+
+  next = nullptr;
+  EXPECT_TRUE(frame.expired());
+}
+
+template <typename Next>
+struct dropping_next_visitor
+    : async_counter_base<dropping_next_visitor<Next>> {
+  Next* next;
+  std::shared_ptr<int> alive;
+
+  explicit dropping_next_visitor(Next* next, std::shared_ptr<int> alive)
+      : next(next), alive(std::move(alive)) {
+  }
+
+  bool operator()(async_traverse_visit_tag, std::size_t i) const {
+    return i != 1U;
+  }
+
+  template <typename N>
+  void operator()(async_traverse_detach_tag, std::size_t /*i*/, N&& resume) {
+    *next = std::forward<N>(resume);
+  }
+
+  template <typename T>
+  void operator()(async_traverse_complete_tag, T&& /*pack*/) {
+    // Drop the resume callable while it is still being invoked,
+    // the frame has to stay alive until the resumption returned.
+    *next = nullptr;
+    EXPECT_TRUE(alive);
+    ++this->counter();
+  }
+};
+
+// Checks that the resume callable may be dropped while it is resumed
+TEST(async_traverse_ownership, resume_callable_is_dropped_on_completion) {
+  using visitor_t = dropping_next_visitor<std::function<void()>>;
+
+  std::function<void()> next;
+  auto alive = std::make_shared<int>(0);
+  std::weak_ptr<int> frame = alive;
+  traverse_pack_async(visitor_t(&next, std::move(alive)), 0U, 1U, 2U);
+
+  EXPECT_FALSE(frame.expired());
+  next();
+  EXPECT_TRUE(frame.expired());
+}
+
 // #34 when_seq gives error on VS2019
 TEST(regression_tests, msvc_14_2_vs2019_build_fix) {
   ASSERT_ASYNC_COMPLETION(
@@ -0,0 +1,139 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#define CONTINUABLE_WITH_ERASURE_STATISTICS
+#include <continuable/continuable.hpp>
+
+using cti::erasure_kind;
+using cti::erasure_statistics;
+
+namespace {
+struct inline_tag {};
+struct heap_tag {};
+struct work_tag {};
+
+erasure_statistics statistics_of(erasure_kind kind,
+                                 std::string const& signature) {
+  for (auto& erasure : cti::erasure_report()) {
+    if ((erasure.kind == kind) &&
+        (erasure.signature.find(signature) != std::string::npos)) {
+      return erasure;
+    }
+  }
+  return erasure_statistics{signature, kind, 0U, 0U, 0U, 0U, {}, 0U};
+}
+
+/// An executor which queues the work until it is run explicitly
+struct queue_executor {
+  std::vector<cti::work>* queue;
+
+  template <typename Work>
+  void operator()(Work&& work) {
+    queue->emplace_back(std::forward<Work>(work));
+  }
+};
+} // namespace
+
+TEST(erasure_statistics_test, ready_continuables_are_stored_inline) {
+  auto const before = statistics_of(erasure_kind::continuation, "inline_tag");
+
+  cti::continuable<inline_tag> continuable =
+      cti::make_ready_continuable(inline_tag{});
+  (void)continuable;
+
+  auto const after = statistics_of(erasure_kind::continuation, "inline_tag");
+  EXPECT_EQ(after.inline_constructions, before.inline_constructions + 1U);
+  EXPECT_EQ(after.heap_constructions, before.heap_constructions);
+  EXPECT_EQ(after.capacity,
+            cti::detail::erasure::continuation_capacity<inline_tag>::capacity);
+  EXPECT_LE(after.recommended_capacity, after.capacity);
+}
+
+TEST(erasure_statistics_test, large_continuations_spill_to_the_heap) {
+  auto const before = statistics_of(erasure_kind::continuation, "heap_tag");
+
+  std::array<char, 256> payload{};
+  cti::continuable<heap_tag> continuable =
+      cti::make_continuable<heap_tag>([payload](auto&& promise) {
+        (void)payload;
+        promise.set_value(heap_tag{});
+      });
+
+  auto const after = statistics_of(erasure_kind::continuation, "heap_tag");
+  EXPECT_EQ(after.inline_constructions, before.inline_constructions);
+  EXPECT_EQ(after.heap_constructions, before.heap_constructions + 1U);
+  ASSERT_FALSE(after.sizes.empty());
+  EXPECT_GE(after.sizes.back().first, sizeof(payload));
+  EXPECT_GE(after.recommended_capacity, sizeof(payload));
+
+  bool resolved = false;
+  std::move(continuable).then([&](heap_tag) { resolved = true; });
+  EXPECT_TRUE(resolved);
+}
+
+TEST(erasure_statistics_test, callbacks_are_always_allocated) {
+  auto const before = statistics_of(erasure_kind::callback, "heap_tag");
+
+  cti::promise<heap_tag> stored;
+  cti::make_continuable<heap_tag>([&](cti::promise<heap_tag> promise) {
+    stored = std::move(promise);
+  }).then([](heap_tag) {});
+  stored.set_value(heap_tag{});
+
+  auto const after = statistics_of(erasure_kind::callback, "heap_tag");
+  EXPECT_EQ(after.capacity, 0U);
+  EXPECT_EQ(after.inline_constructions, before.inline_constructions);
+  EXPECT_GT(after.heap_constructions, before.heap_constructions);
+}
+
+TEST(erasure_statistics_test, work_is_recorded) {
+  auto const before = statistics_of(erasure_kind::work, "");
+
+  std::vector<cti::work> queue;
+  cti::make_ready_continuable(work_tag{})
+      .then([](work_tag) {}, queue_executor{&queue});
+  ASSERT_EQ(queue.size(), 1U);
+  std::move(queue.front())();
+
+  auto const after = statistics_of(erasure_kind::work, "");
+  EXPECT_EQ(after.capacity, 32U);
+  EXPECT_GT(after.constructions(), before.constructions());
+}
+
+TEST(erasure_statistics_test, recommended_capacity_covers_the_fraction) {
+  std::vector<std::pair<std::size_t, std::uint64_t>> const sizes{{12U, 98U},
+                                                                 {200U, 2U}};
+
+  using cti::detail::spill::recommend_capacity;
+  EXPECT_EQ(recommend_capacity(sizes, 0.98), 16U);
+  EXPECT_EQ(recommend_capacity(sizes, 0.99), 200U);
+  EXPECT_EQ(recommend_capacity(sizes, 1.), 200U);
+  EXPECT_EQ(recommend_capacity({}, 0.99), 0U);
+}
@@ -0,0 +1,260 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <gtest/gtest.h>
+
+#define CONTINUABLE_WITH_EXECUTOR_METRICS
+// Record the queue wait of every work to make the counts predictable
+#define CONTINUABLE_EXECUTOR_METRICS_SAMPLE_INTERVAL 1
+#include <continuable/continuable.hpp>
+#include <continuable/operations/blocking.hpp>
+#include <continuable/operations/run-loop.hpp>
+#include <continuable/operations/scheduler.hpp>
+#include <continuable/operations/shard.hpp>
+
+namespace {
+/// Blocks the current thread until the continuable resolved
+template <typename Continuable>
+void wait_until_resolved(Continuable&& continuable) {
+  std::mutex lock;
+  std::condition_variable condition;
+  bool ready = false;
+
+  std::forward<Continuable>(continuable).next([&](auto&&...) {
+    std::lock_guard<std::mutex> guard(lock);
+    ready = true;
+    condition.notify_one();
+  });
+
+  std::unique_lock<std::mutex> guard(lock);
+  condition.wait(guard, [&] { return ready; });
+}
+
+/// Blocks every thread which waits on it until it is opened
+class gate {
+public:
+  void open() {
+    std::lock_guard<std::mutex> guard(lock_);
+    opened_ = true;
+    condition_.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> guard(lock_);
+    condition_.wait(guard, [&] { return opened_; });
+  }
+
+private:
+  std::mutex lock_;
+  std::condition_variable condition_;
+  bool opened_ = false;
+};
+} // namespace
+
+using namespace std::chrono_literals;
+
+TEST(executor_metrics_tests, queue_recorder_tracks_the_depth) {
+  cti::detail::metrics::queue_recorder recorder;
+  recorder.enqueued();
+  recorder.enqueued();
+  recorder.enqueued();
+
+  auto metrics = recorder.snapshot();
+  EXPECT_EQ(metrics.enqueued, 3U);
+  EXPECT_EQ(metrics.depth, 3U);
+  EXPECT_EQ(metrics.peak_depth, 0U);
+
+  recorder.dequeued();
+  recorder.dequeued();
+  metrics = recorder.snapshot();
+  EXPECT_EQ(metrics.depth, 1U);
+  EXPECT_EQ(metrics.peak_depth, 3U);
+}
+
+TEST(executor_metrics_tests, receiver_recorder_sums_the_senders) {
+  cti::detail::metrics::sender_recorder first;
+  cti::detail::metrics::sender_recorder second;
+  cti::detail::metrics::receiver_recorder recorder;
+  first.enqueued();
+  second.enqueued();
+  second.enqueued();
+
+  recorder.observed(first.count() + second.count());
+  recorder.dequeued();
+  auto metrics = recorder.snapshot(first.count() + second.count());
+  EXPECT_EQ(metrics.enqueued, 3U);
+  EXPECT_EQ(metrics.depth, 2U);
+  EXPECT_EQ(metrics.peak_depth, 3U);
+}
+
+TEST(executor_metrics_tests, run_loop_counts_the_work) {
+  cti::run_loop loop;
+  for (int i = 0; i != 3; ++i) {
+    cti::async_on([] {}, loop.get()).done();
+  }
+
+  auto metrics = loop.snapshot();
+  ASSERT_EQ(metrics.queues.size(), 1U);
+  ASSERT_EQ(metrics.workers.size(), 1U);
+  EXPECT_EQ(metrics.queues[0].depth, 3U);
+
+  std::this_thread::sleep_for(5ms);
+  ASSERT_EQ(loop.poll(), 3U);
+
+  metrics = loop.snapshot();
+  EXPECT_EQ(metrics.queues[0].enqueued, 3U);
+  EXPECT_EQ(metrics.queues[0].depth, 0U);
+  EXPECT_EQ(metrics.queues[0].peak_depth, 3U);
+  EXPECT_EQ(metrics.executed(), 3U);
+  EXPECT_EQ(metrics.queue_wait().count(), 3U);
+  EXPECT_GE(metrics.queue_wait().min(), 4ms);
+}
+
+TEST(executor_metrics_tests, run_loop_counts_the_work_of_all_senders) {
+  cti::run_loop loop;
+  std::thread sender([&] { cti::async_on([] {}, loop.get()).done(); });
+  sender.join();
+
+  // The work is posted by the loop to itself
+  cti::async_on(
+      [&] {
+        cti::async_on([] {}, loop.get()).done();
+        cti::async_on([] {}, loop.get()).done();
+      },
+      loop.get())
+      .done();
+
+  ASSERT_EQ(loop.poll(), 4U);
+
+  auto metrics = loop.snapshot();
+  EXPECT_EQ(metrics.queues[0].enqueued, 4U);
+  EXPECT_EQ(metrics.queues[0].depth, 0U);
+  EXPECT_EQ(metrics.executed(), 4U);
+}
+
+TEST(executor_metrics_tests, run_loop_records_the_idle_time) {
+  cti::run_loop loop;
+  ASSERT_EQ(loop.run_for(20ms), 0U);
+
+  auto metrics = loop.snapshot();
+  EXPECT_GE(metrics.workers[0].idle, 10ms);
+}
+
+TEST(executor_metrics_tests, shard_runtime_counts_per_core) {
+  cti::shard::runtime shards(2);
+  for (int i = 0; i != 10; ++i) {
+    wait_until_resolved(shards.submit_to(1, [] {}));
+  }
+
+  auto metrics = shards.snapshot();
+  ASSERT_EQ(metrics.queues.size(), 2U);
+  ASSERT_EQ(metrics.workers.size(), 2U);
+  EXPECT_EQ(metrics.queues[0].enqueued, 0U);
+  EXPECT_EQ(metrics.queues[1].enqueued, 10U);
+  EXPECT_EQ(metrics.workers[0].executed, 0U);
+  EXPECT_EQ(metrics.workers[1].executed, 10U);
+  EXPECT_EQ(metrics.workers[1].queue_wait.count(), 10U);
+}
+
+TEST(executor_metrics_tests, shard_runtime_counts_work_between_cores) {
+  cti::shard::runtime shards(2);
+  wait_until_resolved(shards.submit_to(0, [] {
+    return cti::shard::submit_to(1, [] {}).then([] {});
+  }));
+
+  auto metrics = shards.snapshot();
+  // The resolution of the inner continuable returns to core 0
+  EXPECT_EQ(metrics.queues[0].enqueued, 2U);
+  EXPECT_EQ(metrics.queues[1].enqueued, 1U);
+  EXPECT_EQ(metrics.executed(), 3U);
+}
+
+TEST(executor_metrics_tests, shard_runtime_tracks_the_peak_depth) {
+  cti::shard::runtime shards(2);
+  gate blocker;
+
+  cti::async_on([&] { blocker.wait(); }, shards.executor_of(1)).done();
+  while (shards.snapshot().workers[1].executed == 0U) {
+    std::this_thread::yield();
+  }
+  for (int i = 0; i != 4; ++i) {
+    cti::async_on([] {}, shards.executor_of(1)).done();
+  }
+  EXPECT_EQ(shards.snapshot().queues[1].depth, 4U);
+
+  blocker.open();
+  while (shards.snapshot().executed() != 5U) {
+    std::this_thread::yield();
+  }
+
+  auto metrics = shards.snapshot();
+  EXPECT_EQ(metrics.queues[1].enqueued, 5U);
+  EXPECT_EQ(metrics.queues[1].depth, 0U);
+  EXPECT_EQ(metrics.queues[1].peak_depth, 4U);
+}
+
+TEST(executor_metrics_tests, deadline_scheduler_tracks_the_peak_depth) {
+  cti::deadline_scheduler scheduler(1);
+  gate blocker;
+
+  cti::async_on([&] { blocker.wait(); }, scheduler.get()).done();
+  while (scheduler.snapshot().workers[0].executed == 0U) {
+    std::this_thread::yield();
+  }
+  for (int i = 0; i != 4; ++i) {
+    cti::async_on([] {}, scheduler.get()).done();
+  }
+  EXPECT_EQ(scheduler.snapshot().queues[0].depth, 4U);
+
+  std::this_thread::sleep_for(10ms);
+  blocker.open();
+  while (scheduler.snapshot().executed() != 5U) {
+    std::this_thread::yield();
+  }
+
+  auto metrics = scheduler.snapshot();
+  ASSERT_EQ(metrics.workers.size(), 1U);
+  EXPECT_EQ(metrics.queues[0].depth, 0U);
+  EXPECT_EQ(metrics.queues[0].peak_depth, 4U);
+  EXPECT_GE(metrics.queue_wait().max(), 9ms);
+}
+
+TEST(executor_metrics_tests, blocking_pool_merges_its_threads) {
+  cti::blocking_pool pool(4);
+  for (int i = 0; i != 5; ++i) {
+    wait_until_resolved(pool.run([] {}));
+  }
+
+  auto metrics = pool.snapshot();
+  ASSERT_EQ(metrics.queues.size(), 1U);
+  ASSERT_EQ(metrics.workers.size(), 1U);
+  EXPECT_EQ(metrics.queues[0].enqueued, 5U);
+  EXPECT_EQ(metrics.executed(), 5U);
+  EXPECT_EQ(metrics.queue_wait().count(), 5U);
+}
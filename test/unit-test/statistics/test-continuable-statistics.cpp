@@ -0,0 +1,238 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#define CONTINUABLE_WITH_STAGE_STATISTICS
+#include <continuable/continuable.hpp>
+
+namespace {
+cti::stage_statistics statistics_of(std::string const& label) {
+  for (auto& stage : cti::statistics_snapshot()) {
+    if (stage.label == label) {
+      return stage;
+    }
+  }
+  cti::stage_statistics empty;
+  empty.label = label;
+  return empty;
+}
+
+/// An executor which queues the work until it is run explicitly
+struct queue_executor {
+  std::vector<cti::work>* queue;
+
+  template <typename Work>
+  void operator()(Work&& work) {
+    queue->emplace_back(std::forward<Work>(work));
+  }
+};
+
+void run_all(std::vector<cti::work>& queue) {
+  while (!queue.empty()) {
+    std::vector<cti::work> current;
+    current.swap(queue);
+    for (auto& work : current) {
+      std::move(work)();
+    }
+  }
+}
+} // namespace
+
+using namespace std::chrono_literals;
+
+TEST(statistics_tests, histogram_buckets_contain_their_values) {
+  using namespace cti::detail::statistics;
+
+  for (std::uint64_t value = 0; value < 100000; value += 7) {
+    std::size_t const bucket = bucket_of(value);
+    ASSERT_LT(bucket, bucket_count);
+    EXPECT_LE(lowest_value_of(bucket), value);
+    EXPECT_GE(highest_value_of(bucket), value);
+  }
+
+  EXPECT_EQ(bucket_of(highest_trackable_value), bucket_count - 1);
+  EXPECT_EQ(bucket_of(highest_trackable_value * 2), bucket_count - 1);
+}
+
+TEST(statistics_tests, histogram_percentiles_are_precise) {
+  cti::latency_histogram histogram;
+  EXPECT_EQ(histogram.count(), 0U);
+  EXPECT_EQ(histogram.percentile(50.), 0ns);
+
+  for (std::int64_t i = 1; i <= 1000; ++i) {
+    histogram.record(std::chrono::nanoseconds(i * 1000));
+  }
+
+  ASSERT_EQ(histogram.count(), 1000U);
+  EXPECT_EQ(histogram.mean(), 500500ns);
+  EXPECT_LE(histogram.min(), 1000ns);
+  EXPECT_GE(histogram.max(), 1000000ns);
+
+  auto const median = histogram.percentile(50.);
+  EXPECT_GE(median, 500000ns);
+  EXPECT_LE(median, 500000ns * 104 / 100);
+
+  auto const p99 = histogram.percentile(99.);
+  EXPECT_GE(p99, 990000ns);
+  EXPECT_LE(p99, 990000ns * 104 / 100);
+}
+
+TEST(statistics_tests, histogram_merge_adds_counts) {
+  cti::latency_histogram left;
+  cti::latency_histogram right;
+  left.record(10ns);
+  right.record(20ns);
+  right.record(30ns);
+
+  left.merge(right);
+  EXPECT_EQ(left.count(), 3U);
+  EXPECT_EQ(left.mean(), 20ns);
+  EXPECT_EQ(left.min(), 10ns);
+  EXPECT_EQ(left.max(), 30ns);
+}
+
+TEST(statistics_tests, labeled_inline_stage_records_run_time) {
+  bool invoked = false;
+  cti::make_ready_continuable(1)
+      .then([&](int value) {
+        std::this_thread::sleep_for(1ms);
+        invoked = true;
+        return value + 1;
+      })
+      .apply(cti::label("inline-stage"));
+
+  ASSERT_TRUE(invoked);
+
+  auto const stage = statistics_of("inline-stage");
+  EXPECT_EQ(stage.run.count(), 1U);
+  EXPECT_GE(stage.run.max(), 1ms);
+  // Inline stages are never queued
+  EXPECT_EQ(stage.queue_wait.count(), 0U);
+}
+
+TEST(statistics_tests, labeled_executor_stage_records_queue_wait) {
+  std::vector<cti::work> queue;
+  bool invoked = false;
+
+  cti::make_ready_continuable()
+      .then([&] { invoked = true; }, queue_executor{&queue})
+      .apply(cti::label("queued-stage"));
+
+  ASSERT_FALSE(invoked);
+  std::this_thread::sleep_for(2ms);
+  run_all(queue);
+  ASSERT_TRUE(invoked);
+
+  auto const stage = statistics_of("queued-stage");
+  EXPECT_EQ(stage.run.count(), 1U);
+  ASSERT_EQ(stage.queue_wait.count(), 1U);
+  EXPECT_GE(stage.queue_wait.max(), 2ms);
+}
+
+TEST(statistics_tests, consecutive_stages_share_their_boundary) {
+  cti::make_ready_continuable()
+      .then([] { std::this_thread::sleep_for(2ms); })
+      .apply(cti::label("slow-stage"))
+      .then([] {})
+      .apply(cti::label("fast-stage"));
+
+  EXPECT_GE(statistics_of("slow-stage").run.max(), 2ms);
+  EXPECT_LT(statistics_of("fast-stage").run.max(), 1ms);
+}
+
+TEST(statistics_tests, stages_resolved_later_measure_their_own_start) {
+  cti::promise<> resolve;
+  cti::make_continuable<void>([&](auto&& promise) {
+    resolve = std::forward<decltype(promise)>(promise);
+  })
+      .then([] {})
+      .apply(cti::label("late-stage"));
+
+  cti::make_ready_continuable().then([] {}).apply(cti::label("early-stage"));
+  std::this_thread::sleep_for(2ms);
+  resolve.set_value();
+
+  ASSERT_EQ(statistics_of("late-stage").run.count(), 1U);
+  EXPECT_LT(statistics_of("late-stage").run.max(), 1ms);
+}
+
+TEST(statistics_tests, label_applies_to_the_previous_stage_only) {
+  cti::make_ready_continuable()
+      .then([] {})
+      .apply(cti::label("first-stage"))
+      .then([] {})
+      .fail([](cti::exception_t) {})
+      .apply(cti::label("failure-stage"));
+
+  EXPECT_EQ(statistics_of("first-stage").run.count(), 1U);
+  // The failure handler is never invoked and thus isn't recorded
+  EXPECT_EQ(statistics_of("failure-stage").run.count(), 0U);
+}
+
+TEST(statistics_tests, labels_of_non_stages_are_ignored) {
+  cti::continuable<int> erased = cti::make_ready_continuable(0).then(
+      [](int value) { return value; });
+
+  std::move(erased).apply(cti::label("erased-stage")).then([](int) {});
+  cti::make_ready_continuable().apply(cti::label("ready-stage"));
+
+  EXPECT_EQ(statistics_of("erased-stage").run.count(), 0U);
+  EXPECT_EQ(statistics_of("ready-stage").run.count(), 0U);
+}
+
+TEST(statistics_tests, timed_callbacks_keep_the_noexcept_specification) {
+  auto nothrow = cti::detail::statistics::time_callback([]() noexcept {});
+  auto throwing = cti::detail::statistics::time_callback([] {});
+
+  EXPECT_TRUE(noexcept(std::move(nothrow)()));
+  EXPECT_FALSE(noexcept(std::move(throwing)()));
+}
+
+TEST(statistics_tests, snapshot_merges_the_histograms_of_all_threads) {
+  constexpr std::size_t thread_count = 4;
+  constexpr std::size_t stages = 100;
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([] {
+      for (std::size_t j = 0; j < stages; ++j) {
+        cti::make_ready_continuable()
+            .then([] {})
+            .apply(cti::label("threaded-stage"));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(statistics_of("threaded-stage").run.count(),
+            thread_count * stages);
+}
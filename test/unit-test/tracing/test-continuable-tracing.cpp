@@ -0,0 +1,174 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <gtest/gtest.h>
+#include <continuable/continuable-trace-exporter.hpp>
+
+namespace {
+std::mutex events_lock;
+std::vector<cti::trace_event> events;
+cti::chrome_trace_exporter exporter;
+} // namespace
+
+struct test_trace_hooks {
+  static void trace(cti::trace_event const& event) noexcept {
+    exporter.record(event);
+
+    std::lock_guard<std::mutex> guard(events_lock);
+    events.push_back(event);
+  }
+};
+
+#define CONTINUABLE_WITH_TRACE_HOOKS test_trace_hooks
+#include <continuable/continuable.hpp>
+#include <continuable/external/gtest.hpp>
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+#include <exception>
+#include <stdexcept>
+#else
+#include <system_error>
+#endif
+
+namespace {
+std::vector<cti::trace_event> take_events() {
+  std::lock_guard<std::mutex> guard(events_lock);
+  std::vector<cti::trace_event> taken;
+  taken.swap(events);
+  return taken;
+}
+
+std::size_t count_of(std::vector<cti::trace_event> const& recorded,
+                     cti::trace_kind kind) {
+  return static_cast<std::size_t>(
+      std::count_if(recorded.begin(), recorded.end(),
+                    [&](cti::trace_event const& e) { return e.kind == kind; }));
+}
+
+cti::exception_t make_error() {
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+  return std::make_exception_ptr(std::runtime_error("error"));
+#else
+  return std::make_error_condition(std::errc::io_error);
+#endif
+}
+
+class tracing_tests : public ::testing::Test {
+protected:
+  void SetUp() override {
+    take_events();
+  }
+};
+} // namespace
+
+TEST_F(tracing_tests, chains_share_their_id) {
+  int value = 0;
+  cti::make_continuable<int>([](auto&& promise) { promise.set_value(1); })
+      .then([](int i) { return i + 1; })
+      .then([&](int i) { value = i; });
+
+  EXPECT_EQ(value, 2);
+
+  auto const recorded = take_events();
+  ASSERT_FALSE(recorded.empty());
+  EXPECT_EQ(count_of(recorded, cti::trace_kind::create), 3U);
+  EXPECT_EQ(count_of(recorded, cti::trace_kind::dispatch), 1U);
+  EXPECT_EQ(count_of(recorded, cti::trace_kind::resolve), 3U);
+
+  std::uint64_t const chain = recorded.front().chain;
+  EXPECT_NE(chain, 0U);
+  for (auto const& event : recorded) {
+    EXPECT_EQ(event.chain, chain);
+  }
+
+  EXPECT_TRUE(std::is_sorted(recorded.begin(), recorded.end(),
+                             [](auto const& left, auto const& right) {
+                               return left.timestamp < right.timestamp;
+                             }));
+}
+
+TEST_F(tracing_tests, different_chains_have_different_ids) {
+  cti::make_continuable<void>([](auto&& promise) { promise.set_value(); })
+      .done();
+  cti::make_continuable<void>([](auto&& promise) { promise.set_value(); })
+      .done();
+
+  auto const recorded = take_events();
+  ASSERT_EQ(count_of(recorded, cti::trace_kind::dispatch), 2U);
+  EXPECT_NE(recorded.front().chain, recorded.back().chain);
+}
+
+TEST_F(tracing_tests, executor_submissions_are_traced) {
+  auto executor = [](auto&& work) {
+    std::forward<decltype(work)>(work)();
+  };
+
+  cti::make_ready_continuable().then([] {}, executor).done();
+
+  auto const recorded = take_events();
+  EXPECT_EQ(count_of(recorded, cti::trace_kind::submit), 1U);
+}
+
+TEST_F(tracing_tests, failures_and_cancellations_are_traced) {
+  cti::make_continuable<void>(
+      [](auto&& promise) { promise.set_exception(make_error()); })
+      .fail([](cti::exception_t) {});
+
+  cti::make_continuable<void>([](auto&& promise) { promise.set_canceled(); })
+      .done();
+
+  auto const recorded = take_events();
+  EXPECT_EQ(count_of(recorded, cti::trace_kind::fail), 1U);
+  EXPECT_EQ(count_of(recorded, cti::trace_kind::cancel), 1U);
+}
+
+TEST_F(tracing_tests, erasure_keeps_the_chain) {
+  cti::continuable<int> erased =
+      cti::make_continuable<int>([](auto&& promise) { promise.set_value(0); });
+  std::move(erased).then([](int) {});
+
+  auto const recorded = take_events();
+  ASSERT_FALSE(recorded.empty());
+  for (auto const& event : recorded) {
+    EXPECT_EQ(event.chain, recorded.front().chain);
+  }
+}
+
+TEST_F(tracing_tests, chrome_trace_export) {
+  exporter.clear();
+  cti::make_ready_continuable(0).then([](int) {});
+
+  std::ostringstream out;
+  exporter.write(out);
+
+  std::string const json = out.str();
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"create\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"dispatch\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"i\""), std::string::npos);
+}
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Compares the JSON output of continuable-benchmarks against a baseline.
+
+Usage:
+  continuable-benchmarks --benchmark_out=results.json \\
+                         --benchmark_out_format=json
+  compare-benchmarks.py --baseline test/benchmark/baseline.json results.json
+
+A benchmark is flagged as regressed when its time or the count of
+allocations per iteration grows by more than the given threshold.
+The exit code is non-zero if at least one benchmark regressed.
+
+Use --update to replace the baseline with the given results, which
+should be done on the machine the baseline is compared on.
+"""
+
+import argparse
+import json
+import sys
+
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_results(path):
+    """Returns a dict of benchmark name to its time and allocations"""
+    with open(path) as file:
+        document = json.load(file)
+
+    results = {}
+    for entry in document.get("benchmarks", []):
+        # Skip aggregates of repeated runs except for the median
+        if entry.get("run_type") == "aggregate" and \
+                entry.get("aggregate_name") != "median":
+            continue
+
+        name = entry.get("run_name", entry["name"])
+        scale = UNITS[entry.get("time_unit", "ns")]
+        results[name] = {
+            "cpu_time": entry["cpu_time"] * scale,
+            "allocs": entry.get("allocs", 0.0),
+            "bytes": entry.get("bytes", 0.0),
+        }
+    return results
+
+
+def write_baseline(path, results):
+    benchmarks = [{"name": name,
+                   "time_unit": "ns",
+                   "cpu_time": round(values["cpu_time"], 1),
+                   "allocs": round(values["allocs"], 2),
+                   "bytes": round(values["bytes"], 1)}
+                  for name, values in sorted(results.items())]
+    with open(path, "w") as file:
+        json.dump({"benchmarks": benchmarks}, file, indent=2, sort_keys=True)
+        file.write("\n")
+
+
+def relative_change(before, after):
+    if before == 0.0:
+        return 0.0 if after == 0.0 else float("inf")
+    return (after - before) / before
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Flags regressions of continuable-benchmarks results.")
+    parser.add_argument("results", help="the JSON output of the benchmarks")
+    parser.add_argument("--baseline", required=True,
+                        help="the baseline to compare against")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="the tolerated relative time increase "
+                             "(default: 0.10)")
+    parser.add_argument("--update", action="store_true",
+                        help="replaces the baseline with the results")
+    arguments = parser.parse_args()
+
+    current = load_results(arguments.results)
+    if arguments.update:
+        write_baseline(arguments.baseline, current)
+        print("Updated {} with {} benchmarks".format(arguments.baseline,
+                                                      len(current)))
+        return 0
+
+    baseline = load_results(arguments.baseline)
+
+    regressions = 0
+    print("{:<48} {:>12} {:>12} {:>9} {:>14}".format(
+        "Benchmark", "Baseline", "Current", "Time", "Allocs"))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            print("{:<48} missing in the results".format(name))
+            continue
+        if name not in baseline:
+            print("{:<48} new".format(name))
+            continue
+
+        before = baseline[name]
+        after = current[name]
+        time_change = relative_change(before["cpu_time"], after["cpu_time"])
+        allocs_change = after["allocs"] - before["allocs"]
+
+        regressed = time_change > arguments.threshold or allocs_change > 0.5
+        regressions += regressed
+
+        print("{:<48} {:>10.1f}ns {:>10.1f}ns {:>+8.1%} {:>+14.2f}{}".format(
+            name, before["cpu_time"], after["cpu_time"], time_change,
+            allocs_change, "  REGRESSION" if regressed else ""))
+
+    if regressions:
+        print("\n{} benchmark(s) regressed".format(regressions))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())